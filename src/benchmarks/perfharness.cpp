@@ -0,0 +1,403 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QBuffer>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QFontDatabase>
+#include <QGuiApplication>
+#include <QImage>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QVector>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+
+#include "benchmarks/scoregenerator.h"
+#include "core/archive.h"
+#include "core/converter.h"
+#include "export/canorusmlexport.h"
+#include "layout/layoutengine.h"
+#include "layout/layoutscene.h"
+#include "score/document.h"
+#include "score/sheet.h"
+
+/*!
+	\class CAPerfHarness
+	\brief End-to-end performance regression harness
+
+	Opens, lays out, paints and saves the given scores and compares the timings with the
+	stored baseline. The stages are:
+	  - import: CanorusML import of the file, the same as opening the document
+	  - layout: CALayoutEngine::reposit() of all the sheets
+	  - paint: painting of all the drawable elements into a QImage
+	  - export: CACanorusMLExport of the document
+	  - archive: writing the exported document into a CAArchive, the same as saving the .can file
+
+	The harness runs on the offscreen Qt platform plugin, so it doesn't need a display.
+	The layout and the paint use CALayoutScene, the layout target without the user interface,
+	which draws the same drawable elements as CAScoreView. The paint device is limited to
+	MAX_IMAGE_SIZE pixels, elements outside of it are clipped by QPainter.
+
+	Besides the sample files, the harness generates large scores using CAScoreGenerator and
+	saves them to a temporary directory first. The build target perf-check runs the harness
+	on the samples in src/tests and fails, if any stage is slower than the baseline by more
+	than the tolerance:
+
+	\code
+	  cmake -DCMAKE_BUILD_TYPE=Release -DCANORUS_BENCHMARKS=True ..
+	  make perf-check
+	\endcode
+
+	The timings depend on the machine, so no baseline is committed. src/tests/perf-baseline.json
+	or the file given by CANORUS_PERF_BASELINE is created by --update-baseline ("make
+	perf-baseline") on the machine running the checks, which also accepts the new timings
+	after an intended change. While the baseline file doesn't exist, the timings are only
+	printed and the comparison is reported as SKIPPED, so a regression is never accepted
+	silently as the first baseline. An invalid baseline file fails the harness.
+	Stages shorter than --noise milliseconds in the baseline are not compared, because their
+	timings vary too much.
+*/
+class CAPerfHarness {
+public:
+    CAPerfHarness();
+
+    inline void setRepeat(int repeat) { _repeat = repeat; }
+
+    bool runFile(const QString& fileName);
+    bool runGenerated(int bars, int voices);
+
+    inline const QJsonObject& results() { return _results; }
+    int compare(const QJsonObject& baseline, double tolerance, double noise);
+
+    static const int MAX_IMAGE_SIZE;
+
+private:
+    bool runDocument(const QString& name, const QString& fileName);
+    double measure(std::function<double()> iteration);
+
+    int _repeat; // every stage is repeated and the median time is taken
+    QTemporaryDir _tempDir;
+    QJsonObject _results; // score name -> stage -> milliseconds
+};
+
+const int CAPerfHarness::MAX_IMAGE_SIZE = 4096;
+
+CAPerfHarness::CAPerfHarness()
+    : _repeat(3)
+{
+}
+
+/*!
+	Repeats the \a iteration and returns the median of its times in milliseconds.
+	\a iteration returns the time of its measured part, so the setup is excluded.
+*/
+double CAPerfHarness::measure(std::function<double()> iteration)
+{
+    QVector<double> times;
+    for (int i = 0; i < qMax(_repeat, 1); i++) {
+        times << iteration();
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+/*!
+	Runs all the stages on the CanorusML file \a fileName.
+	Returns False, if the file couldn't be opened.
+*/
+bool CAPerfHarness::runFile(const QString& fileName)
+{
+    return runDocument(QFileInfo(fileName).fileName(), fileName);
+}
+
+/*!
+	Generates a score of \a bars bars and \a voices voices, saves it and runs all the stages
+	on it.
+*/
+bool CAPerfHarness::runGenerated(int bars, int voices)
+{
+    QString name = QString("generated-%1x%2").arg(bars).arg(voices);
+    QString fileName = _tempDir.path() + "/" + name + ".xml";
+
+    std::unique_ptr<CADocument> document(CAScoreGenerator::generateDocument(bars, voices));
+    {
+        CACanorusMLExport exp;
+        exp.setStreamToFile(fileName);
+        exp.exportDocument(document.get(), false);
+        if (exp.status() != 0) {
+            std::cerr << qPrintable(fileName) << ": " << qPrintable(exp.readableStatus()) << std::endl;
+            return false;
+        }
+    }
+
+    return runDocument(name, fileName);
+}
+
+/*!
+	Runs all the stages on the CanorusML file \a fileName and stores the timings under the
+	given score \a name.
+*/
+bool CAPerfHarness::runDocument(const QString& name, const QString& fileName)
+{
+    QElapsedTimer timer;
+    QJsonObject stages;
+    std::unique_ptr<CADocument> document;
+    QString errorString;
+
+    stages["import"] = measure([&]() {
+        CAConverter converter;
+        document.reset();
+        timer.start();
+        document.reset(converter.importDocument(fileName));
+        double time = timer.nsecsElapsed() / 1e6;
+        errorString = converter.errorString();
+        return time;
+    });
+    if (!document) {
+        std::cerr << qPrintable(fileName) << ": " << qPrintable(errorString) << std::endl;
+        return false;
+    }
+
+    QList<CALayoutScene*> scenes;
+    for (CASheet* sheet : document->sheetList()) {
+        scenes << new CALayoutScene(sheet);
+    }
+
+    stages["layout"] = measure([&]() {
+        double time = 0;
+        for (CALayoutScene* scene : scenes) {
+            scene->clear();
+            timer.start();
+            CALayoutEngine::reposit(scene);
+            time += timer.nsecsElapsed() / 1e6;
+        }
+        return time;
+    });
+
+    stages["paint"] = measure([&]() {
+        double time = 0;
+        for (CALayoutScene* scene : scenes) {
+            QSize size = scene->size().toSize().boundedTo(QSize(MAX_IMAGE_SIZE, MAX_IMAGE_SIZE)).expandedTo(QSize(1, 1));
+            QImage image(size, QImage::Format_ARGB32_Premultiplied);
+            image.fill(Qt::white);
+            QPainter p(&image);
+            timer.start();
+            scene->paint(&p);
+            time += timer.nsecsElapsed() / 1e6;
+        }
+        return time;
+    });
+    qDeleteAll(scenes);
+
+    QByteArray content;
+    stages["export"] = measure([&]() {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        double time;
+        {
+            CACanorusMLExport exp;
+            exp.setStreamToDevice(&buffer);
+            timer.start();
+            exp.exportDocument(document.get(), false);
+            time = timer.nsecsElapsed() / 1e6;
+        }
+        content = buffer.data();
+        return time;
+    });
+
+    stages["archive"] = measure([&]() {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        CAArchive archive;
+        timer.start();
+        archive.addFile("content.xml", content);
+        archive.write(buffer);
+        return timer.nsecsElapsed() / 1e6;
+    });
+
+    _results[name] = stages;
+    return true;
+}
+
+/*!
+	Compares the results with the \a baseline and prints them.
+	Returns the number of stages slower than the baseline by more than \a tolerance percent.
+	Stages shorter than \a noise milliseconds in the baseline are only printed.
+*/
+int CAPerfHarness::compare(const QJsonObject& baseline, double tolerance, double noise)
+{
+    int regressions = 0;
+    for (const QString& score : _results.keys()) {
+        QJsonObject stages = _results[score].toObject();
+        QJsonObject baseStages = baseline[score].toObject();
+        for (const QString& stage : stages.keys()) {
+            double time = stages[stage].toDouble();
+            std::cerr << qPrintable(score) << " " << qPrintable(stage) << ": " << time << " ms";
+            if (!baseStages.contains(stage)) {
+                std::cerr << " (no baseline)" << std::endl;
+                continue;
+            }
+
+            double base = baseStages[stage].toDouble();
+            double change = base > 0 ? (time - base) * 100 / base : 0;
+            std::cerr << ", baseline " << base << " ms, " << (change >= 0 ? "+" : "") << change << "%";
+            if (base >= noise && change > tolerance) {
+                std::cerr << " SLOWER";
+                regressions++;
+            }
+            std::cerr << std::endl;
+        }
+    }
+
+    return regressions;
+}
+
+/*!
+	Reads the JSON document from the file \a fileName into \a o.
+	Returns False, if the file doesn't exist or can't be parsed.
+*/
+static bool readJson(const QString& fileName, QJsonObject& o)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    o = QJsonDocument::fromJson(file.readAll()).object();
+    return !o.isEmpty();
+}
+
+/*!
+	Writes the JSON object \a o to the file \a fileName.
+*/
+static bool writeJson(const QString& fileName, const QJsonObject& o)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::cerr << qPrintable(fileName) << ": " << qPrintable(file.errorString()) << std::endl;
+        return false;
+    }
+    file.write(QJsonDocument(o).toJson());
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication app(argc, argv);
+    QStringList args = app.arguments();
+
+    CAPerfHarness harness;
+    QStringList files;
+    QStringList generated = { "1000x4", "10000x8" };
+    QString baselineFileName, outputFileName;
+    bool updateBaseline = false;
+    double tolerance = 10;
+    double noise = 5;
+    bool valid = true;
+    for (int i = 1; i < args.size() && valid; i++) {
+        if (args[i] == "--generate" && i + 1 < args.size()) {
+            generated = args[++i].split(',', QString::SkipEmptyParts);
+        } else if (args[i] == "--repeat" && i + 1 < args.size()) {
+            harness.setRepeat(args[++i].toInt(&valid));
+        } else if (args[i] == "--baseline" && i + 1 < args.size()) {
+            baselineFileName = args[++i];
+        } else if (args[i] == "--update-baseline") {
+            updateBaseline = true;
+        } else if (args[i] == "--tolerance" && i + 1 < args.size()) {
+            tolerance = args[++i].toDouble(&valid);
+        } else if (args[i] == "--noise" && i + 1 < args.size()) {
+            noise = args[++i].toDouble(&valid);
+        } else if (args[i] == "--fonts" && i + 1 < args.size()) {
+            QDir fonts(args[++i]);
+            for (const QString& font : fonts.entryList(QStringList() << "*.ttf", QDir::Files)) {
+                QFontDatabase::addApplicationFont(fonts.filePath(font));
+            }
+        } else if (args[i] == "--output" && i + 1 < args.size()) {
+            outputFileName = args[++i];
+        } else if (args[i].startsWith('-')) {
+            valid = false;
+        } else if (QFileInfo(args[i]).isDir()) {
+            QDir dir(args[i]);
+            for (const QString& file : dir.entryList(QStringList() << "*.xml", QDir::Files, QDir::Name)) {
+                files << dir.filePath(file);
+            }
+        } else {
+            files << args[i];
+        }
+    }
+
+    if (!valid) {
+        std::cerr << "Usage: canorus-perf [<options>] [<file or directory>...]" << std::endl
+                  << "Options:" << std::endl
+                  << "  --generate <bars>x<voices>,...  generated scores, default 1000x4,10000x8" << std::endl
+                  << "  --repeat <n>          number of runs of each stage, the median is taken, default 3" << std::endl
+                  << "  --baseline <file>     compare with the baseline, skipped if it doesn't exist" << std::endl
+                  << "  --update-baseline     store the results as the new baseline" << std::endl
+                  << "  --tolerance <%>       allowed slowdown against the baseline, default 10" << std::endl
+                  << "  --noise <ms>          don't compare the stages faster than this in the baseline, default 5" << std::endl
+                  << "  --fonts <directory>   register the fonts in the directory, eg. src/fonts" << std::endl
+                  << "  --output <file>       write the results as JSON to the file" << std::endl;
+        return 2;
+    }
+
+    int failed = 0;
+    for (const QString& file : files) {
+        failed += !harness.runFile(file);
+    }
+    for (const QString& size : generated) {
+        QStringList s = size.split('x');
+        if (s.size() != 2 || s[0].toInt() <= 0 || s[1].toInt() <= 0) {
+            std::cerr << "Invalid size of the generated score: " << qPrintable(size) << std::endl;
+            return 2;
+        }
+        failed += !harness.runGenerated(s[0].toInt(), s[1].toInt());
+    }
+
+    QJsonObject results;
+    results["version"] = QString(CANORUS_VERSION);
+    results["results"] = harness.results();
+    if (!outputFileName.isEmpty() && !writeJson(outputFileName, results)) {
+        return 1;
+    }
+
+    QJsonObject baseline;
+    int regressions = 0;
+    if (baselineFileName.isEmpty()) {
+        harness.compare(QJsonObject(), tolerance, noise);
+    } else if (updateBaseline) {
+        harness.compare(QJsonObject(), tolerance, noise);
+        if (!writeJson(baselineFileName, results)) {
+            return 1;
+        }
+        std::cerr << "Baseline stored to " << qPrintable(baselineFileName) << std::endl;
+    } else if (!QFileInfo::exists(baselineFileName)) {
+        harness.compare(QJsonObject(), tolerance, noise);
+        std::cout << "SKIPPED: " << qPrintable(baselineFileName) << " doesn't exist, run with --update-baseline to create it" << std::endl;
+    } else if (!readJson(baselineFileName, baseline)) {
+        harness.compare(QJsonObject(), tolerance, noise);
+        std::cerr << qPrintable(baselineFileName) << ": the baseline is invalid, run with --update-baseline" << std::endl;
+        return 1;
+    } else {
+        regressions = harness.compare(baseline["results"].toObject(), tolerance, noise);
+        if (regressions) {
+            std::cerr << regressions << " stage(s) slower than the baseline by more than " << tolerance << "%" << std::endl;
+        }
+    }
+
+    return (failed || regressions) ? 1 : 0;
+}
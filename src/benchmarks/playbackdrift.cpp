@@ -0,0 +1,247 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "benchmarks/scoregenerator.h"
+#include "interface/mididevice.h"
+#include "interface/playback.h"
+#include "interface/playbacktimeline.h"
+#include "score/document.h"
+#include "score/sheet.h"
+
+/*!
+	\class CADriftMidiDevice
+	\brief Real-time midi device which records the time of the sent messages
+
+	Fake output for CAPlaybackDrift. The times are stored into the preallocated buffer,
+	so the measurement doesn't delay the playback thread.
+*/
+class CADriftMidiDevice : public CAMidiDevice {
+public:
+    CADriftMidiDevice(int capacity)
+    {
+        setRealTime(true);
+        setMidiDeviceType(RtMidiDevice);
+        _messages.reserve(capacity);
+    }
+
+    struct CASentMessage {
+        std::chrono::steady_clock::time_point sent;
+        int time;
+    };
+
+    QMap<int, QString> getOutputPorts() { return QMap<int, QString>(); }
+    QMap<int, QString> getInputPorts() { return QMap<int, QString>(); }
+    bool openOutputPort(int) { return true; }
+    bool openInputPort(int) { return false; }
+    void closeOutputPort() {}
+    void closeInputPort() {}
+    void send(QVector<unsigned char> message, int time) { send(message.constData(), message.size(), time); }
+    void send(const unsigned char*, int, int time)
+    {
+        if (_messages.size() < _messages.capacity()) {
+            _messages.push_back({ std::chrono::steady_clock::now(), time });
+        }
+    }
+    void sendMetaEvent(int, char, char, char, int) {}
+
+    inline const std::vector<CASentMessage>& messages() { return _messages; }
+
+private:
+    std::vector<CASentMessage> _messages;
+};
+
+/*!
+	\class CAPlaybackDrift
+	\brief Measures the drift of the real-time playback
+
+	Plays a generated score through CAPlayback into CADriftMidiDevice and compares the time
+	each midi message was sent with its time in the compiled CAPlaybackTimeline. The error of
+	the first and the last second of the playback is averaged, and their difference is the
+	drift. The deviation is the largest error of a single message relative to the first one
+	over the whole playback. The harness is built when CANORUS_BENCHMARKS is set and fails, if
+	the drift exceeds --max-drift or the deviation exceeds --max-deviation microseconds:
+
+	\code
+	  cmake -DCANORUS_BENCHMARKS=True ..
+	  make drift-check
+	  ./src/canorus-drift --minutes 10 --voices 4 --max-drift 1000 --max-deviation 1000
+	\endcode
+
+	The lateness reported by CAPlayback::lateness() is printed as well for comparison.
+*/
+class CAPlaybackDrift {
+public:
+    CAPlaybackDrift(int minutes, int voices);
+
+    bool run(qint64 maxDrift, qint64 maxDeviation);
+
+private:
+    qint64 error(const CADriftMidiDevice::CASentMessage& m);
+    qint64 averageError(qint64 fromUsec, qint64 toUsec);
+    qint64 maxError();
+
+    std::unique_ptr<CADocument> _document;
+    std::unique_ptr<CADriftMidiDevice> _device;
+    QHash<int, qint64> _usec; // real time of each playback time in the timeline
+    qint64 _firstUsec;
+    std::chrono::steady_clock::time_point _firstSent;
+};
+
+/*!
+	Generates a score of \a voices voices long at least \a minutes minutes.
+*/
+CAPlaybackDrift::CAPlaybackDrift(int minutes, int voices)
+    : _firstUsec(0)
+{
+    // measures the length of a bar and generates enough of them
+    std::unique_ptr<CADocument> bar(CAScoreGenerator::generateDocument(1, 1));
+    std::unique_ptr<CAPlaybackTimeline> barTimeline(bar->sheetList().first()->playbackTimeline()->snapshot());
+    qint64 barUsec = qMax<qint64>(barTimeline->events().isEmpty() ? 0 : barTimeline->events().last().usec, 1);
+    int bars = static_cast<int>(std::ceil(minutes * 60000000.0 / barUsec));
+
+    _document.reset(CAScoreGenerator::generateDocument(bars, voices));
+    std::cerr << "Playing " << bars << " bars of " << voices << " voices, " << bars * barUsec / 1000000 << " s" << std::endl;
+}
+
+/*!
+	Returns the difference in microseconds between the sent and the expected time of the
+	message \a m, both relative to the first message.
+*/
+qint64 CAPlaybackDrift::error(const CADriftMidiDevice::CASentMessage& m)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(m.sent - _firstSent).count() - (_usec.value(m.time) - _firstUsec);
+}
+
+/*!
+	Returns the average difference in microseconds between the sent and the expected time
+	of the messages expected from \a fromUsec to \a toUsec after the first message.
+*/
+qint64 CAPlaybackDrift::averageError(qint64 fromUsec, qint64 toUsec)
+{
+    qint64 total = 0;
+    int count = 0;
+    for (const CADriftMidiDevice::CASentMessage& m : _device->messages()) {
+        qint64 expected = _usec.value(m.time) - _firstUsec;
+        if (expected >= fromUsec && expected <= toUsec) {
+            total += error(m);
+            count++;
+        }
+    }
+    return count ? total / count : 0;
+}
+
+/*!
+	Returns the largest absolute difference in microseconds between the sent and the expected
+	time of a message during the whole playback.
+*/
+qint64 CAPlaybackDrift::maxError()
+{
+    qint64 max = 0;
+    for (const CADriftMidiDevice::CASentMessage& m : _device->messages()) {
+        max = qMax(max, std::abs(error(m)));
+    }
+    return max;
+}
+
+/*!
+	Plays the score and returns True, if the drift was below \a maxDrift microseconds and
+	no message deviated by \a maxDeviation microseconds or more.
+*/
+bool CAPlaybackDrift::run(qint64 maxDrift, qint64 maxDeviation)
+{
+    CASheet* sheet = _document->sheetList().first();
+    std::unique_ptr<CAPlaybackTimeline> timeline(sheet->playbackTimeline()->snapshot());
+    for (const CAPlaybackEvent& e : timeline->events()) {
+        if (!_usec.contains(e.time)) {
+            _usec[e.time] = e.usec;
+        }
+    }
+
+    _device.reset(new CADriftMidiDevice(timeline->events().size() * 2));
+    CAPlayback playback(sheet, _device.get());
+    playback.start();
+    playback.wait();
+
+    const std::vector<CADriftMidiDevice::CASentMessage>& messages = _device->messages();
+    if (messages.empty()) {
+        std::cerr << "No midi messages were sent" << std::endl;
+        return false;
+    }
+    _firstSent = messages.front().sent;
+    _firstUsec = _usec.value(messages.front().time);
+    qint64 lengthUsec = _usec.value(messages.back().time) - _firstUsec;
+
+    qint64 startError = averageError(0, 1000000);
+    qint64 endError = averageError(lengthUsec - 1000000, lengthUsec);
+    qint64 drift = endError - startError;
+    qint64 deviation = maxError();
+
+    const CAPlaybackLateness& lateness = playback.lateness();
+    std::cout << "messages " << messages.size() << ", length " << lengthUsec / 1000000 << " s" << std::endl
+              << "drift " << drift << " us (start error " << startError << " us, end error " << endError << " us)" << std::endl
+              << "max deviation " << deviation << " us" << std::endl
+              << "lateness: average " << lateness.average() << " us, max " << lateness.max << " us, drift " << lateness.drift() << " us" << std::endl;
+
+    if (std::abs(drift) >= maxDrift) {
+        std::cerr << "Drift " << drift << " us exceeds " << maxDrift << " us" << std::endl;
+        return false;
+    }
+    if (deviation >= maxDeviation) {
+        std::cerr << "Deviation " << deviation << " us exceeds " << maxDeviation << " us" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments();
+
+    int minutes = 10;
+    int voices = 4;
+    qint64 maxDrift = 1000;
+    qint64 maxDeviation = 1000;
+    bool valid = true;
+    for (int i = 1; i < args.size() && valid; i++) {
+        if (args[i] == "--minutes" && i + 1 < args.size()) {
+            minutes = args[++i].toInt(&valid);
+        } else if (args[i] == "--voices" && i + 1 < args.size()) {
+            voices = args[++i].toInt(&valid);
+        } else if (args[i] == "--max-drift" && i + 1 < args.size()) {
+            maxDrift = args[++i].toLongLong(&valid);
+        } else if (args[i] == "--max-deviation" && i + 1 < args.size()) {
+            maxDeviation = args[++i].toLongLong(&valid);
+        } else {
+            valid = false;
+        }
+    }
+
+    if (!valid || minutes <= 0 || voices <= 0) {
+        std::cerr << "Usage: canorus-drift [<options>]" << std::endl
+                  << "Options:" << std::endl
+                  << "  --minutes <n>         length of the played score, default 10" << std::endl
+                  << "  --voices <n>          number of voices of the played score, default 4" << std::endl
+                  << "  --max-drift <us>      fail if the drift is larger, default 1000" << std::endl
+                  << "  --max-deviation <us>  fail if a single message deviates more, default 1000" << std::endl;
+        return 2;
+    }
+
+    CAPlaybackDrift drift(minutes, voices);
+    return drift.run(maxDrift, maxDeviation) ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <Python.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <QTemporaryDir>
+
+#include <functional>
+#include <iostream>
+
+#include "scripting/swigpython.h"
+
+/*!
+	\file pluginbenchmark.cpp
+	\brief Benchmark of the Python plugin actions
+
+	Calls a trivial plugin function the given number of times (10000 by default) through
+	CASwigPython::callFunction(), the same as CAPlugin::callAction() does for every action,
+	and writes the time per invocation as JSON in the format of canorus-benchmark:
+
+	\code
+	  make canorus-plugin-benchmark
+	  ./src/canorus-plugin-benchmark --invocations 10000 --output plugins.json
+	\endcode
+
+	"PyImport_ReloadModule" measures reloading of the plugin module, which was done for every
+	action invocation before the modules were cached.
+
+	The benchmark plugin doesn't import CanorusPython, so the SWIG wrapper is not linked and
+	swigpython.cpp is compiled with CANORUS_NO_SWIG_WRAPPER, which leaves out its
+	initialization. CASwigPython::init() is never called.
+*/
+
+/*!
+	Calls the \a invocation \a invocations times and returns the time per invocation.
+*/
+static QJsonObject measure(const QString& name, int invocations, std::function<void(int)> invocation)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < invocations; i++) {
+        invocation(i);
+    }
+    double ns = timer.nsecsElapsed();
+
+    std::cerr << qPrintable(name) << ": " << ns / invocations << " ns" << std::endl;
+
+    QJsonObject o;
+    o["name"] = name;
+    o["iterations"] = invocations;
+    o["nsPerOp"] = ns / invocations;
+    return o;
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments();
+
+    int invocations = 10000;
+    QString outputFileName;
+    bool valid = true;
+    for (int i = 1; i < args.size() && valid; i++) {
+        if (args[i] == "--invocations" && i + 1 < args.size()) {
+            invocations = args[++i].toInt(&valid);
+        } else if (args[i] == "--output" && i + 1 < args.size()) {
+            outputFileName = args[++i];
+        } else {
+            valid = false;
+        }
+    }
+    if (!valid || invocations <= 0) {
+        std::cerr << "Usage: canorus-plugin-benchmark [--invocations <n>] [--output <file>]" << std::endl;
+        return 2;
+    }
+
+    QTemporaryDir dir;
+    QString fileName = dir.path() + "/benchmarkplugin.py";
+    QFile plugin(fileName);
+    if (!plugin.open(QIODevice::WriteOnly)) {
+        std::cerr << qPrintable(fileName) << ": " << qPrintable(plugin.errorString()) << std::endl;
+        return 1;
+    }
+    plugin.write("def onNote(pitch):\n"
+                 "    return pitch + 1\n");
+    plugin.close();
+
+    Py_Initialize();
+    PyEval_InitThreads();
+    PyRun_SimpleString((QString("import sys\nsys.path.append('") + dir.path() + "')").toUtf8().constData());
+    CASwigPython::mainThreadState = PyThreadState_Get();
+    PyEval_ReleaseThread(CASwigPython::mainThreadState);
+
+    auto callAction = [&](int i, bool autoReload) {
+        PyEval_RestoreThread(CASwigPython::mainThreadState);
+        QList<PyObject*> pythonArgs;
+        pythonArgs << PyLong_FromLong(i);
+        PyEval_ReleaseThread(CASwigPython::mainThreadState);
+
+        CASwigPython::releaseObject(CASwigPython::callFunction(fileName, "onNote", pythonArgs, autoReload));
+    };
+
+    QJsonArray results;
+    results << measure("CASwigPython::callFunction", invocations, [&](int i) { callAction(i, false); });
+    results << measure("CASwigPython::callFunction+autoReload", invocations, [&](int i) { callAction(i, true); });
+
+    PyEval_RestoreThread(CASwigPython::mainThreadState);
+    PyObject* pyModule = PyImport_ImportModule("benchmarkplugin");
+    results << measure("PyImport_ReloadModule", invocations, [&](int) { Py_XDECREF(PyImport_ReloadModule(pyModule)); });
+    Py_XDECREF(pyModule);
+    PyEval_ReleaseThread(CASwigPython::mainThreadState);
+
+    QJsonObject o;
+    o["benchmark"] = QString("canorus-plugin");
+    o["version"] = QString(CANORUS_VERSION);
+    o["results"] = results;
+
+    QFile output;
+    if (outputFileName.isEmpty()) {
+        output.open(stdout, QIODevice::WriteOnly);
+    } else {
+        output.setFileName(outputFileName);
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::cerr << qPrintable(outputFileName) << ": " << qPrintable(output.errorString()) << std::endl;
+            return 1;
+        }
+    }
+    output.write(QJsonDocument(o).toJson());
+
+    return 0;
+}
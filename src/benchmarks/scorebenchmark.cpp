@@ -0,0 +1,539 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <random>
+
+#include "benchmarks/scoregenerator.h"
+#include "core/scoretable.h"
+#include "core/transpose.h"
+#include "export/lilypondexport.h"
+#include "export/midiexport.h"
+#include "import/lilypondimport.h"
+#include "interface/mididevice.h"
+#include "interface/playback.h"
+#include "interface/playbacktimeline.h"
+#include "score/document.h"
+#include "score/note.h"
+#include "score/sheet.h"
+#include "score/staff.h"
+#include "score/voice.h"
+
+/*!
+	\class CAScoreBenchmark
+	\brief Microbenchmarks of the score model
+
+	Times the operations of the score model which are called for every edit, import and
+	playback on the synthetic scores generated by CAScoreGenerator. The benchmark is built
+	when CANORUS_BENCHMARKS is set:
+
+	\code
+	  cmake -DCANORUS_BENCHMARKS=True ..
+	  make canorus-benchmark
+	  ./src/canorus-benchmark --bars 100,1000 --voices 1,32 --output results.json
+	\endcode
+
+	Every case is repeated until it took at least --min-time milliseconds. The results are
+	written as a JSON document with the median and the minimum time of a single operation in
+	nanoseconds, so the results of different commits can be compared by a script:
+
+	\code
+	  {"benchmark":"canorus-score","version":"0.7.3","results":[
+	    {"name":"CAVoice::insert","bars":100,"voices":1,"iterations":4096,"nsPerOp":812.5,"minNsPerOp":790.0},
+	    ...
+	  ]}
+	\endcode
+
+	CAVoice::updateTimes() is private, so it is measured by inserting and removing notes at
+	the beginning of the voice which shifts all the following elements ("CAVoice::insert+updateTimes"
+	and "CAVoice::remove"). "CAVoice::insert" appends the notes for comparison.
+
+	runOpera() renders and exports the score of the length of a two hour opera. The benchmark
+	fails, if the midi export of the opera including the compilation of the sheet takes a
+	second or more. Call it with --opera-only to skip the other cases.
+
+	runLilyPondImport() imports a LilyPond voice of at least LILYPOND_SOURCE_SIZE bytes, which
+	is exported from a generated score beforehand.
+*/
+class CAScoreBenchmark {
+public:
+    CAScoreBenchmark();
+
+    inline void setMinTime(int msecs) { _minTime = msecs; }
+    inline void setFilter(const QString& filter) { _filter = filter; }
+
+    void run(int bars, int voices);
+    bool runOpera();
+    void runLilyPondImport();
+    inline const QJsonArray& results() { return _results; }
+
+    static const int OPERA_BARS;
+    static const int OPERA_VOICES;
+    static const qint64 OPERA_BUDGET;
+    static const int LILYPOND_SOURCE_SIZE;
+
+private:
+    qint64 measure(const QString& name, int ops, std::function<qint64()> iteration);
+    QList<CANote*> createNotes(CAVoice* voice, int count);
+
+    int _minTime; // minimum time of a case in milliseconds
+    QString _filter;
+    QJsonArray _results;
+    std::mt19937 _random;
+    int _bars;
+    int _voices;
+    volatile int _sink; // consumes the results, so the calls are not optimized out
+};
+
+/*!
+	Midi device which drops the messages, so only the rendering is measured.
+*/
+class CANullMidiDevice : public CAMidiDevice {
+public:
+    CANullMidiDevice() { setRealTime(false); }
+
+    QMap<int, QString> getOutputPorts() { return QMap<int, QString>(); }
+    QMap<int, QString> getInputPorts() { return QMap<int, QString>(); }
+    bool openOutputPort(int) { return true; }
+    bool openInputPort(int) { return false; }
+    void closeOutputPort() {}
+    void closeInputPort() {}
+    void send(QVector<unsigned char>, int) { _messages++; }
+    void send(const unsigned char*, int, int) { _messages++; }
+    void sendMetaEvent(int, char, char, char, int) {}
+
+    inline int messages() { return _messages; }
+
+private:
+    int _messages = 0;
+};
+
+const int CAScoreBenchmark::OPERA_BARS = 3600; // two hours of 4/4 bars at 120 bpm
+const int CAScoreBenchmark::OPERA_VOICES = 32; // orchestra, soloists and choir
+const qint64 CAScoreBenchmark::OPERA_BUDGET = 1000000000LL; // nanoseconds
+const int CAScoreBenchmark::LILYPOND_SOURCE_SIZE = 1024 * 1024; // bytes
+
+CAScoreBenchmark::CAScoreBenchmark()
+    : _minTime(200)
+    , _random(1)
+    , _bars(0)
+    , _voices(0)
+    , _sink(0)
+{
+}
+
+/*!
+	Repeats the \a iteration until it took at least minTime() milliseconds and stores the
+	result. \a iteration returns the time of its measured part in nanoseconds, so the setup
+	and the clean up are excluded. It runs \a ops operations every time.
+	Returns the median time of the iteration in nanoseconds or -1, if the case was filtered out.
+*/
+qint64 CAScoreBenchmark::measure(const QString& name, int ops, std::function<qint64()> iteration)
+{
+    if (!_filter.isEmpty() && !name.contains(_filter)) {
+        return -1;
+    }
+
+    QVector<qint64> times;
+    qint64 total = 0;
+    while (times.isEmpty() || (total < _minTime * 1000000LL && times.size() < 100000)) {
+        qint64 time = iteration();
+        times << time;
+        total += time;
+    }
+    std::sort(times.begin(), times.end());
+
+    QJsonObject o;
+    o["name"] = name;
+    o["bars"] = _bars;
+    o["voices"] = _voices;
+    o["iterations"] = times.size();
+    o["nsPerOp"] = double(times[times.size() / 2]) / ops;
+    o["minNsPerOp"] = double(times.first()) / ops;
+    _results << o;
+
+    std::cerr << qPrintable(name) << " bars=" << _bars << " voices=" << _voices << ": "
+              << double(times[times.size() / 2]) / ops << " ns" << std::endl;
+
+    return times[times.size() / 2];
+}
+
+/*!
+	Returns \a count new quarter notes for the given \a voice, not inserted yet.
+*/
+QList<CANote*> CAScoreBenchmark::createNotes(CAVoice* voice, int count)
+{
+    QList<CANote*> notes;
+    for (int i = 0; i < count; i++) {
+        notes << new CANote(CADiatonicPitch(28 + i % 7), CAPlayableLength(CAPlayableLength::Quarter), voice, 0);
+    }
+    return notes;
+}
+
+/*!
+	Runs all the cases on a generated score of \a bars bars and \a voices voices.
+*/
+void CAScoreBenchmark::run(int bars, int voices)
+{
+    const int BATCH = 16; // edits per iteration
+    const int LOOKUPS = 256; // lookups per iteration
+
+    _bars = bars;
+    _voices = voices;
+    CADocument* document = CAScoreGenerator::generateDocument(bars, voices);
+    CASheet* sheet = document->sheetList().first();
+    CAVoice* voice = sheet->voiceList().first();
+    CANote* firstNote = voice->getNoteList().first();
+    QElapsedTimer timer;
+
+    measure("CAVoice::insert", BATCH, [&]() {
+        QList<CANote*> notes = createNotes(voice, BATCH);
+        timer.start();
+        for (CANote* note : notes) {
+            voice->insert(nullptr, note);
+        }
+        qint64 time = timer.nsecsElapsed();
+        for (int i = notes.size() - 1; i >= 0; i--) {
+            voice->remove(notes[i]);
+            delete notes[i];
+        }
+        return time;
+    });
+
+    measure("CAVoice::insert+updateTimes", BATCH, [&]() {
+        QList<CANote*> notes = createNotes(voice, BATCH);
+        timer.start();
+        for (CANote* note : notes) {
+            voice->insert(firstNote, note);
+        }
+        qint64 time = timer.nsecsElapsed();
+        for (CANote* note : notes) {
+            voice->remove(note);
+            delete note;
+        }
+        return time;
+    });
+
+    measure("CAVoice::remove", BATCH, [&]() {
+        QList<CANote*> notes = createNotes(voice, BATCH);
+        for (CANote* note : notes) {
+            voice->insert(firstNote, note);
+        }
+        timer.start();
+        for (CANote* note : notes) {
+            voice->remove(note);
+        }
+        qint64 time = timer.nsecsElapsed();
+        qDeleteAll(notes);
+        return time;
+    });
+
+    QList<CAStaff*> staffs = sheet->staffList();
+    measure("CAStaff::synchronizeVoices", staffs.size(), [&]() {
+        timer.start();
+        for (CAStaff* staff : staffs) {
+            _sink += staff->synchronizeVoices();
+        }
+        return timer.nsecsElapsed();
+    });
+
+    // appends the notes synchronizing the voices after each one, as the scripts do
+    auto appendSynchronized = [&](bool batch) {
+        CAStaff* staff = voice->staff();
+        QList<int> sizes;
+        for (CAVoice* v : staff->voiceList()) {
+            sizes << v->musElementList().size();
+        }
+
+        QList<CANote*> notes = createNotes(voice, BATCH);
+        timer.start();
+        if (batch) {
+            document->beginBatch();
+        }
+        for (CANote* note : notes) {
+            voice->append(note);
+            staff->synchronizeVoices();
+        }
+        if (batch) {
+            document->endBatch();
+        }
+        qint64 time = timer.nsecsElapsed();
+
+        for (int i = 0; i < staff->voiceList().size(); i++) { // removes the notes and the rests added by the synchronization
+            CAVoice* v = staff->voiceList()[i];
+            while (v->musElementList().size() > sizes[i]) {
+                CAMusElement* elt = v->musElementList().last();
+                v->remove(elt);
+                delete elt;
+            }
+        }
+        return time;
+    };
+    measure("CAStaff::synchronizeVoices per insert", BATCH, [&]() { return appendSynchronized(false); });
+    measure("CADocument::beginBatch", BATCH, [&]() { return appendSynchronized(true); });
+
+    QList<CANote*> noteList = voice->getNoteList();
+    QVector<CANote*> notes(LOOKUPS);
+    QVector<int> times(LOOKUPS);
+    for (int i = 0; i < LOOKUPS; i++) {
+        notes[i] = noteList[_random() % noteList.size()];
+        times[i] = _random() % voice->lastTimeEnd();
+    }
+
+    measure("CANote::getChord", LOOKUPS, [&]() {
+        timer.start();
+        for (CANote* note : notes) {
+            _sink += note->getChord().size();
+        }
+        return timer.nsecsElapsed();
+    });
+
+    measure("CAVoice::getChord", LOOKUPS, [&]() {
+        timer.start();
+        for (int time : times) {
+            _sink += voice->getChord(time).size();
+        }
+        return timer.nsecsElapsed();
+    });
+
+    measure("CADocument::clone", 1, [&]() {
+        timer.start();
+        CADocument* clone = document->clone();
+        qint64 time = timer.nsecsElapsed();
+        delete clone;
+        return time;
+    });
+
+    CAScoreTable table(sheet);
+    QVector<qint32> tableData(CAScoreTable::ColumnCount * table.rowCount());
+    measure("CAScoreTable::write", table.rowCount(), [&]() {
+        timer.start();
+        CAScoreTable(sheet).write(tableData.data());
+        qint64 time = timer.nsecsElapsed();
+        _sink += tableData.last();
+        return time;
+    });
+
+    measure("CATranspose::transposeBySemitones", 2, [&]() {
+        timer.start();
+        CATranspose(sheet).transposeBySemitones(3);
+        CATranspose(sheet).transposeBySemitones(-3);
+        return timer.nsecsElapsed();
+    });
+
+    delete document;
+}
+
+/*!
+	Renders and exports a generated score of the length of a two hour opera. The export
+	compiles the whole sheet every time, the rendering reuses the compiled timeline.
+	Returns False, if the export took OPERA_BUDGET or more.
+*/
+bool CAScoreBenchmark::runOpera()
+{
+    _bars = OPERA_BARS;
+    _voices = OPERA_VOICES;
+    CADocument* document = CAScoreGenerator::generateDocument(OPERA_BARS, OPERA_VOICES);
+    CASheet* sheet = document->sheetList().first();
+    QElapsedTimer timer;
+
+    CANullMidiDevice device;
+    measure("CAPlayback::render opera", 1, [&]() {
+        timer.start();
+        CAPlayback playback(sheet, &device);
+        playback.render();
+        qint64 time = timer.nsecsElapsed();
+        _sink += device.messages();
+        return time;
+    });
+
+    qint64 exportTime = measure("CAMidiExport opera", 1, [&]() {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        CAMidiExport midiExport;
+        midiExport.setStreamToDevice(&buffer);
+        sheet->playbackTimeline()->invalidate();
+        timer.start();
+        midiExport.exportSheet(sheet);
+        midiExport.wait();
+        qint64 time = timer.nsecsElapsed();
+        _sink += buffer.size();
+        return time;
+    });
+
+    QList<CAMusElement*> selection;
+    for (CAMusElement* elt : sheet->voiceList().first()->musElementList()) {
+        if (elt->timeStart() >= OPERA_BARS / 2 * 4 * CAPlayableLength::playableLengthToTimeLength(CAPlayableLength::Quarter) && selection.size() < 64) { // an excerpt from the middle
+            selection << elt;
+        }
+    }
+    measure("CAMidiExport opera selection", 1, [&]() {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        CAMidiExport midiExport;
+        midiExport.setStreamToDevice(&buffer);
+        midiExport.setSelection(selection);
+        timer.start();
+        midiExport.exportSheet(sheet);
+        midiExport.wait();
+        qint64 time = timer.nsecsElapsed();
+        _sink += buffer.size();
+        return time;
+    });
+
+    delete document;
+
+    if (exportTime >= OPERA_BUDGET) {
+        std::cerr << "The midi export of the opera took " << exportTime / 1000000 << " ms, the budget is "
+                  << OPERA_BUDGET / 1000000 << " ms" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*!
+	Exports the first voice of a generated score to LilyPond, doubling the number of bars until
+	the source has at least LILYPOND_SOURCE_SIZE bytes, and imports it back.
+*/
+void CAScoreBenchmark::runLilyPondImport()
+{
+    CADocument* document = nullptr;
+    QString source;
+    for (_bars = 1000, _voices = 1; source.size() < LILYPOND_SOURCE_SIZE; _bars *= 2) {
+        delete document;
+        document = CAScoreGenerator::generateDocument(_bars, _voices);
+
+        QString* value = new QString();
+        QTextStream stream(value);
+        CALilyPondExport lilyPondExport(&stream);
+        lilyPondExport.exportVoice(document->sheetList().first()->voiceList().first());
+        lilyPondExport.wait();
+        stream.flush();
+        source = *value;
+        delete value;
+    }
+    _bars /= 2;
+
+    CAVoice* voice = document->sheetList().first()->voiceList().first();
+    QElapsedTimer timer;
+    measure("CALilyPondImport::importVoice 1MB", 1, [&]() {
+        CALilyPondImport lilyPondImport(source);
+        lilyPondImport.setTemplateVoice(voice);
+        timer.start();
+        lilyPondImport.importVoice();
+        lilyPondImport.wait();
+        qint64 time = timer.nsecsElapsed();
+        CAVoice* imported = lilyPondImport.importedVoice();
+        _sink += imported->musElementList().size();
+        delete imported;
+        return time;
+    });
+
+    delete document;
+}
+
+/*!
+	Parses the comma separated list of numbers of the command line \a option.
+*/
+static QList<int> parseSizes(const QString& option, bool* ok)
+{
+    QList<int> sizes;
+    for (const QString& s : option.split(',')) {
+        int size = s.toInt(ok);
+        if (!*ok || size <= 0) {
+            *ok = false;
+            return sizes;
+        }
+        sizes << size;
+    }
+    return sizes;
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments();
+
+    QList<int> barsList = { 100, 1000, 10000 };
+    QList<int> voicesList = { 1, 4, 32 };
+    QString outputFileName;
+    CAScoreBenchmark benchmark;
+    bool operaOnly = false;
+    bool valid = true;
+    for (int i = 1; i < args.size() && valid; i++) {
+        if (args[i] == "--bars" && i + 1 < args.size()) {
+            barsList = parseSizes(args[++i], &valid);
+        } else if (args[i] == "--voices" && i + 1 < args.size()) {
+            voicesList = parseSizes(args[++i], &valid);
+        } else if (args[i] == "--min-time" && i + 1 < args.size()) {
+            benchmark.setMinTime(args[++i].toInt(&valid));
+        } else if (args[i] == "--filter" && i + 1 < args.size()) {
+            benchmark.setFilter(args[++i]);
+        } else if (args[i] == "--output" && i + 1 < args.size()) {
+            outputFileName = args[++i];
+        } else if (args[i] == "--opera-only") {
+            operaOnly = true;
+        } else {
+            valid = false;
+        }
+    }
+
+    if (!valid) {
+        std::cerr << "Usage: canorus-benchmark [<options>]" << std::endl
+                  << "Options:" << std::endl
+                  << "  --bars <n,...>      numbers of bars of the generated scores, default 100,1000,10000" << std::endl
+                  << "  --voices <n,...>    numbers of voices of the generated scores, default 1,4,32" << std::endl
+                  << "  --min-time <ms>     minimum time of each case, default 200" << std::endl
+                  << "  --filter <text>     run only the cases containing the text" << std::endl
+                  << "  --output <file>     write the JSON results to the file instead of the standard output" << std::endl
+                  << "  --opera-only        only render and export the score of a two hour opera" << std::endl;
+        return 2;
+    }
+
+    for (int bars : (operaOnly ? QList<int>() : barsList)) {
+        for (int voices : voicesList) {
+            benchmark.run(bars, voices);
+        }
+    }
+    if (!operaOnly) {
+        benchmark.runLilyPondImport();
+    }
+    bool withinBudget = benchmark.runOpera();
+
+    QJsonObject o;
+    o["benchmark"] = QString("canorus-score");
+    o["version"] = QString(CANORUS_VERSION);
+    o["results"] = benchmark.results();
+    QByteArray json = QJsonDocument(o).toJson();
+
+    QFile output;
+    if (outputFileName.isEmpty()) {
+        output.open(stdout, QIODevice::WriteOnly);
+    } else {
+        output.setFileName(outputFileName);
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::cerr << qPrintable(outputFileName) << ": " << qPrintable(output.errorString()) << std::endl;
+            return 1;
+        }
+    }
+    output.write(json);
+
+    return withinBudget ? 0 : 1;
+}
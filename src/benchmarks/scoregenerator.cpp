@@ -0,0 +1,96 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QString>
+
+#include "benchmarks/scoregenerator.h"
+#include "score/barline.h"
+#include "score/clef.h"
+#include "score/document.h"
+#include "score/keysignature.h"
+#include "score/note.h"
+#include "score/rest.h"
+#include "score/sheet.h"
+#include "score/staff.h"
+#include "score/timesignature.h"
+#include "score/voice.h"
+
+/*!
+	\class CAScoreGenerator
+	\brief Synthetic scores for the benchmarks
+
+	Generates documents of the given number of bars and voices with a predictable content,
+	so the timings of different commits can be compared.
+
+	Every staff contains up to VOICES_PER_STAFF voices. Each bar of a voice in 4/4 consists of
+	a three-note chord on the first beat, two quarter notes and a quarter rest. The clef, key
+	signature, time signature and barlines are shared by all the voices of the staff, the same
+	as in the imported scores.
+
+	\sa CAScoreBenchmark
+*/
+
+const int CAScoreGenerator::VOICES_PER_STAFF = 2;
+
+/*!
+	Returns a new document with a single sheet of \a bars bars and \a voices voices.
+	The document is owned by the caller.
+*/
+CADocument* CAScoreGenerator::generateDocument(int bars, int voices)
+{
+    CADocument* document = new CADocument();
+    document->setTitle(QString("Generated score, %1 bars, %2 voices").arg(bars).arg(voices));
+    CASheet* sheet = document->addSheet();
+
+    for (int v = 0; v < voices; v += VOICES_PER_STAFF) {
+        generateStaff(sheet->addStaff(), bars, qMin(VOICES_PER_STAFF, voices - v), v);
+    }
+
+    return document;
+}
+
+/*!
+	Fills the newly created \a staff with \a voices voices of \a bars bars.
+	\a firstVoice is the number of the first voice in the sheet and is used to spread the
+	pitches over the range.
+*/
+void CAScoreGenerator::generateStaff(CAStaff* staff, int bars, int voices, int firstVoice)
+{
+    while (staff->voiceList().size() < voices) {
+        staff->addVoice();
+    }
+
+    CAClef* clef = new CAClef((firstVoice / VOICES_PER_STAFF) % 2 ? CAClef::Bass : CAClef::Treble, staff, 0);
+    CAKeySignature* key = new CAKeySignature(CADiatonicKey(1, CADiatonicKey::Major), staff, 0);
+    CATimeSignature* time = new CATimeSignature(4, 4, staff, 0);
+    for (CAVoice* voice : staff->voiceList()) {
+        voice->append(clef);
+        voice->append(key);
+        voice->append(time);
+    }
+
+    for (int bar = 0; bar < bars; bar++) {
+        for (int v = 0; v < voices; v++) {
+            CAVoice* voice = staff->voiceList()[v];
+            int pitch = 21 + ((firstVoice + v) * 5 + bar) % 21; // diatonic note names from c to c'''
+
+            voice->append(new CANote(CADiatonicPitch(pitch), CAPlayableLength(CAPlayableLength::Quarter), voice, 0));
+            voice->append(new CANote(CADiatonicPitch(pitch + 2), CAPlayableLength(CAPlayableLength::Quarter), voice, 0), true);
+            voice->append(new CANote(CADiatonicPitch(pitch + 4, bar % 3 - 1), CAPlayableLength(CAPlayableLength::Quarter), voice, 0), true);
+            voice->append(new CANote(CADiatonicPitch(pitch + 1), CAPlayableLength(CAPlayableLength::Quarter), voice, 0));
+            voice->append(new CANote(CADiatonicPitch(pitch - 1), CAPlayableLength(CAPlayableLength::Quarter), voice, 0));
+            voice->append(new CARest(CARest::Normal, CAPlayableLength(CAPlayableLength::Quarter), voice, 0));
+        }
+
+        CABarline* barline = new CABarline(bar == bars - 1 ? CABarline::End : CABarline::Single, staff, 0);
+        for (int v = 0; v < voices; v++) {
+            staff->voiceList()[v]->append(barline);
+        }
+    }
+
+    staff->synchronizeVoices();
+}
@@ -0,0 +1,24 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef SCOREGENERATOR_H_
+#define SCOREGENERATOR_H_
+
+class CADocument;
+class CAStaff;
+
+class CAScoreGenerator {
+public:
+    static CADocument* generateDocument(int bars, int voices);
+
+    static const int VOICES_PER_STAFF;
+
+private:
+    static void generateStaff(CAStaff* staff, int bars, int voices, int firstVoice);
+};
+
+#endif /* SCOREGENERATOR_H_ */
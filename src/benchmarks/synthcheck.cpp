@@ -0,0 +1,261 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QStringList>
+#include <QTextStream>
+
+#include <iostream>
+#include <memory>
+
+#include "benchmarks/scoregenerator.h"
+#include "core/converter.h"
+#include "export/wavexport.h"
+#include "score/document.h"
+
+/*!
+	\class CASynthCheck
+	\brief Golden output test of the WAV export
+
+	Renders the sample scores in src/tests and a generated score with CAWavExport, the same
+	as "canorus --convert score.xml score.wav", and compares the SHA-1 of each WAV file with
+	the golden checksum stored in src/tests/synth-golden.txt. Every score is rendered twice
+	and the header of the WAV file is checked, so a nondeterministic or a malformed output
+	fails even before it is compared.
+
+	The test is built when CANORUS_BENCHMARKS is set. A case missing in the golden file fails
+	the test. If the golden file itself is missing (it is not committed until it is generated
+	on a reference machine), the scores are still rendered and checked, but the comparison is
+	reported as SKIPPED. After an intended change of the synthesizer, update the golden file
+	and commit it:
+
+	\code
+	  cmake -DCANORUS_BENCHMARKS=True ..
+	  make synth-check
+	  make synth-golden    # runs canorus-synth-check --update
+	\endcode
+
+	\sa CASynthMidiDevice, CAPlayback::render()
+*/
+class CASynthCheck {
+public:
+    CASynthCheck(const QString& goldenFileName);
+
+    bool loadGolden();
+    bool saveGolden();
+    bool check(const QString& name, CADocument* document, bool update);
+
+private:
+    static QByteArray render(CADocument* document);
+    static bool checkHeader(const QByteArray& wav, QString* error);
+
+    QString _goldenFileName;
+    QMap<QString, QByteArray> _golden; // hex SHA-1 of the WAV file for each case
+    bool _goldenLoaded;
+};
+
+CASynthCheck::CASynthCheck(const QString& goldenFileName)
+    : _goldenFileName(goldenFileName)
+    , _goldenLoaded(false)
+{
+}
+
+/*!
+	Reads the golden checksums. Each line contains the name of the case and its checksum.
+*/
+bool CASynthCheck::loadGolden()
+{
+    QFile file(_goldenFileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    while (!file.atEnd()) {
+        QList<QByteArray> fields = file.readLine().trimmed().split(' ');
+        if (fields.size() == 2 && !fields[0].startsWith('#')) {
+            _golden[QString::fromUtf8(fields[0])] = fields[1];
+        }
+    }
+    _goldenLoaded = true;
+    return true;
+}
+
+bool CASynthCheck::saveGolden()
+{
+    QFile file(_goldenFileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        std::cerr << qPrintable(_goldenFileName) << ": " << qPrintable(file.errorString()) << std::endl;
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "# SHA-1 of the WAV files rendered by canorus-synth-check, see benchmarks/synthcheck.cpp\n";
+    for (QMap<QString, QByteArray>::const_iterator i = _golden.constBegin(); i != _golden.constEnd(); i++) {
+        out << i.key() << " " << i.value() << "\n";
+    }
+    return true;
+}
+
+/*!
+	Renders the first sheet of the \a document into a WAV file in memory.
+*/
+QByteArray CASynthCheck::render(CADocument* document)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    CAWavExport wavExport;
+    wavExport.setStreamToDevice(&buffer);
+    wavExport.exportDocument(document, false);
+    if (wavExport.status() != 0) {
+        return QByteArray();
+    }
+
+    return buffer.data();
+}
+
+/*!
+	Checks the RIFF header of the 16-bit stereo \a wav file and its data size.
+*/
+bool CASynthCheck::checkHeader(const QByteArray& wav, QString* error)
+{
+    const int HEADER_SIZE = 44;
+    if (wav.size() < HEADER_SIZE || !wav.startsWith("RIFF") || wav.mid(8, 8) != "WAVEfmt ") {
+        *error = "not a WAV file";
+        return false;
+    }
+
+    const unsigned char* h = reinterpret_cast<const unsigned char*>(wav.constData());
+    auto word16 = [h](int i) { return h[i] | (h[i + 1] << 8); };
+    auto word32 = [h](int i) { return static_cast<qint64>(h[i] | (h[i + 1] << 8) | (h[i + 2] << 16) | (static_cast<quint32>(h[i + 3]) << 24)); };
+    if (word16(20) != 1 || word16(22) != 2 || word16(34) != 16) {
+        *error = "not a 16-bit stereo PCM file";
+        return false;
+    }
+    if (wav.mid(36, 4) != "data" || word32(40) != wav.size() - HEADER_SIZE || word32(4) != wav.size() - 8) {
+        *error = "wrong size in the header";
+        return false;
+    }
+    if (wav.size() == HEADER_SIZE) {
+        *error = "no audio was rendered";
+        return false;
+    }
+    return true;
+}
+
+/*!
+	Renders the \a document of the case \a name and compares it with the golden checksum.
+	If \a update is True, the checksum is stored instead. Without the golden file, only the
+	header and the determinism of the output are checked.
+*/
+bool CASynthCheck::check(const QString& name, CADocument* document, bool update)
+{
+    QByteArray wav = render(document);
+    QString error;
+    if (!checkHeader(wav, &error)) {
+        std::cerr << qPrintable(name) << ": " << qPrintable(error) << std::endl;
+        return false;
+    }
+    if (render(document) != wav) {
+        std::cerr << qPrintable(name) << ": the output differs between two renderings" << std::endl;
+        return false;
+    }
+
+    QByteArray sha1 = QCryptographicHash::hash(wav, QCryptographicHash::Sha1).toHex();
+    if (update) {
+        _golden[name] = sha1;
+        std::cout << qPrintable(name) << " " << sha1.constData() << std::endl;
+        return true;
+    }
+
+    if (!_goldenLoaded) {
+        std::cout << qPrintable(name) << " rendered, comparison SKIPPED" << std::endl;
+        return true;
+    }
+    if (!_golden.contains(name)) {
+        std::cerr << qPrintable(name) << ": no golden output in " << qPrintable(_goldenFileName) << ", run with --update" << std::endl;
+        return false;
+    }
+    if (_golden[name] != sha1) {
+        std::cerr << qPrintable(name) << ": the output differs from the golden output (" << sha1.constData() << ")" << std::endl;
+        return false;
+    }
+
+    std::cout << qPrintable(name) << " OK" << std::endl;
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments();
+
+    QString goldenFileName;
+    QString testsDir;
+    bool update = false;
+    bool valid = true;
+    for (int i = 1; i < args.size() && valid; i++) {
+        if (args[i] == "--golden" && i + 1 < args.size()) {
+            goldenFileName = args[++i];
+        } else if (args[i] == "--update") {
+            update = true;
+        } else if (!args[i].startsWith('-') && testsDir.isEmpty()) {
+            testsDir = args[i];
+        } else {
+            valid = false;
+        }
+    }
+
+    if (!valid || testsDir.isEmpty()) {
+        std::cerr << "Usage: canorus-synth-check [--golden <file>] [--update] <tests directory>" << std::endl
+                  << "Options:" << std::endl
+                  << "  --golden <file>     golden checksums, default synth-golden.txt in the tests directory" << std::endl
+                  << "  --update            store the checksums of the current output as the golden output" << std::endl;
+        return 2;
+    }
+    if (goldenFileName.isEmpty()) {
+        goldenFileName = QDir(testsDir).filePath("synth-golden.txt");
+    }
+
+    CASynthCheck synthCheck(goldenFileName);
+    bool skipped = !synthCheck.loadGolden() && !update;
+    if (skipped) {
+        std::cerr << qPrintable(goldenFileName) << ": the golden output is missing, run with --update and commit it" << std::endl;
+    }
+
+    int failed = 0;
+    CAConverter converter;
+    for (const QFileInfo& info : QDir(testsDir).entryInfoList(QStringList() << "*.xml", QDir::Files, QDir::Name)) {
+        std::unique_ptr<CADocument> document(converter.importDocument(info.filePath()));
+        if (!document) {
+            std::cerr << qPrintable(info.fileName()) << ": " << qPrintable(converter.errorString()) << std::endl;
+            failed++;
+        } else if (!synthCheck.check(info.fileName(), document.get(), update)) {
+            failed++;
+        }
+    }
+
+    std::unique_ptr<CADocument> generated(CAScoreGenerator::generateDocument(16, 4));
+    if (!synthCheck.check("generated-16-bars-4-voices", generated.get(), update)) {
+        failed++;
+    }
+
+    if (update && !synthCheck.saveGolden()) {
+        return 1;
+    }
+    if (skipped && !failed) {
+        std::cout << "SKIPPED: no golden output to compare with" << std::endl;
+    }
+
+    return failed ? 1 : 0;
+}
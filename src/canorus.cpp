@@ -16,26 +16,67 @@
 #include <QLocale>
 #include <QMetaMethod>
 #include <QTextCodec>
+#include <QThread>
 #include <QTranslator>
 
 #include "canorus.h"
 #include "control/helpctl.h"
+#include "control/resourcectl.h"
+#include "core/notechecker.h"
 #include "core/settings.h"
+#include "core/startupprofile.h"
 #include "core/undo.h"
+#include "interface/playback.h"
+#include "interface/pluginjob.h"
+#include "interface/pluginmanager.h"
 #include "interface/rtmididevice.h"
+#include "score/document.h"
 #include "score/sheet.h"
 #include "scripting/swigruby.h"
 #include "ui/settingsdialog.h"
 
 // define private static members
+/*!
+	Enumerates the MIDI ports and opens the MIDI input port in the background on startup.
+	RtMidi takes a while to connect to the MIDI system, so the main window is created meanwhile.
+*/
+class CAMidiPortsThread : public QThread {
+public:
+    CAMidiPortsThread(int midiInPort)
+        : _midiInPort(midiInPort)
+        , _inputPorts(0)
+        , _outputPorts(0)
+    {
+    }
+
+    inline int inputPorts() { return _inputPorts; }
+    inline int outputPorts() { return _outputPorts; }
+
+protected:
+    void run()
+    {
+        _inputPorts = CACanorus::midiDevice()->getInputPorts().count();
+        _outputPorts = CACanorus::midiDevice()->getOutputPorts().count();
+        if (_midiInPort >= 0 && _midiInPort < _inputPorts) {
+            CACanorus::midiDevice()->openInputPort(_midiInPort);
+        }
+    }
+
+private:
+    int _midiInPort;
+    int _inputPorts;
+    int _outputPorts;
+};
+
 QList<CAMainWin*> CACanorus::_mainWinList;
 CASettings* CACanorus::_settings;
 CAAutoRecovery* CACanorus::_autoRecovery;
 CAMidiDevice* CACanorus::_midiDevice;
+CAMidiPortsThread* CACanorus::_midiPortsThread;
 CAUndo* CACanorus::_undo;
 CAHelpCtl* CACanorus::_help;
+bool CACanorus::_scriptingInitialized = false;
 QList<QString> CACanorus::_recentDocumentList;
-QHash<QString, int> CACanorus::_fetaMap;
 std::unique_ptr<QTranslator> CACanorus::_translator;
 
 /*!
@@ -89,6 +130,9 @@ void CACanorus::initMain(int, char* [])
     QCoreApplication::setOrganizationName("Canorus");
     QCoreApplication::setOrganizationDomain("canorus.org");
     QCoreApplication::setApplicationName("Canorus");
+
+    // sheets are passed from the import threads, see CAImport::sheetImported()
+    qRegisterMetaType<CASheet*>("CASheet*");
 }
 
 /*!
@@ -146,6 +190,7 @@ void CACanorus::initCommonGUI(std::unique_ptr<QFileDialog>& uiSaveDialog,
     uiExportDialog->setNameFilters(QStringList() << CAFileFormats::LILYPOND_FILTER);
     uiExportDialog->setNameFilters(uiExportDialog->nameFilters() << CAFileFormats::MUSICXML_FILTER);
     uiExportDialog->setNameFilters(uiExportDialog->nameFilters() << CAFileFormats::MIDI_FILTER);
+    uiExportDialog->setNameFilters(uiExportDialog->nameFilters() << CAFileFormats::WAV_FILTER);
     uiExportDialog->setNameFilters(uiExportDialog->nameFilters() << CAFileFormats::PDF_FILTER);
     uiExportDialog->setNameFilters(uiExportDialog->nameFilters() << CAFileFormats::SVG_FILTER);
 
@@ -164,6 +209,7 @@ void CACanorus::initCommonGUI(std::unique_ptr<QFileDialog>& uiSaveDialog,
 void CACanorus::initPlayback()
 {
     qRegisterMetaType<QVector<unsigned char>>("QVector< unsigned char >");
+    qRegisterMetaType<CAPlaybackLateness>("CAPlaybackLateness");
     setMidiDevice(new CARtMidiDevice());
 }
 
@@ -172,13 +218,48 @@ void CACanorus::initPlayback()
 	Config file is always INI file in user's home directory.
 	No native formats are used (Windows registry etc.) - this is provided for easier transition of settings between the platforms.
 
+	The MIDI ports are enumerated and the MIDI input port is opened in the background. Call
+	checkMidiPorts() once the main window is shown.
+
 	\sa settings()
 */
 CASettingsDialog::CASettingsPage CACanorus::initSettings()
 {
     _settings = new CASettings();
 
-    switch (_settings->readSettings()) {
+    int settingsPage = _settings->readSettings();
+
+    if (midiDevice()) {
+        _midiPortsThread = new CAMidiPortsThread(_settings->midiInPort());
+        _midiPortsThread->start();
+    }
+
+    switch (settingsPage) {
+    case -1:
+        return CASettingsDialog::PlaybackSettings;
+    default:
+        return CASettingsDialog::UndefinedSettings;
+    }
+}
+
+/*!
+	Waits for the MIDI ports enumerated by initSettings() and checks the MIDI settings
+	against them.
+
+	Returns the playback settings page, if the MIDI devices changed since the last run.
+*/
+CASettingsDialog::CASettingsPage CACanorus::checkMidiPorts()
+{
+    if (!_midiPortsThread) {
+        return CASettingsDialog::UndefinedSettings;
+    }
+
+    _midiPortsThread->wait();
+    int settingsPage = _settings->checkMidiPorts(_midiPortsThread->inputPorts(), _midiPortsThread->outputPorts());
+    delete _midiPortsThread;
+    _midiPortsThread = nullptr;
+
+    switch (settingsPage) {
     case -1:
         return CASettingsDialog::PlaybackSettings;
     default:
@@ -188,6 +269,8 @@ CASettingsDialog::CASettingsPage CACanorus::initSettings()
 
 /*!
 	Initializes scripting and plugins subsystem.
+
+	\sa initPlugins(), isScriptingInitialized()
 */
 void CACanorus::initScripting()
 {
@@ -197,6 +280,22 @@ void CACanorus::initScripting()
 #ifdef USE_PYTHON
     CASwigPython::init();
 #endif
+    _scriptingInitialized = true;
+}
+
+/*!
+	Initializes the scripting engine, reads the plugins and enables them in the opened main
+	windows. Called after the first main window is shown, so starting the interpreter and
+	the onInit actions of the plugins don't delay the startup. Main windows created later
+	enable the plugins themselves.
+*/
+void CACanorus::initPlugins()
+{
+    initScripting();
+    CAPluginManager::readPlugins();
+    for (CAMainWin* mainWin : mainWinList()) {
+        CAPluginManager::enablePlugins(mainWin);
+    }
 }
 
 /*!
@@ -210,6 +309,39 @@ void CACanorus::initAutoRecovery()
 void CACanorus::initUndo()
 {
     _undo = new CAUndo();
+    CAResourceCtl::setUndoDocumentsFunction([](CADocument* d) { return CACanorus::undo()->getAllDocuments(d); });
+
+    // batch of script changes is a single undo step and rebuilds the main windows once
+    // background plugin actions only change their snapshot in the job thread, see CAPluginJob
+    CADocument::setBatchFunctions(
+        [](CADocument* d) {
+#ifdef USE_PYTHON
+            if (CAPluginJob::currentJob()) {
+                return;
+            }
+#endif
+            if (CACanorus::undo()->containsUndoStack(d)) {
+                // pending, so the command of the action running the script isn't discarded
+                CACanorus::undo()->createPendingUndoCommand(d, QObject::tr("script", "undo"), nullptr);
+            }
+        },
+        [](CADocument* d) {
+#ifdef USE_PYTHON
+            if (CAPluginJob::currentJob()) {
+                return;
+            }
+#endif
+            if (CACanorus::undo()->containsUndoStack(d)) {
+                CACanorus::undo()->pushPendingUndoCommand();
+            }
+            if (CACanorus::settings()->useNoteChecker()) {
+                CANoteChecker noteChecker;
+                for (CASheet* sheet : d->sheetList()) {
+                    noteChecker.checkSheet(sheet);
+                }
+            }
+            CACanorus::rebuildUI(d);
+        });
 }
 
 void CACanorus::initFonts()
@@ -221,21 +353,19 @@ void CACanorus::initFonts()
     QFontDatabase::addApplicationFont(QFileInfo("fonts:CenturySchL-BoldItal.ttf").absoluteFilePath());
     QFontDatabase::addApplicationFont(QFileInfo("fonts:FreeSans.ttf").absoluteFilePath());
     QFontDatabase::addApplicationFont(QFileInfo("fonts:Emmentaler-14.ttf").absoluteFilePath());
-// populate glyph->codepoint map using generated list
-#include "fonts/fetaList.cxx"
 }
 
 /*!
-	Returns codepoint for an Feta (Emmentaler) glyph by its name.
- */
-int CACanorus::fetaCodepoint(const QString& name)
+	Returns the help controller. It is created when first used, because detecting the
+	User's guide language looks for the files on the disk.
+*/
+CAHelpCtl* CACanorus::help()
 {
-    return _fetaMap[name];
-}
+    if (!_help) {
+        _help = new CAHelpCtl();
+    }
 
-void CACanorus::initHelp()
-{
-    _help = new CAHelpCtl();
+    return _help;
 }
 
 void CACanorus::insertRecentDocument(QString filename)
@@ -266,8 +396,14 @@ void CACanorus::removeRecentDocument(QString filename)
 */
 void CACanorus::cleanUp()
 {
+    if (_midiPortsThread) {
+        _midiPortsThread->wait();
+        delete _midiPortsThread;
+        _midiPortsThread = nullptr;
+    }
     delete _settings;
     delete _midiDevice;
+    delete _help;
     autoRecovery()->cleanupRecovery();
     delete _autoRecovery;
     delete _undo;
@@ -290,6 +426,8 @@ bool CACanorus::parseSettingsArguments(int argc, char* argv[])
                       << "Version " << CANORUS_VERSION << std::endl;
 
             return false;
+        } else if (QString(argv[i]) == "--startup-profile") {
+            CAStartupProfile::setEnabled(true);
         }
     }
 
@@ -343,6 +481,9 @@ int CACanorus::mainWinCount(CADocument* doc)
 */
 void CACanorus::rebuildUI(CADocument* document, CASheet* sheet)
 {
+    if (document && document->isBatch())
+        return; // rebuilt at the end of the batch
+
     for (int i = 0; i < mainWinList().size(); i++)
         if (mainWinList()[i]->document() == document)
             mainWinList()[i]->rebuildUI(sheet);
@@ -351,13 +492,16 @@ void CACanorus::rebuildUI(CADocument* document, CASheet* sheet)
 /*!
 	Rebuilds main windows with the given \a document.
 	Rebuilds all main windows, if \a document is not given or null.
+	Main windows with a document in a batch are rebuilt when the batch ends, see CADocument::beginBatch().
 
 	\sa rebuildUI(CADocument*, CASheet*), CAMainWin::rebuildUI()
 */
 void CACanorus::rebuildUI(CADocument* document)
 {
     for (int i = 0; i < mainWinList().size(); i++) {
-        if (document && mainWinList()[i]->document() == document) {
+        if (mainWinList()[i]->document() && mainWinList()[i]->document()->isBatch()) {
+            continue;
+        } else if (document && mainWinList()[i]->document() == document) {
             mainWinList()[i]->rebuildUI();
         } else if (!document)
             mainWinList()[i]->rebuildUI();
@@ -32,6 +32,7 @@ class CAMidiDevice;
 class CADocument;
 class CAUndo;
 class CAHelpCtl;
+class CAMidiPortsThread;
 
 class CACanorus {
 public:
@@ -45,16 +46,16 @@ public:
     static void initPlayback();
     static bool parseSettingsArguments(int argc, char* argv[]);
     static void initScripting();
+    static void initPlugins();
+    inline static bool isScriptingInitialized() { return _scriptingInitialized; }
     static void initAutoRecovery();
     static void initUndo();
     static void initSearchPaths();
     static void initFonts();
-    static void initHelp();
+    static CASettingsDialog::CASettingsPage checkMidiPorts();
     static void parseOpenFileArguments(int argc, char* argv[]);
     static void cleanUp();
 
-    static int fetaCodepoint(const QString& name);
-
     inline static const QList<CAMainWin*>& mainWinList() { return _mainWinList; }
     inline static void addMainWin(CAMainWin* w) { _mainWinList << w; }
     inline static void removeMainWin(CAMainWin* w) { _mainWinList.removeAll(w); }
@@ -85,7 +86,7 @@ public:
     inline static CAMidiDevice* midiDevice() { return _midiDevice; }
     inline static void setMidiDevice(CAMidiDevice* d) { _midiDevice = d; }
 
-    inline static CAHelpCtl* help() { return _help; }
+    static CAHelpCtl* help();
 
     static void rebuildUI(CADocument* document, CASheet* sheet);
     static void rebuildUI(CADocument* document = nullptr);
@@ -108,15 +109,18 @@ private:
     static CAUndo* _undo;
     static QList<QString> _recentDocumentList;
     static std::unique_ptr<QTranslator> _translator;
-    static QHash<QString, int> _fetaMap;
 
     // Playback output
     static CAMidiDevice* _midiDevice;
+    static CAMidiPortsThread* _midiPortsThread;
 
     // Auto recovery
     static CAAutoRecovery* _autoRecovery;
 
     // Help
     static CAHelpCtl* _help;
+
+    // Scripting
+    static bool _scriptingInitialized;
 };
 #endif /* CANORUS_H_ */
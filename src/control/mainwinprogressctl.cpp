@@ -37,7 +37,7 @@ void CAMainWinProgressCtl::on_updateTimer_timeout()
 void CAMainWinProgressCtl::on_cancelButton_clicked(bool)
 {
     if (_file) {
-        _file->exit();
+        _file->cancel();
         restoreStatusBar();
         _updateTimer->stop();
 
@@ -54,7 +54,6 @@ void CAMainWinProgressCtl::restoreStatusBar()
 void CAMainWinProgressCtl::startProgress(CAFile &f)
 {
     _file = &f;
-    _mainWin->setMode(CAMainWin::ProgressMode);
 
     if (_updateTimer) {
         _updateTimer.reset();
@@ -48,6 +48,7 @@ void CAPreviewCtl::on_uiPrintPreview_triggered()
     // The exportDocument method defines the temporary file name and
     // directory, so we can only read it after the creation
     _poPDFExport->setStreamToFile(oTempFileName);
+    _poPDFExport->setTypesetterLocation(CACanorus::settings()->currentTypesetterLocation());
     //_poPDFExport->exportDocument( _poMainWin->document() );
     _poPDFExport->exportSheet(_poMainWin->currentSheet());
     _poPDFExport->wait();
@@ -62,6 +62,7 @@ void CAPrintCtl::printDocument()
     // The exportDocument method defines the temporary file name and
     // directory, so we can only read it after the creation
     _poSVGExport->setStreamToFile(oTempFileName);
+    _poSVGExport->setTypesetterLocation(CACanorus::settings()->currentTypesetterLocation());
     //_poSVGExport->exportDocument( _poMainWin->document() );
     _poSVGExport->exportSheet(_poMainWin->currentSheet());
     _poSVGExport->wait();
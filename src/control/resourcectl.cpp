@@ -7,10 +7,6 @@
 
 #include "control/resourcectl.h"
 #include "score/document.h"
-#ifndef SWIGCPP
-#include "canorus.h"
-#include "core/undo.h"
-#endif
 
 #include <QDir>
 #include <QFile>
@@ -36,9 +32,15 @@
 	CAResourceContainer takes care of creating copies for non-linked resources.
 	It picks a random unique name for a new resource in the system temporary file.
 
+	Resources are shared by all the undo/redo instances of the document. The application
+	sets the function returning these instances using setUndoDocumentsFunction(). Otherwise
+	only the given document is changed.
+
 	\sa CAResource
 */
 
+CAResourceCtl::CAUndoDocumentsFunction CAResourceCtl::_undoDocuments = nullptr;
+
 /*!
 	Default constructor. Currently empty.
 */
@@ -80,15 +82,11 @@ std::shared_ptr<CAResource> CAResourceCtl::importResource(QString name, QString
     }
 
     if (parent) {
-#ifndef SWIGCPP
-        QList<CADocument*> documents = CACanorus::undo()->getAllDocuments(parent);
+        QList<CADocument*> documents = undoDocuments(parent);
 
         for (int i = 0; i < documents.size(); i++) {
             documents[i]->addResource(r);
         }
-#else
-        parent->addResource(r);
-#endif
     }
 
     return r;
@@ -107,16 +105,12 @@ std::shared_ptr<CAResource> CAResourceCtl::createEmptyResource(QString name, CAD
     std::shared_ptr<CAResource> r = std::make_shared<CAResource>(QUrl::fromLocalFile(fileName), name, false, t, parent);
 
     if (parent) {
-#ifndef SWIGCPP
-        QList<CADocument*> documents = CACanorus::undo()->getAllDocuments(parent);
+        QList<CADocument*> documents = undoDocuments(parent);
 
         for (int i = 0; i < documents.size(); i++) {
             documents[i]->addResource(r);
         }
         r->document()->setModified(true);
-#else
-        parent->addResource(r);
-#endif
     }
 
     return r;
@@ -128,17 +122,25 @@ std::shared_ptr<CAResource> CAResourceCtl::createEmptyResource(QString name, CAD
 void CAResourceCtl::deleteResource(std::shared_ptr<CAResource> r)
 {
     if (r->document()) {
-#ifndef SWIGCPP
-        QList<CADocument*> documents = CACanorus::undo()->getAllDocuments(r->document());
+        QList<CADocument*> documents = undoDocuments(r->document());
 
         for (int i = 0; i < documents.size(); i++) {
             documents[i]->removeResource(r);
         }
         r->document()->setModified(true);
-#else
-        r->document()->removeResource(r);
-#endif
     }
 
     r.reset();
 }
+
+/*!
+	Returns the undo/redo instances of the given \a document including the document itself.
+ */
+QList<CADocument*> CAResourceCtl::undoDocuments(CADocument* document)
+{
+    if (_undoDocuments) {
+        return _undoDocuments(document);
+    }
+
+    return QList<CADocument*>() << document;
+}
@@ -23,6 +23,15 @@ public:
     static std::shared_ptr<CAResource> importResource(QString name, QString fileName, bool isLinked = false, CADocument* parent = nullptr, CAResource::CAResourceType t = CAResource::Other);
     static std::shared_ptr<CAResource> createEmptyResource(QString name, CADocument* parent = nullptr, CAResource::CAResourceType t = CAResource::Other);
     static void deleteResource(std::shared_ptr<CAResource>);
+
+#ifndef SWIG
+    typedef QList<CADocument*> (*CAUndoDocumentsFunction)(CADocument*);
+    static inline void setUndoDocumentsFunction(CAUndoDocumentsFunction f) { _undoDocuments = f; }
+
+private:
+    static QList<CADocument*> undoDocuments(CADocument* document);
+    static CAUndoDocumentsFunction _undoDocuments;
+#endif
 };
 
 #endif /* RESOURCECTL_H_ */
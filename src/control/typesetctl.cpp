@@ -67,6 +67,20 @@ void CATypesetCtl::setTypesetter(const QString& roProgramName, const QString& ro
     }
 }
 
+/*!
+	Returns the location of the typesetter installed on the system by default.
+*/
+QString CATypesetCtl::defaultTypesetterLocation()
+{
+#ifdef Q_OS_WIN
+    return "LilyPond/usr/bin/lilypond.exe";
+#elif defined(Q_OS_MAC)
+    return "/Applications/LilyPond.app/Contents/Resources/bin/lilypond";
+#else
+    return "lilypond";
+#endif
+}
+
 /*!
 	Defines the postscript->pdf executable name to be run
 
@@ -29,6 +29,7 @@ public:
     ~CATypesetCtl();
 
     void setTypesetter(const QString& roProgramName, const QString& roProgramPath = "");
+    static QString defaultTypesetterLocation();
     void setPS2PDF(const QString& roProgrammName, const QString& roProgramPath = "",
         const QStringList& roParams = (QStringList() << QString("")));
     virtual void setExpOption(const QVariant& roName, const QVariant& roValue);
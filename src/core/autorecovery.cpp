@@ -47,6 +47,7 @@
 */
 CAAutoRecovery::CAAutoRecovery()
     : _saveAfterRecoveryTimer(nullptr)
+    , _recoveryInProgress(false)
 {
     _autoRecoveryTimer = new QTimer(this);
     _autoRecoveryTimer->setSingleShot(false);
@@ -109,38 +110,102 @@ void CAAutoRecovery::cleanupRecovery()
 }
 
 /*!
-	Searches for any not-cleaned up recovery files and opens them.
-	Also shows the recovery message.
+	Searches for any not-cleaned up recovery files and starts opening them in the background.
+	Each recovered document is shown in a new main window as soon as its import is finished.
+	The recovery message is shown when all the documents are opened.
+
+	\sa onRecoveryImportDone(), finishRecovery()
 */
 void CAAutoRecovery::openRecovery()
 {
-    QString documents;
+    _recoveredDocuments.clear();
+    _recoveryInProgress = true;
     for (int i = 0; QFile::exists(CASettings::defaultSettingsPath() + "/recovery" + QString::number(i)); i++) {
-        CACanorusMLImport open;
-        open.setStreamFromFile(CASettings::defaultSettingsPath() + "/recovery" + QString::number(i));
-        open.importDocument();
-        open.wait(_recoveryTimeout);
-        if (open.importedDocument()) {
-            open.importedDocument()->setModified(true); // warn that the file is unsaved, if closing
-            open.importedDocument()->setFileName("");
-
-            // ToDo: Only one place of mainwin creation / initialization
-            CAMainWin* mainWin = new CAMainWin();
-
-            // Init dialogs etc.
-            CACanorus::initCommonGUI(mainWin->uiSaveDialog,
-                mainWin->uiOpenDialog,
-                mainWin->uiExportDialog,
-                mainWin->uiImportDialog);
-
-            documents.append(tr("- Document %1 last modified on %2.").arg(open.importedDocument()->title()).arg(open.importedDocument()->dateLastModified().toString()) + "\n");
-            mainWin->openDocument(open.importedDocument());
-            mainWin->show();
-        }
+        CACanorusMLImport* open = new CACanorusMLImport();
+        open->setStreamFromFile(CASettings::defaultSettingsPath() + "/recovery" + QString::number(i));
+        connect(open, SIGNAL(importDone(int)), this, SLOT(onRecoveryImportDone(int)));
+        _pendingRecoveries << open;
+        open->importDocument();
+    }
+
+    if (_pendingRecoveries.isEmpty()) {
+        finishRecovery();
+    } else {
+        // Don't wait forever for broken recovery files
+        QTimer::singleShot(_recoveryTimeout, this, SLOT(finishRecovery()));
+    }
+}
+
+/*!
+	Called in the GUI thread when a recovery file has been read.
+	Opens the recovered document in a new main window.
+*/
+void CAAutoRecovery::onRecoveryImportDone(int)
+{
+    CACanorusMLImport* open = static_cast<CACanorusMLImport*>(sender());
+    if (!_pendingRecoveries.removeOne(open)) {
+        return; // already timed out
+    }
+
+    open->wait(); // importDone() is emitted just before the thread returns
+    if (open->importedDocument()) {
+        open->importedDocument()->setModified(true); // warn that the file is unsaved, if closing
+        open->importedDocument()->setFileName("");
+
+        // ToDo: Only one place of mainwin creation / initialization
+        CAMainWin* mainWin = new CAMainWin();
+
+        // Init dialogs etc.
+        CACanorus::initCommonGUI(mainWin->uiSaveDialog,
+            mainWin->uiOpenDialog,
+            mainWin->uiExportDialog,
+            mainWin->uiImportDialog);
+
+        _recoveredDocuments.append(tr("- Document %1 last modified on %2.").arg(open->importedDocument()->title()).arg(open->importedDocument()->dateLastModified().toString()) + "\n");
+        mainWin->openDocument(open->importedDocument());
+        mainWin->show();
+    }
+    open->deleteLater();
+
+    if (_pendingRecoveries.isEmpty()) {
+        finishRecovery();
+    }
+}
+
+/*!
+	Removes the recovery files and shows the recovery message once all the recovery
+	files are opened or the recovery timeout has passed. Emits recoveryFinished() at the end,
+	when there is at least one main window.
+*/
+void CAAutoRecovery::finishRecovery()
+{
+    if (!_recoveryInProgress) {
+        return;
+    }
+    _recoveryInProgress = false;
+
+    // Abandon imports which didn't finish in time, they delete themselves when done
+    for (int i = 0; i < _pendingRecoveries.size(); i++) {
+        disconnect(_pendingRecoveries[i], SIGNAL(importDone(int)), this, SLOT(onRecoveryImportDone(int)));
+        connect(_pendingRecoveries[i], SIGNAL(finished()), _pendingRecoveries[i], SLOT(deleteLater()));
     }
+    _pendingRecoveries.clear();
 
     cleanupRecovery();
 
+    if (CACanorus::mainWinList().isEmpty()) {
+        // main() skipped the default main window while the recovery was pending
+        CAMainWin* mainWin = new CAMainWin();
+        CACanorus::initCommonGUI(mainWin->uiSaveDialog,
+            mainWin->uiOpenDialog,
+            mainWin->uiExportDialog,
+            mainWin->uiImportDialog);
+        mainWin->newDocument();
+        mainWin->show();
+    }
+
+    QString documents = _recoveredDocuments;
+    _recoveredDocuments.clear();
     if (!documents.isEmpty()) {
         if (_saveAfterRecoveryTimer)
             delete _saveAfterRecoveryTimer;
@@ -157,4 +222,6 @@ void CAAutoRecovery::openRecovery()
 The following documents were successfully recovered:\n%1")
                 .arg(documents));
     }
+
+    emit recoveryFinished();
 }
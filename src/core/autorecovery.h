@@ -8,9 +8,11 @@
 #ifndef AUTOSAVE_H_
 #define AUTOSAVE_H_
 
+#include <QList>
 #include <QObject>
 
 class QTimer;
+class CACanorusMLImport;
 
 class CAAutoRecovery : public QObject {
     Q_OBJECT
@@ -20,15 +22,27 @@ public:
     ~CAAutoRecovery();
     void updateTimer();
     void openRecovery();
+    inline bool recoveryPending() { return !_pendingRecoveries.isEmpty(); }
+
+signals:
+    void recoveryFinished();
 
 public slots:
     void cleanupRecovery();
     void saveRecovery();
 
+private slots:
+    void onRecoveryImportDone(int);
+    void finishRecovery();
+
 private:
     QTimer* _autoRecoveryTimer;
     QTimer* _saveAfterRecoveryTimer;
 
+    QList<CACanorusMLImport*> _pendingRecoveries;
+    QString _recoveredDocuments;
+    bool _recoveryInProgress;
+
     const int _recoveryTimeout = 120000;
 };
 
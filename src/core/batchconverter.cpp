@@ -0,0 +1,321 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QObject>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "core/batchconverter.h"
+#include "core/converter.h"
+
+/*!
+	\class CABatchConverter
+	\brief Converts many files concurrently
+
+	Each job converts a single file using CAConverter in a worker thread of a private thread
+	pool. Every worker holds at most one document, so the memory used is bounded by the
+	number of threads and not by the number of files.
+
+	run() blocks until all the jobs are finished or timed out. Every finished job and the
+	summary with the throughput are written as a single line JSON object to the report
+	device, if set:
+
+	\code
+	  {"input":"a.musicxml","msecs":41,"output":"a.ly","status":"converted"}
+	  {"error":"Timed out after 60000 ms.","input":"b.musicxml","msecs":60000,"output":"b.ly","status":"timeout"}
+	  {"converted":1,"failed":0,"files":2,"filesPerSecond":0.03,"msecs":60012,"summary":true,"threads":8,"timedOut":1}
+	\endcode
+
+	A worker can't be stopped safely in the middle of the import, so a timed out job is
+	only reported as failed and its result is discarded when it finishes. Another worker
+	thread is started instead, so the timed out job doesn't slow down the rest of the batch,
+	but at most threadCount() of them, so the hanging jobs can't spawn an unbounded number
+	of threads.
+
+	Each job writes a hidden temporary file next to the output first, which is renamed to the
+	output only if the job is still running, ie. not timed out. A failed, timed out or
+	abandoned conversion never leaves a partial output behind, see removeTemporaryFiles().
+
+	\sa CAConverter
+*/
+
+struct CABatchConverter::CABatchState {
+    QMutex mutex;
+    QWaitCondition jobFinished;
+    QVector<CABatchJob> jobs;
+    QVector<qint64> started; // start time of the running jobs on the clock
+    QElapsedTimer clock;
+};
+
+/*!
+	Returns the name of the temporary file the \a output is written to by the worker.
+	The extension is kept, as it determines the export filter.
+*/
+static QString temporaryFileName(const QString& output)
+{
+    QFileInfo info(output);
+    return info.dir().filePath("." + info.completeBaseName() + ".part." + info.suffix());
+}
+
+namespace {
+class CABatchConverterTask : public QRunnable {
+public:
+    CABatchConverterTask(std::shared_ptr<CABatchConverter::CABatchState> state, int job)
+        : _state(state)
+        , _job(job)
+    {
+    }
+
+    void run()
+    {
+        QString input, output;
+        {
+            QMutexLocker locker(&_state->mutex);
+            CABatchConverter::CABatchJob& job = _state->jobs[_job];
+            job.status = CABatchConverter::Running;
+            _state->started[_job] = _state->clock.elapsed();
+            input = job.input;
+            output = job.output;
+        }
+
+        CAConverter converter;
+        QString temporary = temporaryFileName(output);
+        bool converted = converter.convert(input, temporary);
+
+        QMutexLocker locker(&_state->mutex);
+        CABatchConverter::CABatchJob& job = _state->jobs[_job];
+        if (job.status == CABatchConverter::Running) { // result of the timed out job is discarded
+            QString errorString = converter.errorString();
+            if (converted) {
+                QFile::remove(output);
+                if (!QFile::rename(temporary, output)) {
+                    converted = false;
+                    errorString = QObject::tr("Could not write %1.").arg(output);
+                }
+            }
+            job.status = (converted ? CABatchConverter::Converted : CABatchConverter::Failed);
+            job.errorString = errorString;
+            job.msecs = _state->clock.elapsed() - _state->started[_job];
+        }
+        QFile::remove(temporary);
+        _state->jobFinished.wakeAll();
+    }
+
+private:
+    std::shared_ptr<CABatchConverter::CABatchState> _state;
+    int _job;
+};
+}
+
+CABatchConverter::CABatchConverter()
+    : _threadCount(QThread::idealThreadCount())
+    , _timeout(0)
+    , _report(nullptr)
+    , _pool(nullptr)
+{
+}
+
+/*!
+	Destroys the batch converter. The thread pool is left behind, if there are workers
+	of the timed out jobs still running.
+*/
+CABatchConverter::~CABatchConverter()
+{
+    if (isFinished()) {
+        delete _pool;
+    }
+}
+
+/*!
+	Adds a job converting the \a input file to the \a output file.
+	The format is determined by the file name extensions, see CAConverter.
+*/
+void CABatchConverter::addJob(const QString& input, const QString& output)
+{
+    _jobs << CABatchJob { input, output, Queued, QString(), 0 };
+}
+
+/*!
+	Returns True, if no worker thread is running.
+*/
+bool CABatchConverter::isFinished()
+{
+    return !_pool || _pool->activeThreadCount() == 0;
+}
+
+/*!
+	Runs all the jobs using threadCount() worker threads and waits until they are finished.
+	Jobs running longer than timeout() milliseconds are reported as timed out. Timeout 0
+	disables the limit.
+
+	Returns the number of jobs which failed or timed out.
+*/
+int CABatchConverter::run()
+{
+    if (!isFinished()) {
+        return _jobs.size(); // workers of the previous run are still busy
+    }
+    delete _pool;
+    _pool = new QThreadPool();
+    _pool->setMaxThreadCount(qMax(_threadCount, 1));
+
+    _state = std::make_shared<CABatchState>();
+    _state->jobs = _jobs.toVector();
+    _state->started.fill(0, _jobs.size());
+    _state->clock.start();
+
+    for (int i = 0; i < _jobs.size(); i++) {
+        _state->jobs[i].status = Queued;
+        _pool->start(new CABatchConverterTask(_state, i));
+    }
+
+    QVector<bool> reported(_jobs.size(), false);
+    int remaining = _jobs.size();
+    int replacements = 0; // workers started instead of the timed out ones
+    _state->mutex.lock();
+    while (remaining) {
+        QList<CABatchJob> finished;
+        qint64 now = _state->clock.elapsed();
+        for (int i = 0; i < _jobs.size(); i++) {
+            CABatchJob& job = _state->jobs[i];
+            if (reported[i]) {
+                continue;
+            }
+            if (job.status == Running && _timeout > 0 && now - _state->started[i] > _timeout) {
+                job.status = TimedOut;
+                job.errorString = QObject::tr("Timed out after %1 ms.").arg(_timeout);
+                job.msecs = now - _state->started[i];
+                if (replacements < qMax(_threadCount, 1)) {
+                    _pool->setMaxThreadCount(_pool->maxThreadCount() + 1); // replaces the blocked worker
+                    replacements++;
+                }
+            }
+            if (job.status == Converted || job.status == Failed || job.status == TimedOut) {
+                reported[i] = true;
+                finished << job;
+                remaining--;
+            }
+        }
+
+        _state->mutex.unlock();
+        for (const CABatchJob& job : finished) {
+            writeReport(job);
+        }
+        _state->mutex.lock();
+
+        if (remaining) {
+            _state->jobFinished.wait(&_state->mutex, 100);
+        }
+    }
+    _jobs = _state->jobs.toList();
+    _state->mutex.unlock();
+
+    writeSummary(_state->clock.elapsed());
+
+    int failed = 0;
+    for (const CABatchJob& job : _jobs) {
+        if (job.status != Converted) {
+            failed++;
+        }
+    }
+    return failed;
+}
+
+/*!
+	Removes the temporary files of the jobs whose workers are still running. Called before
+	the workers of the timed out jobs are abandoned, eg. when the process exits without
+	waiting for them.
+*/
+void CABatchConverter::removeTemporaryFiles()
+{
+    if (!_state) {
+        return;
+    }
+
+    QMutexLocker locker(&_state->mutex);
+    for (const CABatchJob& job : _state->jobs) {
+        if (job.status == TimedOut || job.status == Running) {
+            QFile::remove(temporaryFileName(job.output));
+        }
+    }
+}
+
+/*!
+	Writes the result of the finished \a job to the report device as a JSON line.
+*/
+void CABatchConverter::writeReport(const CABatchJob& job)
+{
+    if (!_report) {
+        return;
+    }
+
+    QJsonObject o;
+    o["input"] = job.input;
+    o["output"] = job.output;
+    o["msecs"] = job.msecs;
+    switch (job.status) {
+    case Converted:
+        o["status"] = QString("converted");
+        break;
+    case TimedOut:
+        o["status"] = QString("timeout");
+        break;
+    default:
+        o["status"] = QString("failed");
+        break;
+    }
+    if (job.status != Converted) {
+        o["error"] = job.errorString;
+    }
+
+    _report->write(QJsonDocument(o).toJson(QJsonDocument::Compact) + "\n");
+}
+
+/*!
+	Writes the number of converted and failed jobs and the throughput of the whole
+	batch which took \a msecs milliseconds to the report device as a JSON line.
+*/
+void CABatchConverter::writeSummary(qint64 msecs)
+{
+    if (!_report) {
+        return;
+    }
+
+    int converted = 0, failed = 0, timedOut = 0;
+    for (const CABatchJob& job : _jobs) {
+        if (job.status == Converted) {
+            converted++;
+        } else if (job.status == TimedOut) {
+            timedOut++;
+        } else {
+            failed++;
+        }
+    }
+
+    QJsonObject o;
+    o["summary"] = true;
+    o["files"] = _jobs.size();
+    o["converted"] = converted;
+    o["failed"] = failed;
+    o["timedOut"] = timedOut;
+    o["threads"] = qMax(_threadCount, 1);
+    o["msecs"] = msecs;
+    o["filesPerSecond"] = msecs ? _jobs.size() * 1000.0 / msecs : 0.0;
+
+    _report->write(QJsonDocument(o).toJson(QJsonDocument::Compact) + "\n");
+}
@@ -0,0 +1,68 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef BATCHCONVERTER_H_
+#define BATCHCONVERTER_H_
+
+#include <QList>
+#include <QString>
+
+#include <memory>
+
+class QIODevice;
+class QThreadPool;
+
+class CABatchConverter {
+public:
+    enum CABatchJobStatus {
+        Queued,
+        Running,
+        Converted,
+        Failed,
+        TimedOut
+    };
+
+    struct CABatchJob {
+        QString input;
+        QString output;
+        CABatchJobStatus status;
+        QString errorString;
+        qint64 msecs; // duration of the conversion
+    };
+
+    CABatchConverter();
+    ~CABatchConverter();
+
+    void addJob(const QString& input, const QString& output);
+    inline const QList<CABatchJob>& jobs() { return _jobs; }
+
+    inline int threadCount() { return _threadCount; }
+    inline void setThreadCount(int count) { _threadCount = count; }
+    inline int timeout() { return _timeout; }
+    inline void setTimeout(int msecs) { _timeout = msecs; }
+    inline QIODevice* report() { return _report; }
+    inline void setReport(QIODevice* report) { _report = report; }
+
+    int run();
+    bool isFinished();
+    void removeTemporaryFiles();
+
+    struct CABatchState; // shared by the worker threads
+
+private:
+    void writeReport(const CABatchJob& job);
+    void writeSummary(qint64 msecs);
+
+    QList<CABatchJob> _jobs;
+    int _threadCount;
+    int _timeout;
+    QIODevice* _report;
+    QThreadPool* _pool;
+    std::shared_ptr<CABatchState> _state; // shared with the workers, which may outlive the timed out run
+};
+
+#endif /* BATCHCONVERTER_H_ */
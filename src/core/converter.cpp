@@ -0,0 +1,272 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QObject>
+#include <QThread>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include "core/batchconverter.h"
+#include "core/converter.h"
+#include "core/fileformats.h"
+#include "export/export.h"
+#include "import/import.h"
+#include "score/document.h"
+#include "score/sheet.h"
+
+/*!
+	\class CAConverter
+	\brief Headless conversion between file formats
+
+	This class imports a file and exports it to another format without any user interface.
+	The import and export filters are chosen by the file name extensions, see
+	CAFileFormats::getTypeFromFileName(). Both run in the calling thread.
+
+	It is used by the --convert command line switch which runs on QCoreApplication and
+	skips the initialization of the playback, scripting, recovery, help, fonts and the main
+	window:
+
+	\code
+	  canorus --convert score.musicxml score.can
+	  canorus --convert --to ly --output-dir out/ --jobs 0 --report - a.musicxml b.musicxml
+	\endcode
+
+	CAConverter only uses the state of its own import and export filters, so several
+	converters can run in parallel threads, see CABatchConverter.
+
+	Formats which only store a single sheet (LilyPond, MusicXML, MIDI, WAV, PDF, SVG) export the
+	first sheet of the document, the same as the export in the main window.
+
+	\sa CAFileFormats, CAImport, CAExport
+*/
+
+CAConverter::CAConverter()
+{
+}
+
+CAConverter::~CAConverter()
+{
+}
+
+/*!
+	Converts the \a input file to the \a output file.
+	Returns True on success. Otherwise the error is stored to errorString().
+*/
+bool CAConverter::convert(const QString& input, const QString& output)
+{
+    std::unique_ptr<CADocument> document(importDocument(input));
+    if (!document) {
+        return false;
+    }
+
+    return exportDocument(document.get(), output);
+}
+
+/*!
+	Imports the document from the given \a fileName.
+	Returns the new document owned by the caller or Null, if the import failed.
+*/
+CADocument* CAConverter::importDocument(const QString& fileName)
+{
+    CAFileFormats::CAFileFormatType type = CAFileFormats::getTypeFromFileName(fileName);
+    std::unique_ptr<CAImport> import(CAFileFormats::createImport(type));
+    if (!import) {
+        _errorString = QObject::tr("Unknown input format of %1.").arg(fileName);
+        return nullptr;
+    }
+    if (!QFileInfo(fileName).exists()) {
+        _errorString = QObject::tr("File %1 does not exist.").arg(fileName);
+        return nullptr;
+    }
+
+    import->setStreamFromFile(fileName);
+    import->setSynchronous(true);
+    if (type == CAFileFormats::LilyPond) {
+        import->importSheet();
+    } else {
+        import->importDocument();
+    }
+
+    if (import->status() != 0) {
+        _errorString = QObject::tr("Error %1 while importing: %2").arg(import->status()).arg(import->readableStatus());
+        if (import->importedDocument()) {
+            delete import->importedDocument();
+        } else {
+            delete import->importedSheet();
+        }
+        return nullptr;
+    }
+
+    CADocument* document = import->importedDocument();
+    if (!document && import->importedSheet()) {
+        document = new CADocument();
+        import->importedSheet()->setDocument(document);
+        document->addSheet(import->importedSheet());
+    }
+    if (!document) {
+        _errorString = QObject::tr("Nothing was imported from %1.").arg(fileName);
+    }
+
+    return document;
+}
+
+/*!
+	Exports the given \a document to the file \a fileName.
+	Returns True on success. Otherwise the error is stored to errorString().
+*/
+bool CAConverter::exportDocument(CADocument* document, const QString& fileName)
+{
+    CAFileFormats::CAFileFormatType type = CAFileFormats::getTypeFromFileName(fileName);
+    std::unique_ptr<CAExport> exp(CAFileFormats::createExport(type));
+    if (!exp) {
+        _errorString = QObject::tr("Unknown output format of %1.").arg(fileName);
+        return false;
+    }
+
+    exp->setStreamToFile(fileName);
+    if (CAFileFormats::isDocumentFormat(type)) {
+        exp->exportDocument(document, false);
+    } else {
+        if (document->sheetList().isEmpty()) {
+            _errorString = QObject::tr("The document has no sheets to export.");
+            return false;
+        }
+        exp->exportSheet(document->sheetList().first());
+        exp->wait();
+    }
+
+    if (exp->status() != 0) {
+        _errorString = QObject::tr("Error %1 while exporting: %2").arg(exp->status()).arg(exp->readableStatus());
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+	Returns True, if the command line arguments request the headless conversion.
+	This is checked before any application object is created.
+*/
+bool CAConverter::isConvertCommand(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        if (QString(argv[i]) == "--convert") {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+	Runs the conversion requested by the command line \a arguments and returns the
+	process exit code: 0 if all the files were converted, 1 if any conversion failed
+	and 2 on invalid arguments.
+
+	The files are converted concurrently by CABatchConverter using --jobs threads
+	(one by default). --timeout limits the conversion of each file to the given number of
+	seconds and --report writes the results as JSON lines to the given file or to the
+	standard output for "-".
+*/
+int CAConverter::exec(const QStringList& arguments)
+{
+    QStringList inputs;
+    QString format;
+    QString outputDir;
+    QString reportFileName;
+    int jobs = 1;
+    int timeout = 0;
+    bool valid = true;
+    for (int i = 1; i < arguments.size() && valid; i++) {
+        if (arguments[i] == "--convert") {
+            continue;
+        } else if (arguments[i] == "--to" && i + 1 < arguments.size()) {
+            format = arguments[++i];
+        } else if (arguments[i] == "--output-dir" && i + 1 < arguments.size()) {
+            outputDir = arguments[++i];
+        } else if (arguments[i] == "--jobs" && i + 1 < arguments.size()) {
+            jobs = arguments[++i].toInt(&valid);
+            if (jobs == 0) {
+                jobs = QThread::idealThreadCount();
+            }
+        } else if (arguments[i] == "--timeout" && i + 1 < arguments.size()) {
+            timeout = arguments[++i].toInt(&valid);
+        } else if (arguments[i] == "--report" && i + 1 < arguments.size()) {
+            reportFileName = arguments[++i];
+        } else if (arguments[i].startsWith('-')) {
+            valid = false;
+        } else {
+            inputs << arguments[i];
+        }
+    }
+
+    QStringList outputs;
+    if (format.isEmpty() && inputs.size() == 2 && outputDir.isEmpty()) {
+        outputs << inputs.takeLast();
+    } else if (!format.isEmpty()) {
+        if (!outputDir.isEmpty()) {
+            QDir().mkpath(outputDir);
+        }
+        for (const QString& input : inputs) {
+            QFileInfo info(input);
+            outputs << QDir(outputDir.isEmpty() ? info.path() : outputDir).filePath(info.completeBaseName() + "." + format);
+        }
+    }
+
+    if (!valid || jobs < 0 || timeout < 0 || inputs.isEmpty() || inputs.size() != outputs.size()) {
+        std::cerr << "Usage: canorus --convert [<options>] <input> <output>" << std::endl
+                  << "       canorus --convert --to <extension> [--output-dir <directory>] [<options>] <input>..." << std::endl
+                  << "Options:" << std::endl
+                  << "  --jobs <n>          number of files converted at the same time, 0 for the number of cores" << std::endl
+                  << "  --timeout <s>       fail the conversion of a file after the given number of seconds" << std::endl
+                  << "  --report <file>     write the results as JSON lines to the file or to the standard output for -" << std::endl;
+        return 2;
+    }
+
+    QFile report;
+    if (reportFileName == "-") {
+        report.open(stdout, QIODevice::WriteOnly | QIODevice::Unbuffered);
+    } else if (!reportFileName.isEmpty()) {
+        report.setFileName(reportFileName);
+        if (!report.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::cerr << qPrintable(reportFileName) << ": " << qPrintable(report.errorString()) << std::endl;
+            return 2;
+        }
+    }
+
+    CABatchConverter batch;
+    for (int i = 0; i < inputs.size(); i++) {
+        batch.addJob(inputs[i], outputs[i]);
+    }
+    batch.setThreadCount(jobs);
+    batch.setTimeout(timeout * 1000);
+    batch.setReport(report.isOpen() ? &report : nullptr);
+    int failed = batch.run();
+
+    for (const CABatchConverter::CABatchJob& job : batch.jobs()) {
+        if (job.status != CABatchConverter::Converted) {
+            std::cerr << qPrintable(job.input) << ": " << qPrintable(job.errorString) << std::endl;
+        }
+    }
+
+    int exitCode = failed ? 1 : 0;
+    if (!batch.isFinished()) {
+        // workers of the timed out jobs can't be stopped, don't wait for them
+        batch.removeTemporaryFiles();
+        report.close();
+        std::cerr.flush();
+        std::_Exit(exitCode);
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,34 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef CONVERTER_H_
+#define CONVERTER_H_
+
+#include <QString>
+#include <QStringList>
+
+class CADocument;
+
+class CAConverter {
+public:
+    CAConverter();
+    ~CAConverter();
+
+    bool convert(const QString& input, const QString& output);
+    CADocument* importDocument(const QString& fileName);
+    bool exportDocument(CADocument* document, const QString& fileName);
+
+    inline const QString& errorString() { return _errorString; }
+
+    static bool isConvertCommand(int argc, char* argv[]);
+    static int exec(const QStringList& arguments);
+
+private:
+    QString _errorString;
+};
+
+#endif /* CONVERTER_H_ */
@@ -47,6 +47,15 @@ CAFile::~CAFile()
         delete file();
 }
 
+/*!
+	Stops the operation in progress, called when the user cancels it.
+	The default implementation exits the event loop of the thread.
+*/
+void CAFile::cancel()
+{
+    exit();
+}
+
 /*!
 	Creates and sets the stream from the file named \a filename.
 	Stream is Read-only.
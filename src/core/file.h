@@ -11,6 +11,8 @@
 #include <QFile>
 #include <QThread>
 
+#include <atomic>
+
 class QTextStream;
 
 class CAFile : public QThread {
@@ -21,6 +23,7 @@ public:
     inline int status() { return _status; }
     inline int progress() { return _progress; }
     virtual const QString readableStatus() = 0;
+    virtual void cancel();
     void setStreamFromFile(const QString filename);
     void setStreamToFile(const QString filename);
     void setStreamFromDevice(QIODevice* device);
@@ -40,8 +43,8 @@ protected:
     inline void setFile(QFile* file) { _file = file; }
 
 private:
-    int _status; // status number
-    int _progress; // percentage of the work already done
+    std::atomic<int> _status; // status number, polled from the GUI thread
+    std::atomic<int> _progress; // percentage of the work already done
     QTextStream* _stream;
     QFile* _file;
     bool _deleteStream; // whether to delete stream when destroyed.
@@ -6,8 +6,24 @@
 */
 
 #include "core/fileformats.h"
+#include <QFileInfo>
 #include <QObject>
 
+#include "export/canexport.h"
+#include "export/canorusmlexport.h"
+#include "export/lilypondexport.h"
+#include "export/midiexport.h"
+#include "export/musicxmlexport.h"
+#include "export/pdfexport.h"
+#include "export/svgexport.h"
+#include "export/wavexport.h"
+#include "import/canimport.h"
+#include "import/canorusmlimport.h"
+#include "import/lilypondimport.h"
+#include "import/midiimport.h"
+#include "import/musicxmlimport.h"
+#include "import/mxlimport.h"
+
 /*!
 	\class CAFileFormats
 	\brief File formats supported by Canorus
@@ -28,6 +44,7 @@ const QString CAFileFormats::CAPELLA_FILTER = QObject::tr("Capella document (*.c
 const QString CAFileFormats::MIDI_FILTER = QObject::tr("Midi file (*.mid *.midi)");
 const QString CAFileFormats::PDF_FILTER = QObject::tr("PDF file (*.pdf)");
 const QString CAFileFormats::SVG_FILTER = QObject::tr("SVG file (*.svg)");
+const QString CAFileFormats::WAV_FILTER = QObject::tr("WAV audio (*.wav)");
 
 /*!
 	Converts the file format enumeration to filter as string.
@@ -49,6 +66,8 @@ const QString CAFileFormats::getFilter(const CAFileFormats::CAFileFormatType t)
         return PDF_FILTER;
     case SVG:
         return SVG_FILTER;
+    case Wav:
+        return WAV_FILTER;
     default:
         return CANORUSML_FILTER;
     }
@@ -73,6 +92,101 @@ CAFileFormats::CAFileFormatType CAFileFormats::getType(const QString t)
         return PDF;
     else if (t == SVG_FILTER)
         return SVG;
+    else if (t == WAV_FILTER)
+        return Wav;
     else
         return CanorusML;
 }
+
+/*!
+	Returns the file format of the given \a fileName guessed from its extension or
+	Undefined, if the extension is unknown. This is used when no file dialog filter is
+	available, eg. in the headless conversion.
+*/
+CAFileFormats::CAFileFormatType CAFileFormats::getTypeFromFileName(const QString fileName)
+{
+    QString suffix = QFileInfo(fileName).suffix().toLower();
+    if (suffix == "xml")
+        return CanorusML;
+    else if (suffix == "can")
+        return Can;
+    else if (suffix == "ly")
+        return LilyPond;
+    else if (suffix == "musicxml")
+        return MusicXML;
+    else if (suffix == "mxl")
+        return MXL;
+    else if (suffix == "mid" || suffix == "midi")
+        return Midi;
+    else if (suffix == "pdf")
+        return PDF;
+    else if (suffix == "svg")
+        return SVG;
+    else if (suffix == "wav")
+        return Wav;
+    else
+        return Undefined;
+}
+
+/*!
+	Returns True, if the whole document is stored in the given format \a t.
+	Other formats only store the first sheet, as the export in the main window does.
+*/
+bool CAFileFormats::isDocumentFormat(const CAFileFormats::CAFileFormatType t)
+{
+    return t == CanorusML || t == Can;
+}
+
+/*!
+	Creates a new import filter for the given format \a t or returns Null, if the format
+	can't be imported. The caller owns the returned object.
+
+	LilyPond import only supports importing a single sheet, see CAImport::importSheet().
+*/
+CAImport* CAFileFormats::createImport(const CAFileFormats::CAFileFormatType t)
+{
+    switch (t) {
+    case CanorusML:
+        return new CACanorusMLImport();
+    case Can:
+        return new CACanImport();
+    case LilyPond:
+        return new CALilyPondImport();
+    case MusicXML:
+        return new CAMusicXmlImport();
+    case MXL:
+        return new CAMXLImport();
+    case Midi:
+        return new CAMidiImport();
+    default:
+        return nullptr;
+    }
+}
+
+/*!
+	Creates a new export filter for the given format \a t or returns Null, if the format
+	can't be exported. The caller owns the returned object.
+*/
+CAExport* CAFileFormats::createExport(const CAFileFormats::CAFileFormatType t)
+{
+    switch (t) {
+    case CanorusML:
+        return new CACanorusMLExport();
+    case Can:
+        return new CACanExport();
+    case LilyPond:
+        return new CALilyPondExport();
+    case MusicXML:
+        return new CAMusicXmlExport();
+    case Midi:
+        return new CAMidiExport();
+    case PDF:
+        return new CAPDFExport();
+    case SVG:
+        return new CASVGExport();
+    case Wav:
+        return new CAWavExport();
+    default:
+        return nullptr;
+    }
+}
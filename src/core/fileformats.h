@@ -10,9 +10,13 @@
 
 #include <QString>
 
+class CAImport;
+class CAExport;
+
 class CAFileFormats {
 public:
     enum CAFileFormatType {
+        Undefined = 0,
         CanorusML = 1,
         Can = 2,
         LilyPond = 3,
@@ -28,7 +32,8 @@ public:
         Capella = 12,
         Midi = 13,
         PDF = 14,
-        SVG = 15
+        SVG = 15,
+        Wav = 17
     };
 
     static const QString LILYPOND_FILTER;
@@ -44,9 +49,15 @@ public:
     static const QString MIDI_FILTER;
     static const QString PDF_FILTER;
     static const QString SVG_FILTER;
+    static const QString WAV_FILTER;
 
     static const QString getFilter(const CAFileFormatType);
     static CAFileFormatType getType(const QString);
+    static CAFileFormatType getTypeFromFileName(const QString fileName);
+    static bool isDocumentFormat(const CAFileFormatType);
+
+    static CAImport* createImport(const CAFileFormatType);
+    static CAExport* createExport(const CAFileFormatType);
 };
 
 #endif /*FILEFORMATS_H_*/
@@ -7,7 +7,7 @@
 
 #include "core/midirecorder.h"
 #include "export/midiexport.h"
-#include "interface/mididevice.h"
+#include "score/playablelength.h"
 #include "score/resource.h"
 
 /*!
@@ -23,28 +23,42 @@
 	   all the midi events into the given resource file.
 	3) Call stop() when recording is done. Class will write the midi data and
 	   close the stream.
+
+	The midi device passes the input events to recordEvent() directly in its input thread
+	together with their monotonic timestamps. They are stored in a lock-free queue and
+	written to the file each timer tick, after converting their times to the music time
+	using the tempo (see setTempo(), the main window sets the tempo at the beginning of the
+	current sheet, 120 bpm is used otherwise). The recording timing doesn't depend on the GUI thread
+	and isn't quantized to the timer tick.
  */
 CAMidiRecorder::CAMidiRecorder(std::shared_ptr<CAResource> r, CAMidiDevice* d)
     : QObject()
     , _resource(r)
+    , _device(d)
     , _midiExport(nullptr)
+    , _timer(nullptr)
     , _curTime(0)
+    , _usecPerQuarter(500000)
+    , _offset(0)
+    , _paused(false)
+    , _pauseStart(0)
 {
-    _paused = false;
-
-    connect(d, SIGNAL(midiInEvent(QVector<unsigned char>)), this, SLOT(onMidiInEvent(QVector<unsigned char>)));
 }
 
 CAMidiRecorder::~CAMidiRecorder()
 {
+    if (_device && _device->recorder() == this) {
+        _device->setRecorder(nullptr);
+    }
     disconnect();
 }
 
 void CAMidiRecorder::timerTimeout()
 {
     if (!_paused) {
-        _curTime += 10;
+        _curTime = static_cast<unsigned int>((CAMidiDevice::monotonicTime() - _offset) / 1000);
     }
+    flushEvents();
 }
 
 void CAMidiRecorder::startRecording(int)
@@ -61,14 +75,24 @@ void CAMidiRecorder::startRecording(int)
         _timer->start();
         // the default time signature is a 4 quarters measure
         _midiExport->sendMetaEvent(0, CAMidiDevice::Meta_Timesig, 4, 4, 0);
-        _midiExport->sendMetaEvent(0, CAMidiDevice::Meta_Tempo, 120, 0, 0);
+        _midiExport->sendMetaEvent(0, CAMidiDevice::Meta_Tempo, static_cast<char>(qMin(tempo(), 127)), 0, _usecPerQuarter);
+
+        CAMidiMessage e;
+        while (_events.pop(e)) {
+        } // drop the events of the previous recording
+        _offset = CAMidiDevice::monotonicTime();
+        _device->setRecorder(this);
     } else {
+        _offset += CAMidiDevice::monotonicTime() - _pauseStart;
         _paused = false;
     }
 }
 
 void CAMidiRecorder::stopRecording()
 {
+    _device->setRecorder(nullptr); // waits for the event being recorded in the input thread
+    _paused = false;
+    flushEvents();
     _midiExport->writeFile();
 
     delete _midiExport;
@@ -79,12 +103,44 @@ void CAMidiRecorder::stopRecording()
 
 void CAMidiRecorder::pauseRecording()
 {
+    _pauseStart = CAMidiDevice::monotonicTime();
     _paused = true;
+    flushEvents();
 }
 
-void CAMidiRecorder::onMidiInEvent(QVector<unsigned char> messages)
+/*!
+	Stores the received midi \a message. Called by the midi device in its input thread.
+*/
+void CAMidiRecorder::recordEvent(const CAMidiMessage& message)
 {
-    if (_midiExport && !_paused) {
-        _midiExport->send(messages, _curTime / 2); // needs division somewhere else ...
+    if (_paused) {
+        return;
     }
+
+    CAMidiMessage e = message;
+    e.time -= _offset;
+    _events.push(e); // the queue is emptied each timer tick, it only gets full if the GUI is stuck
+}
+
+/*!
+	Writes the recorded events to the midi file.
+*/
+void CAMidiRecorder::flushEvents()
+{
+    CAMidiMessage e;
+    while (_events.pop(e)) {
+        if (!_midiExport) {
+            continue;
+        }
+
+        _midiExport->send(e.data, e.size, musicTime(e.time));
+    }
+}
+
+/*!
+	Converts the time in microseconds from the start of the recording to the music time.
+*/
+int CAMidiRecorder::musicTime(qint64 usec)
+{
+    return static_cast<int>(qMax<qint64>(usec, 0) * CAPlayableLength::playableLengthToTimeLength(CAPlayableLength::Quarter) / _usecPerQuarter);
 }
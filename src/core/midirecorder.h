@@ -11,11 +11,14 @@
 #include <QTimer>
 #include <QVector>
 
+#include <atomic>
 #include <memory>
 
+#include "core/ringbuffer.h"
+#include "interface/mididevice.h"
+
 class CAMidiExport;
 class CAResource;
-class CAMidiDevice;
 
 class CAMidiRecorder : public QObject {
 #ifndef SWIG
@@ -31,19 +34,33 @@ public:
 
     const unsigned int& curTime() const { return _curTime; }
 
+    inline int tempo() { return qRound(60000000.0 / _usecPerQuarter); }
+    inline void setTempo(int bpm) { _usecPerQuarter = 60000000 / qMax(bpm, 1); }
+
 #ifndef SWIG
+    void recordEvent(const CAMidiMessage& message);
+
 private slots:
     void timerTimeout();
-    void onMidiInEvent(QVector<unsigned char> messages);
 #endif
 
 private:
+    void flushEvents();
+    int musicTime(qint64 usec);
+
     std::shared_ptr<CAResource> _resource;
+    CAMidiDevice* _device;
     CAMidiExport* _midiExport;
     QTimer* _timer;
     unsigned int _curTime;
+    int _usecPerQuarter;
 
-    bool _paused;
+#ifndef SWIG
+    CARingBuffer<CAMidiMessage, 4096> _events; // events recorded in the input thread, time relative to the start
+    std::atomic<qint64> _offset; // monotonic time of the start of the recording plus the paused time
+    std::atomic<bool> _paused;
+#endif
+    qint64 _pauseStart;
 };
 
 #endif /* MIDIRECORDER_H_ */
@@ -0,0 +1,87 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef RINGBUFFER_H_
+#define RINGBUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+
+/*!
+	\class CARingBuffer
+	\brief Lock-free single-producer single-consumer queue
+
+	Fixed size ring buffer for passing values from one thread to another without
+	locking. Only one thread may call push() and only one (other) thread may call pop().
+	Neither of them ever blocks: push() returns False if the buffer is full and pop()
+	returns False if it is empty.
+
+	\a Size must be a power of two. The buffer holds at most Size-1 values.
+
+	\code
+	  CARingBuffer<int, 1024> queue;
+	  queue.push(42); // producer thread
+
+	  int value;
+	  while (queue.pop(value)) { // consumer thread
+	      ...
+	  }
+	\endcode
+*/
+template <typename T, std::size_t Size>
+class CARingBuffer {
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Size of CARingBuffer must be a power of two");
+
+public:
+    CARingBuffer()
+        : _head(0)
+        , _tail(0)
+    {
+    }
+
+    /*!
+		Appends the \a value to the queue. Returns False, if the queue is full.
+		Only called by the producer thread.
+	*/
+    bool push(const T& value)
+    {
+        std::size_t head = _head.load(std::memory_order_relaxed);
+        std::size_t next = (head + 1) & (Size - 1);
+        if (next == _tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        _buffer[head] = value;
+        _head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /*!
+		Takes the oldest value from the queue and stores it to \a value.
+		Returns False, if the queue is empty. Only called by the consumer thread.
+	*/
+    bool pop(T& value)
+    {
+        std::size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = _buffer[tail];
+        _tail.store((tail + 1) & (Size - 1), std::memory_order_release);
+        return true;
+    }
+
+    inline bool isEmpty() const { return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_acquire); }
+
+private:
+    T _buffer[Size];
+    alignas(64) std::atomic<std::size_t> _head; // written by the producer
+    alignas(64) std::atomic<std::size_t> _tail; // written by the consumer
+};
+
+#endif /* RINGBUFFER_H_ */
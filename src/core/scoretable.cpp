@@ -0,0 +1,99 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include "core/scoretable.h"
+
+#include "score/midinote.h"
+#include "score/note.h"
+#include "score/sheet.h"
+#include "score/staff.h"
+#include "score/voice.h"
+
+/*!
+	\class CAScoreTable
+	\brief Read-only columnar view of the music elements of a voice or a sheet
+
+	Analysis scripts usually need only a few numbers of every element. Wrapping each element
+	into a script object is much slower than the analysis itself, so this class writes the
+	numbers of all the elements into a single array of 32-bit integers instead. The array is
+	stored by columns (see CAColumn), each column has rowCount() values:
+
+	- TimeStart, TimeLength: CAMusElement::timeStart() and CAMusElement::timeLength()
+	- MusElementType: CAMusElement::musElementType()
+	- MidiPitch: the MIDI pitch of the notes and MIDI notes, -1 for other elements
+	- Accidentals: the accidentals of the notes, 0 for other elements
+	- VoiceIndex: index of the voice in CASheet::voiceList(), 0 if the voice is not in a sheet
+
+	A row is written for every element of CAVoice::musElementList() in the voice order,
+	including the shared signs and barlines.
+
+	In Python, CanorusPython.scoreTable() returns the columns as memoryviews of the array
+	which can be passed to numpy.asarray() without copying.
+*/
+
+/*!
+	Creates a table of the elements of the given \a voice.
+*/
+CAScoreTable::CAScoreTable(CAVoice* voice)
+{
+    _voiceList << voice;
+    _sheet = (voice->staff() ? voice->staff()->sheet() : nullptr);
+    _rowCount = voice->musElementList().size();
+}
+
+/*!
+	Creates a table of the elements of all the voices in the given \a sheet.
+*/
+CAScoreTable::CAScoreTable(CASheet* sheet)
+{
+    _voiceList = sheet->voiceList();
+    _sheet = sheet;
+    _rowCount = 0;
+    for (CAVoice* voice : _voiceList) {
+        _rowCount += voice->musElementList().size();
+    }
+}
+
+/*!
+	Writes the columns to \a data, which needs space for ColumnCount * rowCount() values.
+*/
+void CAScoreTable::write(qint32* data)
+{
+    qint32* timeStart = data + TimeStart * _rowCount;
+    qint32* timeLength = data + TimeLength * _rowCount;
+    qint32* type = data + MusElementType * _rowCount;
+    qint32* midiPitch = data + MidiPitch * _rowCount;
+    qint32* accs = data + Accidentals * _rowCount;
+    qint32* voiceIndex = data + VoiceIndex * _rowCount;
+
+    QList<CAVoice*> sheetVoices = (_sheet ? _sheet->voiceList() : QList<CAVoice*>()); // generated list
+    int row = 0;
+    for (CAVoice* voice : _voiceList) {
+        int index = qMax(sheetVoices.indexOf(voice), 0);
+        for (CAMusElement* elt : voice->musElementList()) {
+            timeStart[row] = elt->timeStart();
+            timeLength[row] = elt->timeLength();
+            type[row] = elt->musElementType();
+            switch (elt->musElementType()) {
+            case CAMusElement::Note:
+                midiPitch[row] = static_cast<CANote*>(elt)->midiPitch();
+                accs[row] = static_cast<CANote*>(elt)->diatonicPitch().accs();
+                break;
+            case CAMusElement::MidiNote:
+                midiPitch[row] = static_cast<CAMidiNote*>(elt)->midiPitch();
+                accs[row] = 0;
+                break;
+            default:
+                midiPitch[row] = -1;
+                accs[row] = 0;
+                break;
+            }
+            voiceIndex[row] = index;
+            row++;
+        }
+    }
+}
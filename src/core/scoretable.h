@@ -0,0 +1,41 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef SCORETABLE_H_
+#define SCORETABLE_H_
+
+#include <QList>
+#include <QtGlobal>
+
+class CASheet;
+class CAVoice;
+
+class CAScoreTable {
+public:
+    enum CAColumn {
+        TimeStart = 0,
+        TimeLength,
+        MusElementType,
+        MidiPitch,
+        Accidentals,
+        VoiceIndex,
+        ColumnCount
+    };
+
+    CAScoreTable(CAVoice* voice);
+    CAScoreTable(CASheet* sheet);
+
+    inline int rowCount() { return _rowCount; }
+    void write(qint32* data);
+
+private:
+    QList<CAVoice*> _voiceList;
+    CASheet* _sheet; // sheet used for the voice indices, if any
+    int _rowCount;
+};
+
+#endif /* SCORETABLE_H_ */
@@ -7,6 +7,7 @@
 
 #include <QDebug>
 
+#include "control/typesetctl.h"
 #include "core/settings.h"
 #ifndef SWIGCPP
 #include "canorus.h"
@@ -46,15 +47,10 @@ const int CASettings::DEFAULT_MIDI_IN_PORT = -1;
 const int CASettings::DEFAULT_MIDI_OUT_PORT = -1;
 const int CASettings::DEFAULT_MIDI_IN_NUM_DEVICES = 0;
 const int CASettings::DEFAULT_MIDI_OUT_NUM_DEVICES = 0;
+const bool CASettings::DEFAULT_MIDI_IN_STEP_INPUT = false;
 
 const CATypesetter::CATypesetterType CASettings::DEFAULT_TYPESETTER = CATypesetter::LilyPond;
-#ifdef Q_OS_WIN
-const QString CASettings::DEFAULT_TYPESETTER_LOCATION = "LilyPond/usr/bin/lilypond.exe";
-#elif defined(Q_OS_MAC)
-const QString CASettings::DEFAULT_TYPESETTER_LOCATION = "/Applications/LilyPond.app/Contents/Resources/bin/lilypond";
-#else
-const QString CASettings::DEFAULT_TYPESETTER_LOCATION = "lilypond";
-#endif
+const QString CASettings::DEFAULT_TYPESETTER_LOCATION = CATypesetCtl::defaultTypesetterLocation();
 const bool CASettings::DEFAULT_USE_SYSTEM_TYPESETTER = true;
 const QString CASettings::DEFAULT_PDF_VIEWER_LOCATION = "";
 const bool CASettings::DEFAULT_USE_SYSTEM_PDF_VIEWER = true;
@@ -162,6 +158,7 @@ void CASettings::writeSettings()
     setValue("rtmidi/midiinport", midiInPort());
     setValue("rtmidi/midioutnumdevices", midiOutNumDevices());
     setValue("rtmidi/midiinnumdevices", midiInNumDevices());
+    setValue("rtmidi/midiinstepinput", midiInStepInput());
 
     setValue("printing/typesetter", typesetter());
     setValue("printing/typesetterlocation", typesetterLocation());
@@ -292,34 +289,22 @@ int CASettings::readSettings()
         setShowRuler(DEFAULT_SHOW_RULER);
 
 #endif
-    // Playback settings
-    if (contains("rtmidi/midiinport")
-#ifndef SWIGCPP
-        && value("rtmidi/midiinport").toInt() < CACanorus::midiDevice()->getInputPorts().count()
-#endif
-    ) {
-        setMidiInPort(value("rtmidi/midiinport").toInt());
+    // Playback settings, checked against the MIDI devices later by checkMidiPorts()
+    if (contains("rtmidi/midiinport")) {
+        _midiInPort = value("rtmidi/midiinport").toInt(); // the port is opened in the background, see CACanorus::initSettings()
     } else {
-        setMidiInPort(DEFAULT_MIDI_IN_PORT);
+        _midiInPort = DEFAULT_MIDI_IN_PORT;
         settingsPage = -1;
     }
 
     if (contains("rtmidi/midiinnumdevices")) {
-#ifndef SWIGCPP
-        if (value("rtmidi/midiinnumdevices").toInt() != CACanorus::midiDevice()->getInputPorts().count())
-            settingsPage = -1;
-        setMidiInNumDevices(CACanorus::midiDevice()->getInputPorts().count());
-#endif
+        setMidiInNumDevices(value("rtmidi/midiinnumdevices").toInt());
     } else {
         setMidiInNumDevices(DEFAULT_MIDI_IN_NUM_DEVICES);
         settingsPage = -1;
     }
 
-    if (contains("rtmidi/midioutport")
-#ifndef SWIGCPP
-        && value("rtmidi/midioutport").toInt() < CACanorus::midiDevice()->getOutputPorts().count()
-#endif
-    ) {
+    if (contains("rtmidi/midioutport")) {
         setMidiOutPort(value("rtmidi/midioutport").toInt());
     } else {
         setMidiOutPort(DEFAULT_MIDI_OUT_PORT);
@@ -327,16 +312,17 @@ int CASettings::readSettings()
     }
 
     if (contains("rtmidi/midioutnumdevices")) {
-#ifndef SWIGCPP
-        if (value("rtmidi/midioutnumdevices").toInt() != CACanorus::midiDevice()->getOutputPorts().count())
-            settingsPage = -1;
-        setMidiOutNumDevices(CACanorus::midiDevice()->getOutputPorts().count());
-#endif
+        setMidiOutNumDevices(value("rtmidi/midioutnumdevices").toInt());
     } else {
         setMidiOutNumDevices(DEFAULT_MIDI_OUT_NUM_DEVICES);
         settingsPage = -1;
     }
 
+    if (contains("rtmidi/midiinstepinput"))
+        setMidiInStepInput(value("rtmidi/midiinstepinput").toBool());
+    else
+        setMidiInStepInput(DEFAULT_MIDI_IN_STEP_INPUT);
+
     // Printing settings
     if (contains("printing/typesetter"))
         setTypesetter(static_cast<CATypesetter::CATypesetterType>(value("printing/typesetter").toInt()));
@@ -372,6 +358,45 @@ int CASettings::readSettings()
     return settingsPage;
 }
 
+/*!
+	Checks the MIDI ports read by readSettings() against the number of the available
+	\a inputPorts and \a outputPorts. Invalid ports are reset to the defaults.
+
+	Enumerating the MIDI ports takes a while, so this is called once the ports were
+	enumerated in the background on startup.
+
+	Returns -1, if the MIDI devices changed and the playback settings should be shown,
+	otherwise 0.
+*/
+int CASettings::checkMidiPorts(int inputPorts, int outputPorts)
+{
+    int settingsPage = 0;
+
+    if (midiInPort() >= inputPorts) {
+        setMidiInPort(DEFAULT_MIDI_IN_PORT);
+        settingsPage = -1;
+    }
+
+    if (contains("rtmidi/midiinnumdevices")) {
+        if (value("rtmidi/midiinnumdevices").toInt() != inputPorts)
+            settingsPage = -1;
+        setMidiInNumDevices(inputPorts);
+    }
+
+    if (midiOutPort() >= outputPorts) {
+        setMidiOutPort(DEFAULT_MIDI_OUT_PORT);
+        settingsPage = -1;
+    }
+
+    if (contains("rtmidi/midioutnumdevices")) {
+        if (value("rtmidi/midioutnumdevices").toInt() != outputPorts)
+            settingsPage = -1;
+        setMidiOutNumDevices(outputPorts);
+    }
+
+    return settingsPage;
+}
+
 void CASettings::setMidiInPort(int in)
 {
     _midiInPort = in;
@@ -29,6 +29,7 @@ public:
     virtual ~CASettings();
 
     int readSettings();
+    int checkMidiPorts(int inputPorts, int outputPorts);
     void writeSettings();
 
     static const QString defaultSettingsPath();
@@ -125,6 +126,9 @@ public:
     inline int midiOutNumDevices() { return _midiOutNumDevices; }
     void setMidiOutNumDevices(int outNum) { _midiOutNumDevices = outNum; }
     static const int DEFAULT_MIDI_OUT_NUM_DEVICES;
+    inline bool midiInStepInput() { return _midiInStepInput; }
+    inline void setMidiInStepInput(bool s) { _midiInStepInput = s; }
+    static const bool DEFAULT_MIDI_IN_STEP_INPUT;
 
     ///////////////////////
     // Printing settings //
@@ -138,6 +142,7 @@ public:
     inline bool useSystemDefaultTypesetter() { return _useSystemDefaultTypesetter; }
     void setUseSystemDefaultTypesetter(bool s) { _useSystemDefaultTypesetter = s; }
     static const bool DEFAULT_USE_SYSTEM_TYPESETTER;
+    inline QString currentTypesetterLocation() { return useSystemDefaultTypesetter() ? DEFAULT_TYPESETTER_LOCATION : typesetterLocation(); }
     inline QString pdfViewerLocation() { return _pdfViewerLocation; }
     void setPdfViewerLocation(QString pl) { _pdfViewerLocation = pl; }
     static const QString DEFAULT_PDF_VIEWER_LOCATION;
@@ -217,6 +222,7 @@ private:
     int _midiInPort; // -1 disabled, 0+ port number
     int _midiOutNumDevices; // last number of MIDI out ports
     int _midiInNumDevices; // last number of MIDI in ports
+    bool _midiInStepInput; // MIDI keyboard notes are inserted in phrases with a single undo
 
     ///////////////////////
     // Printing settings //
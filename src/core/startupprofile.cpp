@@ -0,0 +1,70 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <cstdio>
+
+#include "core/startupprofile.h"
+
+/*!
+	\class CAStartupProfile
+	\brief Timing of the initialization steps
+
+	main() calls step() after each initialization step, which stores the time elapsed since
+	the previous step. When Canorus is run with --startup-profile, the breakdown is printed
+	to the standard error output once the first main window is shown:
+
+	\code
+	  $ canorus --startup-profile
+	  Startup profile:
+	     step ms   total ms
+	        21.4       21.4  QApplication
+	        ...
+	       185.0      262.7  First main window
+	\endcode
+*/
+
+QElapsedTimer CAStartupProfile::_timer;
+qint64 CAStartupProfile::_lastStep = 0;
+QList<QPair<QString, qint64> > CAStartupProfile::_steps;
+bool CAStartupProfile::_enabled = false;
+
+/*!
+	Starts the timer. Called at the beginning of main().
+*/
+void CAStartupProfile::start()
+{
+    _timer.start();
+    _lastStep = 0;
+    _steps.clear();
+}
+
+/*!
+	Stores the time of the step \a name, which ended now.
+*/
+void CAStartupProfile::step(const QString& name)
+{
+    qint64 now = _timer.nsecsElapsed();
+    _steps << qMakePair(name, now - _lastStep);
+    _lastStep = now;
+}
+
+/*!
+	Prints the steps, if enabled.
+*/
+void CAStartupProfile::print()
+{
+    if (!_enabled) {
+        return;
+    }
+
+    fprintf(stderr, "Startup profile:\n   step ms   total ms\n");
+    qint64 total = 0;
+    for (const QPair<QString, qint64>& s : _steps) {
+        total += s.second;
+        fprintf(stderr, "%10.1f %10.1f  %s\n", s.second / 1e6, total / 1e6, qPrintable(s.first));
+    }
+}
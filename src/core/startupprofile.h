@@ -0,0 +1,32 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef STARTUPPROFILE_H_
+#define STARTUPPROFILE_H_
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+class CAStartupProfile {
+public:
+    static void start();
+    static void step(const QString& name);
+    static void print();
+
+    inline static void setEnabled(bool enabled) { _enabled = enabled; }
+    inline static bool isEnabled() { return _enabled; }
+
+private:
+    static QElapsedTimer _timer;
+    static qint64 _lastStep; // time of the previous step in nanoseconds
+    static QList<QPair<QString, qint64> > _steps; // name and duration of each step in nanoseconds
+    static bool _enabled;
+};
+
+#endif /* STARTUPPROFILE_H_ */
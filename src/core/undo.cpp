@@ -35,6 +35,9 @@
 	   pass the current document to be saved for that action.
 	3) If the action was successful, commit the command by calling CAUndo::pushUndoCommand(). If not, do
 	   nothing - non-pushed commands will get deleted when createUndoCommand() will be issued the next time.
+	   Changes spanning several events (eg. the midi step input phrase) use createPendingUndoCommand()
+	   and pushPendingUndoCommand() instead. The pending command is finished and pushed before any
+	   other command is created, so it is never discarded.
 	4) For undo/redo, simply call CAUndo::undoStack()->undo().
 	5) When destroying the document, also destroy the undo stack (which also destroys all its commands) by
 	   calling CAUndo::deleteUndoStack(). This is not done automatically because CADocument is part of the
@@ -49,6 +52,7 @@
 CAUndo::CAUndo()
 {
     _undoCommand = nullptr;
+    _pendingCommand = nullptr;
 }
 
 CAUndo::~CAUndo()
@@ -97,6 +101,11 @@ void CAUndo::deleteUndoStack(CADocument* doc)
 {
     clearUndoCommand();
     QList<CAUndoCommand*>* stack = undoStack(doc);
+    if (_pendingCommand && _undoStack.value(_pendingCommand->getRedoDocument()) == stack) {
+        delete _pendingCommand;
+        _pendingCommand = nullptr;
+        _pendingFinish = nullptr;
+    }
     while (!stack->isEmpty()) {
         delete stack->first();
         stack->takeFirst();
@@ -118,13 +127,25 @@ void CAUndo::deleteUndoStack(CADocument* doc)
 */
 void CAUndo::pushUndoCommand()
 {
-    if (!_undoCommand || !_undoCommand->getRedoDocument() || !_undoCommand->getUndoDocument())
+    CAUndoCommand* c = _undoCommand;
+    _undoCommand = nullptr;
+    pushUndoCommand(c);
+}
+
+/*!
+	Puts the undo command \a c on the stack of its document. Deletes the command, if it isn't complete.
+*/
+void CAUndo::pushUndoCommand(CAUndoCommand* c)
+{
+    if (!c || !c->getRedoDocument() || !c->getUndoDocument()) {
+        delete c;
         return;
+    }
 
-    CADocument* d = _undoCommand->getRedoDocument();
+    CADocument* d = c->getRedoDocument();
 
-    _undoCommand->getUndoDocument()->setModified(true);
-    _undoCommand->getRedoDocument()->setModified(true);
+    c->getUndoDocument()->setModified(true);
+    c->getRedoDocument()->setModified(true);
 
     QList<CAUndoCommand*>* s = _undoStack[d];
     CAUndoCommand* prevUndoCommand = (undoIndex(d) < s->size() && undoIndex(d) >= 0 ? s->at(undoIndex(d)) : nullptr);
@@ -137,14 +158,13 @@ void CAUndo::pushUndoCommand()
     }
 
     if (prevUndoCommand) {
-        if (_undoCommand->getRedoDocument() && prevUndoCommand->getRedoDocument())
-            prevUndoCommand->setRedoDocument(_undoCommand->getUndoDocument());
+        if (c->getRedoDocument() && prevUndoCommand->getRedoDocument())
+            prevUndoCommand->setRedoDocument(c->getUndoDocument());
     }
 
-    s->append(_undoCommand); // push the command on stack
-    _undoStack[_undoCommand->getUndoDocument()] = s;
+    s->append(c); // push the command on stack
+    _undoStack[c->getUndoDocument()] = s;
     undoIndex(d) = _undoStack[d]->size() - 1;
-    _undoCommand = nullptr;
 }
 
 /*!
@@ -196,10 +216,55 @@ void CAUndo::clearUndoCommand()
 */
 void CAUndo::createUndoCommand(CADocument* d, QString text)
 {
+    finishPendingUndoCommand();
     clearUndoCommand();
     _undoCommand = new CAUndoCommand(d, text);
 }
 
+/*!
+	Creates an undo command of the document \a d for a change made by several events, eg. the notes
+	of a midi step input phrase. The command is kept aside until pushPendingUndoCommand() is called.
+	The \a finish function finishes the change and calls pushPendingUndoCommand(). It is called by
+	finishPendingUndoCommand(), when another undo command is created meanwhile. The previous
+	pending command is finished first. The command created by createUndoCommand(), if any, is
+	kept, so a batch of script changes doesn't discard the command of the action running it.
+*/
+void CAUndo::createPendingUndoCommand(CADocument* d, QString text, std::function<void()> finish)
+{
+    finishPendingUndoCommand();
+    _pendingCommand = new CAUndoCommand(d, text);
+    _pendingFinish = finish;
+}
+
+/*!
+	Puts the pending undo command on the stack. Does nothing if there is none.
+*/
+void CAUndo::pushPendingUndoCommand()
+{
+    CAUndoCommand* c = _pendingCommand;
+    _pendingCommand = nullptr;
+    _pendingFinish = nullptr;
+    pushUndoCommand(c);
+}
+
+/*!
+	Finishes the change of the pending undo command, if any, and pushes the command.
+	Call this before saving or closing the document.
+*/
+void CAUndo::finishPendingUndoCommand()
+{
+    if (!_pendingCommand) {
+        return;
+    }
+
+    std::function<void()> finish = _pendingFinish;
+    _pendingFinish = nullptr;
+    if (finish) {
+        finish();
+    }
+    pushPendingUndoCommand(); // in case the finish function didn't push it
+}
+
 /*!
     Replace the document pointer to an undo stack.
     This function is called when the document is rebuilt, e.g. when a CanorusML
@@ -207,6 +272,7 @@ void CAUndo::createUndoCommand(CADocument* d, QString text)
 */
 void CAUndo::replaceDocument(CADocument* oldDoc, CADocument* newDoc)
 {
+    finishPendingUndoCommand();
     clearUndoCommand();
     QList<CAUndoCommand*>* stack = _undoStack[oldDoc];
 
@@ -14,6 +14,8 @@ class CADocument;
 #include <QHash>
 #include <QList>
 
+#include <functional>
+
 class CAUndo {
 public:
     CAUndo();
@@ -31,6 +33,10 @@ public:
     void deleteUndoStack(CADocument* doc);
     void createUndoCommand(CADocument* d, QString text);
     void pushUndoCommand();
+    void createPendingUndoCommand(CADocument* d, QString text, std::function<void()> finish);
+    void pushPendingUndoCommand();
+    void finishPendingUndoCommand();
+    inline bool hasPendingUndoCommand() { return _pendingCommand; }
     CAUndoCommand* undoCommand(CADocument* d);
     CAUndoCommand* redoCommand(CADocument* d);
     void updateLastUndoCommand(CAUndoCommand* c);
@@ -39,7 +45,10 @@ public:
 
 private:
     void clearUndoCommand();
+    void pushUndoCommand(CAUndoCommand* c);
     CAUndoCommand* _undoCommand; // current undo command created to be put on the undo stack
+    CAUndoCommand* _pendingCommand; // long running undo command, eg. the step input phrase
+    std::function<void()> _pendingFinish; // finishes the long running change and pushes its command
 
     QHash<CADocument*, QList<CAUndoCommand*>*> _undoStack;
     QHash<QList<CAUndoCommand*>*, int> _undoIndex;
@@ -7,7 +7,12 @@
 
 #include <QFileInfo>
 #include <QRegExp>
+#include <QRunnable>
+#include <QSemaphore>
 #include <QTextStream>
+#include <QThreadPool>
+#include <algorithm>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <stdio.h>
@@ -15,7 +20,7 @@
 #include "export/midiexport.h"
 
 #include "interface/mididevice.h"
-#include "interface/playback.h"
+#include "interface/playbacktimeline.h"
 #include "score/document.h"
 #include "score/sheet.h"
 #include "score/staff.h"
@@ -48,6 +53,10 @@ CAMidiExport::CAMidiExport(QTextStream* out)
     _midiDeviceType = MidiExportDevice;
     setRealTime(false);
     _trackTime = 0;
+    _conductorTime = 0;
+    _track = -1;
+    _timeStart = 0;
+    _timeEnd = -1;
 }
 
 /*!
@@ -65,61 +74,79 @@ int CAMidiExport::timeIncrement(int time)
 
 void CAMidiExport::send(QVector<unsigned char> message, int time)
 {
-    if (message.size())
-        trackChunk.append(writeTime(timeIncrement(time)));
-    char q;
-    for (int i = 0; i < message.size(); i++) {
-        q = static_cast<char>(message[i]);
-        trackChunk.append(q);
-    }
-    for (int i = 0; i < message.size(); i++) {
-        q = static_cast<char>(message[i]);
+    send(message.constData(), message.size(), time);
+}
+
+/*!
+	Writes the \a message of the given \a size at the given \a time. When exporting a sheet,
+	the message is buffered for the track set by setTrack() and encoded by writeFile().
+	Otherwise, eg. when recording, it is written to a single track.
+*/
+void CAMidiExport::send(const unsigned char* message, int size, int time)
+{
+    if (size <= 0)
+        return;
+
+    if (!voiceTrack.isEmpty()) {
+        if (_track != -1) {
+            CAMidiTrackEvent e;
+            e.time = time;
+            e.size = static_cast<unsigned char>(qMin(size, 3));
+            std::copy(message, message + e.size, e.data);
+            trackEvents[_track] << e;
+        }
+        return;
     }
+
+    trackChunk.append(writeTime(timeIncrement(time)));
+    trackChunk.append(reinterpret_cast<const char*>(message), size);
 }
 
-void CAMidiExport::sendMetaEvent(int time, char event, char a, char b, int)
+/*!
+	Writes the tempo, time signature and key signature meta events to the conductor track.
+*/
+void CAMidiExport::sendMetaEvent(int time, char event, char a, char b, int c)
 {
     // We don't do a time check on time, and we compute
     // only the time increment when we really send an event out.
     QByteArray tc;
     if (event == CAMidiDevice::Meta_Keysig) {
-        tc.append(writeTime(timeIncrement(time)));
-        tc.append(static_cast<char>(CAMidiDevice::Midi_Ctl_Event));
-        tc.append(event);
-        tc.append(variableLengthValue(2));
         tc.append(a);
         tc.append(b);
-        trackChunk.append(tc);
     } else if (event == CAMidiDevice::Meta_Timesig) {
         char lbBeat = 0;
-        for (; lbBeat < 5; lbBeat++) { // natural logarithm, smallest is 128th
-            if (1 << lbBeat >= b)
+        for (; lbBeat < 7; lbBeat++) { // binary logarithm, smallest is 128th
+            if (1 << lbBeat >= static_cast<unsigned char>(b))
                 break;
         }
-        tc.append(writeTime(timeIncrement(time)));
-        tc.append(static_cast<char>(CAMidiDevice::Midi_Ctl_Event));
-        tc.append(event);
-        tc.append(variableLengthValue(4));
         tc.append(a);
         tc.append(lbBeat);
-        tc.append(18);
-        tc.append(8);
-        trackChunk.append(tc);
+        tc.append(static_cast<char>(24));
+        tc.append(static_cast<char>(8));
     } else if (event == CAMidiDevice::Meta_Tempo) {
-        int usPerQuarter = 60000000 / a;
-        tc.append(writeTime(timeIncrement(time)));
-        tc.append(static_cast<char>(CAMidiDevice::Midi_Ctl_Event));
-        tc.append(event);
-        tc.append(variableLengthValue(3));
-        char q;
-        q = char(usPerQuarter >> 16);
-        tc.append(q);
-        q = char(usPerQuarter >> 8);
-        tc.append(q);
-        q = char(usPerQuarter >> 0);
-        tc.append(q);
-        trackChunk.append(tc);
+        int usPerQuarter = (c > 0 ? c : 60000000 / qMax(static_cast<unsigned char>(a), static_cast<unsigned char>(1)));
+        tc.append(static_cast<char>(usPerQuarter >> 16));
+        tc.append(static_cast<char>(usPerQuarter >> 8));
+        tc.append(static_cast<char>(usPerQuarter));
+    } else {
+        return;
     }
+
+    conductorChunk.append(writeTime(qMax(time - _conductorTime, 0)));
+    conductorChunk.append(static_cast<char>(CAMidiDevice::Midi_Ctl_Event));
+    conductorChunk.append(event);
+    conductorChunk.append(variableLengthValue(tc.size()));
+    conductorChunk.append(tc);
+    _conductorTime = qMax(time, _conductorTime);
+}
+
+/*!
+	Maps the \a track of the following messages, the index of the voice in the exported
+	timeline, to the track of the midi file. The messages of the empty voices are dropped.
+*/
+void CAMidiExport::setTrack(int track)
+{
+    _track = (track >= 0 && track < voiceTrack.size() ? voiceTrack[track] : -1);
 }
 
 /// \todo: replace with enum midiCommands
@@ -174,29 +201,37 @@ QByteArray CAMidiExport::variableLengthValue(int value)
 }
 
 QByteArray CAMidiExport::writeTime(int time)
+{
+    QByteArray ba;
+    appendTime(ba, time);
+    return ba;
+}
+
+/*!
+	Appends the delta \a time as a variable length value to the \a chunk.
+*/
+void CAMidiExport::appendTime(QByteArray& chunk, int time)
 {
     char b;
     bool byteswritten = false;
-    QByteArray ba;
 
     b = (time >> 3 * 7) & 0x7f;
     if (b) {
-        ba.append(0x80 | b);
+        chunk.append(0x80 | b);
         byteswritten = true;
     }
     b = (time >> 2 * 7) & 0x7f;
     if (b || byteswritten) {
-        ba.append(0x80 | b);
+        chunk.append(0x80 | b);
         byteswritten = true;
     }
     b = (time >> 7) & 0x7f;
     if (b || byteswritten) {
-        ba.append(0x80 | b);
+        chunk.append(0x80 | b);
         byteswritten = true;
     }
     b = time & 0x7f;
-    ba.append(b);
-    return ba;
+    chunk.append(b);
 }
 
 QByteArray CAMidiExport::trackEnd(void)
@@ -222,8 +257,33 @@ QByteArray CAMidiExport::textEvent(int time, QString s)
     return tc;
 }
 
+namespace {
+class CAMidiTrackJob : public QRunnable {
+public:
+    CAMidiTrackJob(std::function<void()> job)
+        : _job(job)
+    {
+    }
+
+    void run() { _job(); }
+
+private:
+    std::function<void()> _job;
+};
+
+QByteArray metaMessage(unsigned char type, const QByteArray& data)
+{
+    QByteArray m;
+    m.append(static_cast<char>(MIDI_CTL_EVENT));
+    m.append(static_cast<char>(type));
+    m.append(static_cast<char>(data.size()));
+    m.append(data);
+    return m;
+}
+}
+
 /*!
-	Exports the current document to Lilypond syntax as a complete .ly file.
+	Exports the first sheet of the document to a midi file.
 */
 void CAMidiExport::exportDocumentImpl(CADocument* doc)
 {
@@ -232,99 +292,115 @@ void CAMidiExport::exportDocumentImpl(CADocument* doc)
         return;
     }
 
-    // In the header chunk we need to know the count of tracks.
-    // We export every non empty voice as separate track.
     // For now we export only the first sheet.
-    CASheet* sheet = doc->sheetList()[0];
+    exportSheetImpl(doc->sheetList()[0]);
+}
+
+/*!
+	Exports the given sheet to a Standard MIDI File of type 1.
+
+	The first track is the conductor track with the tempo, time signature and
+	key signature changes. Every non empty voice is then exported as a separate
+	track. The sheet is rendered by CAPlayback::render() from the snapshot of its
+	playback timeline, so only the voices changed since the last playback or export
+	are compiled. setTimeStart(), setTimeEnd() and setSelection() limit the exported
+	part of the sheet.
+*/
+void CAMidiExport::exportSheetImpl(CASheet* sheet)
+{
     setCurSheet(sheet);
     trackChunk.clear();
+    conductorChunk.clear();
+    _conductorTime = 0;
+    _trackTime = 0;
 
-    // Let's playback this sheet and dump that into a file,
-    // and for this we have our own midi driver.
-    CAPlayback* _playback = new CAPlayback(sheet, this);
-    _playback->run();
-
-    int count = 0;
-    for (int c = 0; c < doc->sheetList()[0]->contextList().size(); ++c) {
-        switch (sheet->contextList()[c]->contextType()) {
-        case CAContext::Staff: {
-            // exportStaffVoices( static_cast<CAStaff*>(sheet->contextList()[c]) );
-            CAStaff* staff = static_cast<CAStaff*>(sheet->contextList()[c]);
-            for (int v = 0; v < staff->voiceList().size(); ++v) {
-                setCurVoice(staff->voiceList()[v]);
-                count++;
-                //std::cout << "Hallo  " << c << " " << v << "\n" << std::endl;
-            }
-            break;
-        }
-        case CAContext::ChordNameContext:
-            break; // TODO
-        case CAContext::LyricsContext:
-        case CAContext::FunctionMarkContext:
-        case CAContext::FiguredBassContext:
-            break;
-        }
-    }
+    CAPlayback playback(sheet, this);
+    playback.setInitTimeStart(timeStart());
+    playback.setTimeEnd(timeEnd());
+    playback.setRenderSelection(selection());
+    prepareTracks(playback.timeline());
+    playback.render();
+    voiceTrack.clear();
+    _track = -1;
 
     writeFile();
 }
 
 /*!
-	Exports the current document to Lilypond syntax as a complete .ly file.
+	Creates a track with the name of the voice for every non empty voice of the \a timeline.
+	The messages sent afterwards by CAPlayback are buffered for the tracks set by setTrack().
 */
-void CAMidiExport::exportSheetImpl(CASheet* sheet)
+void CAMidiExport::prepareTracks(CAPlaybackTimeline* timeline)
 {
-    /*
-	if ( doc->sheetList().size() < 1 ) {
-		//TODO: no sheets, raise an error
-		return;
-	}
-
+    const QList<CAVoice*>& voices = timeline->voices();
+    voiceTrack.fill(-1, voices.size());
+    int tracks = 0;
+    for (int i = 0; i < voices.size(); i++) {
+        if (voices[i]->lastTimeEnd() > 0) {
+            voiceTrack[i] = tracks++;
+        }
+    }
 
-	// In the header chunk we need to know the count of tracks.
-	// We export every non empty voice as separate track.
-	// For now we export only the first sheet.
-	CASheet *sheet = doc->sheetList()[ 0 ];
-*/
-    setCurSheet(sheet);
-    trackChunk.clear();
+    trackChunks.fill(QByteArray(), tracks);
+    trackEvents.fill(QVector<CAMidiTrackEvent>(), tracks);
+    _track = -1;
 
-    // Let's playback this sheet and dump that into a file,
-    // and for this we have our own midi driver.
-    CAPlayback* _playback = new CAPlayback(sheet, this);
-    _playback->run();
-
-    int count = 0;
-    for (int c = 0; c < sheet->contextList().size(); ++c) {
-        switch (sheet->contextList()[c]->contextType()) {
-        case CAContext::Staff: {
-            // exportStaffVoices( static_cast<CAStaff*>(sheet->contextList()[c]) );
-            CAStaff* staff = static_cast<CAStaff*>(sheet->contextList()[c]);
-            for (int v = 0; v < staff->voiceList().size(); ++v) {
-                setCurVoice(staff->voiceList()[v]);
-                count++;
-                //std::cout << "Hallo  " << c << " " << v << "\n" << std::endl;
+    for (int i = 0; i < voices.size(); i++) {
+        if (voiceTrack[i] != -1) {
+            QString name = voices[i]->name().isEmpty() && voices[i]->staff() ? voices[i]->staff()->name() : voices[i]->name();
+            if (!name.isEmpty()) {
+                trackChunks[voiceTrack[i]].append(writeTime(0));
+                trackChunks[voiceTrack[i]].append(metaMessage(CAMidiDevice::Meta_SeqTrkName, name.toUtf8().left(127)));
             }
-            break;
-        }
-        case CAContext::LyricsContext:
-        case CAContext::FunctionMarkContext:
-        case CAContext::FiguredBassContext:
-        case CAContext::ChordNameContext:
-            break;
         }
     }
+}
 
-    writeFile();
+/*!
+	Appends the midi \a events of a single track with their delta times to the \a chunk.
+	Only reads the events and writes the chunk, so the tracks can be encoded concurrently.
+*/
+void CAMidiExport::encodeTrack(const QVector<CAMidiTrackEvent>& events, QByteArray& chunk)
+{
+    chunk.reserve(chunk.size() + events.size() * 5);
+    int time = 0;
+    for (const CAMidiTrackEvent& e : events) {
+        appendTime(chunk, e.time - time);
+        chunk.append(reinterpret_cast<const char*>(e.data), e.size);
+        time = e.time;
+    }
 }
 
+/*!
+	Writes the midi file header and all the tracks to the output stream.
+
+	The buffered events of the voice tracks are encoded first, each track in a separate
+	job of the global thread pool, as the tracks don't share any state. Only the encoding
+	is parallel: the events themselves are generated by a single CAPlayback::render() pass
+	in exportSheetImpl(), because the repeats, the dynamics and the tempo are resolved across
+	the voices. Besides the tracks of the voices, the events sent to this device by send()
+	without a track are written in a separate track.
+*/
 void CAMidiExport::writeFile()
 {
+    QSemaphore encoded;
+    for (int i = 0; i < trackEvents.size(); i++) {
+        QVector<CAMidiTrackEvent>* events = &trackEvents[i];
+        QByteArray* chunk = &trackChunks[i];
+        QThreadPool::globalInstance()->start(new CAMidiTrackJob([events, chunk, &encoded]() {
+            encodeTrack(*events, *chunk);
+            encoded.release();
+        }));
+    }
+    encoded.acquire(trackEvents.size()); // don't wait for the other jobs of the global pool
+    trackEvents.clear();
+
+    int tracks = 1 + trackChunks.size() + (trackChunk.isEmpty() ? 0 : 1);
 
     QByteArray headerChunk;
     headerChunk.append("MThd...."); // header and space for length
     headerChunk.append(word16(1)); // Midi-Format version
-    headerChunk.append(word16(2)); // number of tracks, a control track and a music track for a trying out ...
+    headerChunk.append(word16(static_cast<short>(tracks))); // number of tracks, the conductor track and a track for each voice
     /// \todo QByteArray does not support char values > 0x7f
     headerChunk.append(word16(static_cast<short>(CAPlayableLength::playableLengthToTimeLength(CAPlayableLength::Quarter)))); // time division ticks per quarter
     setChunkLength(&headerChunk);
@@ -334,17 +410,27 @@ void CAMidiExport::writeFile()
     controlTrackChunk.append("MTrk....");
     controlTrackChunk.append(textEvent(0, QString("Canorus Version ") + CANORUS_VERSION + " generated. "));
     controlTrackChunk.append(textEvent(0, "It's still a work in progress."));
+    controlTrackChunk.append(conductorChunk);
     controlTrackChunk.append(trackEnd());
     setChunkLength(&controlTrackChunk);
     streamQByteArray(controlTrackChunk);
 
-    // trackChunk is already filled with midi data,
-    // let's add chunk header, in reverse, ...
-    trackChunk.prepend("MTrk....");
-    // ... and add the tail:
-    trackChunk.append(trackEnd());
-    setChunkLength(&trackChunk);
-    streamQByteArray(trackChunk);
+    if (!trackChunk.isEmpty()) {
+        // trackChunk is already filled with midi data,
+        // let's add chunk header, in reverse, ...
+        trackChunk.prepend("MTrk....");
+        // ... and add the tail:
+        trackChunk.append(trackEnd());
+        setChunkLength(&trackChunk);
+        streamQByteArray(trackChunk);
+    }
+
+    for (int i = 0; i < trackChunks.size(); i++) {
+        trackChunks[i].prepend("MTrk....");
+        trackChunks[i].append(trackEnd());
+        setChunkLength(&trackChunks[i]);
+        streamQByteArray(trackChunks[i]);
+    }
 }
 
 void CAMidiExport::setChunkLength(QByteArray* x)
@@ -358,8 +444,7 @@ void CAMidiExport::setChunkLength(QByteArray* x)
 
 void CAMidiExport::streamQByteArray(QByteArray x)
 {
-    for (int i = 0; i < x.size(); i++) // here we pass binary data through QTextStream
-        out().device()->putChar(x[i]);
+    out().device()->write(x); // here we pass binary data through QTextStream
 
 #ifdef QT_DEBUG
     for (int i = 0; i < x.size(); i++) {
@@ -28,6 +28,8 @@
 #include "interface/mididevice.h"
 #include "interface/playback.h"
 
+class CAPlaybackTimeline;
+
 class CAMidiExport : public CAExport, public CAMidiDevice {
 public:
     CAMidiExport(QTextStream* out = 0);
@@ -45,9 +47,20 @@ public:
     void closeOutputPort() {}
     void closeInputPort() {}
     void send(QVector<unsigned char> message, int time);
+#ifndef SWIG
+    void send(const unsigned char* message, int size, int time);
+#endif
     void sendMetaEvent(int timeLength, char event, char a, char b, int c);
+    void setTrack(int track);
     void writeFile(); // direct access to the writing
 
+    inline int timeStart() { return _timeStart; }
+    inline void setTimeStart(int t) { _timeStart = t; }
+    inline int timeEnd() { return _timeEnd; }
+    inline void setTimeEnd(int t) { _timeEnd = t; }
+    inline const QList<CAMusElement*>& selection() { return _selection; }
+    inline void setSelection(const QList<CAMusElement*>& elts) { _selection = elts; }
+
     /*
 	///////////////////////////
 	// Polling export status //
@@ -56,15 +69,36 @@ public:
 */
 
 private:
-    QByteArray writeTime(int time);
+#ifndef SWIG
+    /*!
+		Midi message of a voice track waiting to be encoded.
+	*/
+    struct CAMidiTrackEvent {
+        int time;
+        unsigned char size;
+        unsigned char data[3];
+    };
+
+    static void encodeTrack(const QVector<CAMidiTrackEvent>& events, QByteArray& chunk);
+    QVector<QVector<CAMidiTrackEvent>> trackEvents; // events of each voice track, encoded by writeFile()
+#endif
+    void prepareTracks(CAPlaybackTimeline* timeline);
+    static void appendTime(QByteArray& chunk, int time);
+    static QByteArray writeTime(int time);
     void exportDocumentImpl(CADocument* doc);
     void exportSheetImpl(CASheet* sheet);
     int midiTrackCount;
-    QByteArray trackChunk; // for the time beeing we build one big track
+    QByteArray trackChunk; // events sent to the device by send() and sendMetaEvent()
     int timeIncrement(int time);
     int _trackTime; // which this is the time line for
-    QVector<QByteArray> trackChunks; // for the future
-    QVector<int> trackTimes;
+    QByteArray conductorChunk; // tempo, time and key signatures sent by sendMetaEvent()
+    int _conductorTime; // time of the last event in conductorChunk
+    QVector<QByteArray> trackChunks; // a track for each exported voice
+    QVector<int> voiceTrack; // track of each voice of the exported timeline, -1 for the empty voices
+    int _track; // track of the messages sent now, see setTrack()
+    int _timeStart;
+    int _timeEnd; // -1 for the end of the sheet
+    QList<CAMusElement*> _selection; // only these elements are exported, if set
     void streamQByteArray(QByteArray x); // streaming binary data to midi file, possibly with print for debugging
     QByteArray variableLengthValue(int value);
     QByteArray word16(short x);
@@ -9,10 +9,6 @@
 #include "export/pdfexport.h"
 #include "control/typesetctl.h"
 #include "export/lilypondexport.h"
-#ifndef SWIGCPP
-#include "canorus.h" // needed for settings()
-#endif
-#include "core/settings.h"
 
 /*!
 	\class CAPDFExport
@@ -24,6 +20,8 @@
 	\endcode
 
 	\a textStream is usually the file stream or the content of the score source view widget.
+
+	LilyPond is run from the system default location, unless set by setTypesetterLocation().
 */
 
 /*!
@@ -32,6 +30,7 @@
 */
 CAPDFExport::CAPDFExport(QTextStream* stream)
     : CAExport(stream)
+    , _typesetterLocation(CATypesetCtl::defaultTypesetterLocation())
 {
     _poTypesetCtl = nullptr;
 }
@@ -50,15 +49,14 @@ void CAPDFExport::startExport()
 {
     _poTypesetCtl = new CATypesetCtl();
     // For now we support only lilypond export
-#ifndef SWIGCPP
-    _poTypesetCtl->setTypesetter((CACanorus::settings()->useSystemDefaultTypesetter()) ? (CASettings::DEFAULT_TYPESETTER_LOCATION) : (CACanorus::settings()->typesetterLocation()));
-#else
-    _poTypesetCtl->setTypesetter(CASettings::DEFAULT_TYPESETTER_LOCATION);
-#endif
+    _poTypesetCtl->setTypesetter(_typesetterLocation);
     _poTypesetCtl->setExporter(new CALilyPondExport());
     // Put lilypond output to console, could be shown on a canorus console later
-    connect(_poTypesetCtl, SIGNAL(nextOutput(const QByteArray&)), this, SLOT(outputTypsetterOutput(const QByteArray&)));
-    connect(_poTypesetCtl, SIGNAL(typesetterFinished(int)), this, SLOT(pdfFinished(int)));
+    // The typesetter lives in the export thread and finishes inside waitForFinished() in
+    // runTypesetter(). Call the slots there, as the thread owning this object may have no
+    // event loop (eg. canorus --convert).
+    connect(_poTypesetCtl, SIGNAL(nextOutput(const QByteArray&)), this, SLOT(outputTypsetterOutput(const QByteArray&)), Qt::DirectConnection);
+    connect(_poTypesetCtl, SIGNAL(typesetterFinished(int)), this, SLOT(pdfFinished(int)), Qt::DirectConnection);
 }
 
 void CAPDFExport::finishExport()
@@ -125,7 +123,9 @@ void CAPDFExport::runTypesetter()
     // as we are not in the main thread wait until we are finished
     if (_poTypesetCtl->waitForFinished(-1) == false) {
         qWarning("PDFExport: Typesetter %s was not finished", "lilypond");
+        setStatus(-1);
     }
+    finishExport();
 }
 
 /*!
@@ -150,6 +150,7 @@ void CAPDFExport::pdfFinished(int iExitCode)
     {
         qCritical("PDFExport: Could not copy temporary file %s, error %s", qPrintable(oTempFile.fileName()),
             qPrintable(oTempFile.errorString()));
+        setStatus(-1);
         return;
     }
     emit pdfIsFinished(iExitCode);
@@ -168,7 +169,6 @@ void CAPDFExport::pdfFinished(int iExitCode)
             qPrintable(oTempFile.errorString()));
         oTempFile.unsetError();
     }
-    finishExport();
 }
 
 QString CAPDFExport::getTempFilePath()
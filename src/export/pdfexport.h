@@ -26,6 +26,8 @@ public:
     ~CAPDFExport();
 
     QString getTempFilePath();
+    inline const QString& typesetterLocation() { return _typesetterLocation; }
+    inline void setTypesetterLocation(const QString& location) { _typesetterLocation = location; }
 #ifndef SWIG
 signals:
     void pdfIsFinished(int iExitCode);
@@ -43,6 +45,7 @@ private:
 
 protected:
     CATypesetCtl* _poTypesetCtl;
+    QString _typesetterLocation;
 #endif
 };
 
@@ -9,10 +9,6 @@
 #include "export/svgexport.h"
 #include "control/typesetctl.h"
 #include "export/lilypondexport.h"
-#ifndef SWIGCPP
-#include "canorus.h" // needed for settings()
-#endif
-#include "core/settings.h"
 
 /*!
 	\class CASVGExport
@@ -24,6 +20,8 @@
 	\endcode
 
 	\a textStream is usually the file stream or the content of the score source view widget.
+
+	LilyPond is run from the system default location, unless set by setTypesetterLocation().
 */
 
 /*!
@@ -32,6 +30,7 @@
 */
 CASVGExport::CASVGExport(QTextStream* stream)
     : CAExport(stream)
+    , _typesetterLocation(CATypesetCtl::defaultTypesetterLocation())
 {
     _poTypesetCtl = nullptr;
 }
@@ -50,16 +49,15 @@ void CASVGExport::startExport()
 {
     _poTypesetCtl = new CATypesetCtl();
     // For now we support only lilypond export
-#ifndef SWIGCPP
-    _poTypesetCtl->setTypesetter((CACanorus::settings()->useSystemDefaultTypesetter()) ? (CASettings::DEFAULT_TYPESETTER_LOCATION) : (CACanorus::settings()->typesetterLocation()));
-#else
-    _poTypesetCtl->setTypesetter(CASettings::DEFAULT_TYPESETTER_LOCATION);
-#endif
+    _poTypesetCtl->setTypesetter(_typesetterLocation);
     _poTypesetCtl->setTSetOption("dbackend", "svg", false, false);
     _poTypesetCtl->setExporter(new CALilyPondExport());
     // Put lilypond output to console, could be shown on a canorus console later
-    connect(_poTypesetCtl, SIGNAL(nextOutput(const QByteArray&)), this, SLOT(outputTypsetterOutput(const QByteArray&)));
-    connect(_poTypesetCtl, SIGNAL(typesetterFinished(int)), this, SLOT(svgFinished(int)));
+    // The typesetter lives in the export thread and finishes inside waitForFinished() in
+    // runTypesetter(). Call the slots there, as the thread owning this object may have no
+    // event loop (eg. canorus --convert).
+    connect(_poTypesetCtl, SIGNAL(nextOutput(const QByteArray&)), this, SLOT(outputTypsetterOutput(const QByteArray&)), Qt::DirectConnection);
+    connect(_poTypesetCtl, SIGNAL(typesetterFinished(int)), this, SLOT(svgFinished(int)), Qt::DirectConnection);
 }
 
 void CASVGExport::finishExport()
@@ -127,7 +125,9 @@ void CASVGExport::runTypesetter()
     // as we are not in the main thread wait until we are finished
     if (_poTypesetCtl->waitForFinished(-1) == false) {
         qWarning("SVGExport: Typesetter %s was not finished", "lilypond");
+        setStatus(-1);
     }
+    finishExport();
 }
 
 /*!
@@ -152,6 +152,7 @@ void CASVGExport::svgFinished(int iExitCode)
     {
         qCritical("SVGExport: Could not copy temporary file %s, error %s", qPrintable(oTempFile.fileName()),
             qPrintable(oTempFile.errorString()));
+        setStatus(-1);
         return;
     }
     emit svgIsFinished(iExitCode);
@@ -170,7 +171,6 @@ void CASVGExport::svgFinished(int iExitCode)
             qPrintable(oTempFile.errorString()));
         oTempFile.unsetError();
     }
-    finishExport();
 }
 
 QString CASVGExport::getTempFilePath()
@@ -26,6 +26,8 @@ public:
     ~CASVGExport();
 
     QString getTempFilePath();
+    inline const QString& typesetterLocation() { return _typesetterLocation; }
+    inline void setTypesetterLocation(const QString& location) { _typesetterLocation = location; }
 
 #ifndef SWIG
 signals:
@@ -44,6 +46,7 @@ private:
 
 protected:
     CATypesetCtl* _poTypesetCtl;
+    QString _typesetterLocation;
 #endif
 };
 
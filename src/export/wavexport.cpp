@@ -0,0 +1,86 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QIODevice>
+#include <QTextStream>
+
+#include "export/wavexport.h"
+#include "interface/playback.h"
+#include "interface/synthmididevice.h"
+#include "score/document.h"
+#include "score/sheet.h"
+
+/*!
+	\class CAWavExport
+	\brief WAV audio export filter
+
+	Renders the sheet offline with CAPlayback::render() into the built-in software
+	synthesizer CASynthMidiDevice and writes the 16-bit stereo PCM audio to the output
+	stream. The output is deterministic, so it is used for the audio proofs and by the
+	headless conversion:
+
+	\code
+	  canorus --convert score.musicxml score.wav
+	\endcode
+
+	\sa CASynthMidiDevice, CAMidiExport
+*/
+
+CAWavExport::CAWavExport(QTextStream* stream)
+    : CAExport(stream)
+    , _sampleRate(44100)
+{
+}
+
+CAWavExport::~CAWavExport()
+{
+}
+
+const QString CAWavExport::readableStatus()
+{
+    if (status() < 0 && !_errorString.isEmpty()) {
+        return _errorString;
+    }
+
+    return CAExport::readableStatus();
+}
+
+/*!
+	Exports the first sheet of the document.
+*/
+void CAWavExport::exportDocumentImpl(CADocument* doc)
+{
+    if (doc->sheetList().size() < 1) {
+        _errorString = tr("The document has no sheets to export");
+        setStatus(-1);
+        return;
+    }
+
+    exportSheetImpl(doc->sheetList()[0]);
+}
+
+/*!
+	Renders the given \a sheet into the output stream.
+*/
+void CAWavExport::exportSheetImpl(CASheet* sheet)
+{
+    out().flush();
+
+    CASynthMidiDevice synth(sampleRate());
+    synth.setDevice(out().device());
+    if (!synth.openOutputPort(CASynthMidiDevice::DevicePort)) {
+        _errorString = synth.errorString();
+        setStatus(-1);
+        return;
+    }
+
+    CAPlayback playback(sheet, &synth);
+    playback.render();
+    synth.closeOutputPort();
+
+    setStatus(0);
+}
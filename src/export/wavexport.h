@@ -0,0 +1,35 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef WAVEXPORT_H_
+#define WAVEXPORT_H_
+
+#include "export/export.h"
+
+class CAWavExport : public CAExport {
+#ifndef SWIG
+    Q_OBJECT
+#endif
+
+public:
+    CAWavExport(QTextStream* stream = nullptr);
+    ~CAWavExport();
+
+    inline int sampleRate() { return _sampleRate; }
+    inline void setSampleRate(int rate) { _sampleRate = rate; }
+
+    const QString readableStatus();
+
+private:
+    void exportDocumentImpl(CADocument* doc);
+    void exportSheetImpl(CASheet* sheet);
+
+    int _sampleRate;
+    QString _errorString;
+};
+
+#endif /* WAVEXPORT_H_ */
@@ -33,9 +33,13 @@ CADocument* CACanImport::importDocumentImpl()
     if (!arc->error()) {
         // Read the score
         CAIOPtr filePtr = arc->file("content.xml");
+        // Already running in the import thread, parse the content in-place
         CACanorusMLImport* content = new CACanorusMLImport(new QTextStream(&*filePtr));
+        content->setSynchronous(true);
+        // content is parsed in this thread, forward its notifications directly
+        connect(content, &CAImport::sheetImported, this, [this](CASheet* s) { reportSheetImported(s); }, Qt::DirectConnection);
+        connect(content, &CAImport::progressChanged, this, [this](int p) { updateProgress(p * 9 / 10); }, Qt::DirectConnection);
         content->importDocument();
-        content->wait();
         CADocument* doc = content->importedDocument();
         delete content;
 
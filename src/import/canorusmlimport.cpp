@@ -573,10 +573,12 @@ bool CACanorusMLImport::endElement(const QString&, const QString&, const QString
 
         _lcMap.clear();
         _syllableMap.clear();
+        reportSheetImported(_curSheet);
         _curSheet = nullptr;
     } else if (qName == "staff") {
         // CAStaff
         _curContext = nullptr;
+        updateProgress();
     } else if (qName == "voice") {
         // CAVoice
         _curVoice = nullptr;
@@ -6,6 +6,8 @@
 */
 
 #include "import/import.h"
+#include "score/sheet.h"
+#include <QIODevice>
 #include <QTextStream>
 
 /*!
@@ -48,6 +50,16 @@
 	\endcode
 	
 	\note Both stream and string can be used both in Canorus and scripting. The example is only for illustration.
+
+	Instead of waiting for the thread, GUI code should connect to importDone() and keep the
+	event loop running. While a whole document is being imported, sheetImported() is emitted
+	with a copy of each sheet as soon as the filter has finished reading it and progressChanged() is
+	emitted whenever progress() changes, so the main window can report the progress while the
+	user keeps working.
+
+	If the import is already running in a worker thread (eg. a nested CanorusML import inside
+	CACanImport), call setSynchronous(true) before starting it. The filter is then executed
+	in the calling thread instead of spawning and waiting for a new one.
 */
 
 CAImport::CAImport(QTextStream* stream)
@@ -62,6 +74,8 @@ CAImport::CAImport(QTextStream* stream)
     setImportedVoice(nullptr);
     setImportedLyricsContext(nullptr);
     setImportedFunctionMarkContext(nullptr);
+    setSynchronous(false);
+    _sheetsImported = 0;
     _fileName.clear();
 }
 
@@ -77,10 +91,13 @@ CAImport::CAImport(const QString stream)
     setImportedVoice(nullptr);
     setImportedLyricsContext(nullptr);
     setImportedFunctionMarkContext(nullptr);
+    setSynchronous(false);
+    _sheetsImported = 0;
 }
 
 CAImport::~CAImport()
 {
+    qDeleteAll(_sheetPreviews);
     if (stream() && stream()->string()) {
         delete stream()->string();
     }
@@ -88,7 +105,7 @@ CAImport::~CAImport()
 
 /*!
 	Extends CAFile::setStreamFromFile by storing the filename in a public variable
-	for use in the pmidi midi file parser.
+	for use in the midi file reader.
 */
 void CAImport::setStreamFromFile(const QString filename)
 {
@@ -158,55 +175,118 @@ void CAImport::run()
         }
     }
 
+    updateProgress(100);
     emit importDone(status());
 }
 
-void CAImport::importDocument()
+/*!
+	Starts importing the given \a part either in a new thread or, if synchronous() is set,
+	in the calling thread.
+*/
+void CAImport::startImport(CAImportPart part)
 {
-    setImportPart(Document);
+    setImportPart(part);
     setStatus(1); // process started
-    start();
+    updateProgress(0);
+    _sheetsImported = 0;
+
+    if (synchronous()) {
+        run();
+    } else {
+        start();
+    }
+}
+
+void CAImport::importDocument()
+{
+    startImport(Document);
 }
 
 void CAImport::importSheet()
 {
-    setImportPart(Sheet);
-    setStatus(1); // process started
-    start();
+    startImport(Sheet);
 }
 
 void CAImport::importStaff()
 {
-    setImportPart(Staff);
-    setStatus(1); // process started
-    start();
+    startImport(Staff);
 }
 
 void CAImport::importVoice()
 {
-    setImportPart(Voice);
-    setStatus(1); // process started
-    start();
+    startImport(Voice);
 }
 
 void CAImport::importLyricsContext()
 {
-    setImportPart(LyricsContext);
-    setStatus(1); // process started
-    start();
+    startImport(LyricsContext);
 }
 
 void CAImport::importFunctionMarkContext()
 {
-    setImportPart(FunctionMarkContext);
-    setStatus(1); // process started
-    start();
+    startImport(FunctionMarkContext);
+}
+
+/*!
+	Sets the progress to the percentage of the input stream device already consumed.
+	Filters reading the stream sequentially should call this regularly (eg. after each
+	parsed measure or element). Nothing happens, if the stream is not backed by a device
+	of known size (eg. when importing from a string).
+*/
+void CAImport::updateProgress()
+{
+    if (!stream() || !stream()->device() || stream()->device()->isSequential()) {
+        return;
+    }
+
+    qint64 size = stream()->device()->size();
+    if (size > 0) {
+        updateProgress(static_cast<int>(qBound<qint64>(0, stream()->device()->pos() * 100 / size, 100)));
+    }
+}
+
+/*!
+	Sets the progress to \a progress percent and emits progressChanged(), if the value changed.
+*/
+void CAImport::updateProgress(int progress)
+{
+    if (progress != CAFile::progress()) {
+        setProgress(progress);
+        emit progressChanged(progress);
+    }
+}
+
+/*!
+	Notifies the listeners that the given \a sheet has been completely read while importing
+	the whole document. Filters call this as soon as a sheet is final, ie. the filter doesn't
+	touch it anymore, so the GUI can show it before the rest of the document is parsed.
+
+	The import thread keeps modifying the document afterwards, so sheetImported() passes a
+	copy of the sheet made at this point instead. The copy has no parent document, is owned
+	by the import and is deleted together with it. Synchronous imports pass the \a sheet
+	itself, because their listeners run in the importing thread (see CACanImport).
+*/
+void CAImport::reportSheetImported(CASheet* sheet)
+{
+    if (importPart() == Document) {
+        _sheetsImported++;
+        if (synchronous()) {
+            emit sheetImported(sheet);
+        } else {
+            CASheet* preview = sheet->clone(nullptr);
+            _sheetPreviews << preview;
+            emit sheetImported(preview);
+        }
+    }
 }
 
 const QString CAImport::readableStatus()
 {
     switch (status()) {
     case 1:
+        if (_sheetsImported) {
+            return tr("Importing (%n sheet(s) read)", "", _sheetsImported);
+        }
         return tr("Importing");
     case 0:
         return tr("Ready");
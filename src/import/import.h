@@ -37,6 +37,9 @@ public:
     void importLyricsContext();
     void importFunctionMarkContext();
 
+    inline bool synchronous() { return _synchronous; }
+    inline void setSynchronous(bool s) { _synchronous = s; }
+
     inline CADocument* importedDocument() { return _importedDocument; }
     inline CASheet* importedSheet() { return _importedSheet; }
     inline CAStaff* importedStaff() { return _importedStaff; }
@@ -53,6 +56,7 @@ signals:
     void lyricsContextImported(CALyricsContext*);
     void functionMarkContextImported(CAFunctionMarkContext*);
 
+    void progressChanged(int progress);
     void importDone(int status);
 #endif
 
@@ -87,6 +91,10 @@ protected:
         setStatus(0);
         return nullptr;
     }
+    void updateProgress();
+    void updateProgress(int progress);
+    void reportSheetImported(CASheet* sheet);
+
 #ifndef SWIG
     QTextStream& in()
     {
@@ -128,10 +136,14 @@ private:
     };
 
     void run();
+    void startImport(CAImportPart part);
     inline void setImportPart(CAImportPart part) { _importPart = part; }
     inline CAImportPart importPart() { return _importPart; }
 
     CAImportPart _importPart;
+    bool _synchronous;
+    std::atomic<int> _sheetsImported; // number of sheets finished while importing the document
+    QList<CASheet*> _sheetPreviews; // copies of the finished sheets passed by sheetImported()
 };
 
 #endif /* IMPORT_H_ */
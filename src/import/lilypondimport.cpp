@@ -18,25 +18,19 @@
 #include "score/slur.h"
 
 /*!
+	\fn bool CALilyPondImport::isWhitespaceDelimiter(const QChar c)
 	Delimiters which separate various music elements in LilyPond syntax. These are new lines, tabs, blanks etc.
 
-	\sa nextElement(), parseNextElement()
+	\sa parseNextElement()
 */
-const QRegExp CALilyPondImport::WHITESPACE_DELIMITERS = QRegExp("[\\s]");
 
 /*!
+	\fn bool CALilyPondImport::isSyntaxDelimiter(const QChar c)
 	Delimiters which separate various music elements in LilyPond syntax, but are specific for LilyPond syntax.
 	They are reported as its own element when parsing the next element.
 
-	\sa nextElement(), parseNextElement()
-*/
-const QRegExp CALilyPondImport::SYNTAX_DELIMITERS = QRegExp("[<>{}]");
-
-/*!
-	Combined WHITESPACE_DELIMITERS and SYNTAX_DELIMITERS.
+	\sa parseNextElement()
 */
-const QRegExp CALilyPondImport::DELIMITERS = QRegExp(
-    CALilyPondImport::WHITESPACE_DELIMITERS.pattern().left(CALilyPondImport::WHITESPACE_DELIMITERS.pattern().size() - 1) + CALilyPondImport::SYNTAX_DELIMITERS.pattern().mid(1));
 
 CALilyPondImport::CALilyPondImport(const QString in)
     : CAImport(in)
@@ -63,7 +57,11 @@ CALilyPondImport::~CALilyPondImport()
 
 void CALilyPondImport::initLilyPondImport()
 {
-    _curLine = _curChar = 0;
+    _curLine = _curChar = 1; // 0 means "current position" in addError()
+    _pos = 0;
+    _lexerReady = false;
+    _peekPos = -1;
+    _peekStart = _peekEnd = 0;
     _curSlur = nullptr;
     _curPhrasingSlur = nullptr;
     _templateVoice = nullptr;
@@ -84,7 +82,6 @@ CASheet* CALilyPondImport::importSheetImpl()
     sheet->setName(fi.baseName());
 
     (*stream()).setCodec("UTF-8");
-    QString text(*stream()->string());
 
     // To activate this import code uncomment in src/canorus.cpp this line:
     //CAMainWin::uiImportDialog->setFilters( CAMainWin::uiImportDialog->filters() << CAFileFormats::LILYPOND_FILTER );
@@ -98,7 +95,7 @@ CASheet* CALilyPondImport::importSheetImpl()
     bool changed = false;
 
     for (QString curElt = parseNextElement();
-         (!in().isEmpty());
+         (!curElt.isEmpty() || !atEnd());
          curElt = ((curElt.size() && changed) ? curElt : parseNextElement())) { // go to next element, if current one is empty or not changed
         if (curElt.startsWith("\\header")) {
             std::cout << "lilyimport header" << std::endl;
@@ -125,7 +122,7 @@ CAVoice* CALilyPondImport::importVoiceImpl()
     bool changed = false;
 
     for (QString curElt = parseNextElement();
-         (!in().isEmpty());
+         (!curElt.isEmpty() || !atEnd());
          curElt = ((curElt.size() && changed) ? curElt : parseNextElement())) { // go to next element, if current one is empty or not changed
         changed = true; // changed is default to true and false, if none of if clauses were found
         if (curElt.startsWith("\\relative")) {
@@ -354,7 +351,7 @@ CALyricsContext* CALilyPondImport::importLyricsContextImpl()
 
     CASyllable* lastSyllable = nullptr;
     int timeSDummy = 0; // dummy timestart to keep the order of inserted syllables. Real timeStarts are sets when repositSyllables() is called
-    for (QString curElt = parseNextElement(); (!in().isEmpty() || !curElt.isEmpty()); curElt = parseNextElement(), timeSDummy++) {
+    for (QString curElt = parseNextElement(); (!atEnd() || !curElt.isEmpty()); curElt = parseNextElement(), timeSDummy++) {
         QString text = curElt;
         if (curElt == "_")
             text = "";
@@ -384,87 +381,139 @@ CALyricsContext* CALilyPondImport::importLyricsContextImpl()
 }
 
 /*!
-	Returns the first element in input stream ended with one of the delimiters and shorten input stream for the element.
+	Reads the whole input into the lexer buffer. The parsing then only moves the cursor
+	over the buffer and never modifies or rescans the input already parsed.
+*/
+void CALilyPondImport::initLexer()
+{
+    if (_lexerReady) {
+        return;
+    }
 
-	\todo Only one-character syntax delimiters are supported so far.
-	\sa peekNextElement()
+    if (stream() && stream()->string()) {
+        _input = *stream()->string();
+    } else if (stream()) {
+        _input = stream()->readAll();
+    }
+
+    _pos = 0;
+    _peekPos = -1;
+    _curLine = 1;
+    _curChar = 1;
+    _lexerReady = true;
+}
+
+/*!
+	Returns the index of the first character of the next element starting at \a pos.
+	Whitespace and comments are skipped.
 */
-const QString CALilyPondImport::parseNextElement()
+int CALilyPondImport::nextElementStart(int pos)
 {
-    // find the first non-whitespace character
-    int start = in().indexOf(QRegExp("\\S"));
-    if (start == -1) {
-        start = 0;
-    } else if (in().mid(start, 1) == "%") {
-        // handle comments
-        start = in().indexOf(QRegExp("[\n\r]"), start);
-        if (start == -1) {
-            start = in().size();
-        } else {
-            start = in().indexOf(QRegExp("\\S"), start);
-            if (start == -1) {
-                start = in().size();
+    const QChar* data = _input.constData();
+    const int size = _input.size();
+
+    while (pos < size) {
+        if (isWhitespaceDelimiter(data[pos])) {
+            pos++;
+        } else if (data[pos] == '%') {
+            // handle comments
+            while (pos < size && data[pos] != '\n' && data[pos] != '\r') {
+                pos++;
             }
+        } else {
+            break;
         }
     }
 
-    int i = in().indexOf(DELIMITERS, start);
-    if (i == -1) {
-        i = in().size();
+    return pos;
+}
+
+/*!
+	Returns the index after the last character of the element starting at \a start.
+
+	\todo Only one-character syntax delimiters are supported so far.
+*/
+int CALilyPondImport::nextElementEnd(int start)
+{
+    const QChar* data = _input.constData();
+    const int size = _input.size();
+
+    if (start < size && isSyntaxDelimiter(data[start])) {
+        return start + 1; // syntax delimiter only
     }
 
-    QString ret;
-    if (i == start) {
-        // syntax delimiter only
-        ret = in().mid(start, 1); /// \todo Support for syntax delimiters longer than 1 character
-        in().remove(0, start + 1);
-    } else {
-        // ordinary whitespace/syntax delimiter
-        ret = in().mid(start, i - start);
-        in().remove(0, i);
+    int end = start;
+    while (end < size && !isDelimiter(data[end])) {
+        end++;
     }
 
-    return ret;
+    return end;
 }
 
 /*!
-	Returns the first element in input stream ended with one of the delimiters but don't shorten the stream.
+	Returns True, if there are no more elements left in the input.
+*/
+bool CALilyPondImport::atEnd()
+{
+    initLexer();
+    return nextElementStart(_pos) >= _input.size();
+}
 
-	\sa parseNextElement()
+/*!
+	Returns the first element in input stream ended with one of the delimiters and moves the cursor after the element.
+	Empty string is returned when the end of the input is reached.
+
+	\sa peekNextElement()
 */
-const QString CALilyPondImport::peekNextElement()
+const QString CALilyPondImport::parseNextElement()
 {
-    // find the first non-whitespace character
-    int start = in().indexOf(QRegExp("\\S"));
-    if (start == -1) {
-        start = 0;
-    } else if (in().mid(start, 1) == "%") {
-        // handle comments
-        start = in().indexOf(QRegExp("[\n\r]"), start);
-        if (start == -1) {
-            start = in().size();
+    initLexer();
+
+    int start, end;
+    if (_peekPos == _pos) {
+        start = _peekStart;
+        end = _peekEnd;
+    } else {
+        start = nextElementStart(_pos);
+        end = nextElementEnd(start);
+    }
+    _peekPos = -1;
+
+    // update the line and char position for error reporting
+    const QChar* data = _input.constData();
+    for (int i = _pos; i < start; i++) {
+        if (data[i] == '\n') {
+            _curLine++;
+            _curChar = 1;
         } else {
-            start = in().indexOf(QRegExp("\\S"), start);
-            if (start == -1) {
-                start = in().size();
-            }
+            _curChar++;
         }
     }
+    _curChar += end - start;
 
-    int i = in().indexOf(DELIMITERS, start);
-    if (i == -1)
-        i = in().size();
+    _pos = end;
+    updateProgress(static_cast<int>(static_cast<qint64>(_pos) * 100 / qMax(_input.size(), 1)));
 
-    QString ret;
-    if (i == start) {
-        // syntax delimiter only
-        ret = in().left(1); /// \todo
-    } else {
-        // ordinary whitespace/syntax delimiter
-        ret = in().mid(start, i - start);
+    return _input.mid(start, end - start);
+}
+
+/*!
+	Returns the first element in input stream ended with one of the delimiters but doesn't move the cursor.
+	The element's position is remembered, so the following parseNextElement() doesn't scan it again.
+
+	\sa parseNextElement()
+*/
+const QString CALilyPondImport::peekNextElement()
+{
+    initLexer();
+
+    if (_peekPos != _pos) {
+        _peekStart = nextElementStart(_pos);
+        _peekEnd = nextElementEnd(_peekStart);
+        _peekPos = _pos;
     }
 
-    return ret;
+    return _input.mid(_peekStart, _peekEnd - _peekStart);
 }
 
 /*!
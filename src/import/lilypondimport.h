@@ -47,9 +47,9 @@ public:
 private:
     void initLilyPondImport();
 
-    static const QRegExp WHITESPACE_DELIMITERS;
-    static const QRegExp SYNTAX_DELIMITERS;
-    static const QRegExp DELIMITERS;
+    static inline bool isWhitespaceDelimiter(const QChar c) { return c.isSpace(); }
+    static inline bool isSyntaxDelimiter(const QChar c) { return c == '<' || c == '>' || c == '{' || c == '}'; }
+    static inline bool isDelimiter(const QChar c) { return isWhitespaceDelimiter(c) || isSyntaxDelimiter(c); }
 
     // Internal time signature
     struct CATime {
@@ -73,6 +73,10 @@ private:
 
     const QString parseNextElement();
     const QString peekNextElement();
+    bool atEnd();
+    void initLexer();
+    int nextElementStart(int pos);
+    int nextElementEnd(int start);
     void addError(QString description, int lineError = 0, int charError = 0);
 
     //////////////////////
@@ -95,7 +99,6 @@ private:
     ///////////////////////////
     // Getter/Setter methods //
     ///////////////////////////
-    inline QString& in() { return *stream()->string(); }
     inline CALilyPondDepth curDepth() { return _depth.top(); }
     inline void pushDepth(CALilyPondDepth depth) { _depth.push(depth); }
     inline CALilyPondDepth popDepth() { return _depth.pop(); }
@@ -108,6 +111,13 @@ private:
     CASlur* _curPhrasingSlur;
     QStack<CALilyPondDepth> _depth; // which block is currently processed
     int _curLine, _curChar;
+
+    // Lexer state
+    QString _input; // whole input, never modified while parsing
+    int _pos; // cursor to the first unparsed character in _input
+    bool _lexerReady;
+    int _peekPos; // cursor for which the peeked element below was found, -1 if none
+    int _peekStart, _peekEnd;
     QList<QString> _errors;
     QList<QString> _warnings;
 
@@ -0,0 +1,326 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QFile>
+#include <QIODevice>
+#include <QObject>
+
+#include <algorithm>
+
+#include "import/midifilereader.h"
+
+/*!
+	\class CAMidiFileReader
+	\brief Standard MIDI File parser
+
+	This class reads the Standard MIDI File (format 0, 1 and 2) and stores all the events of all the tracks
+	into a single flat list of CAMidiFileEvent sorted by time. Note on and note off messages are paired
+	into a single Note event with its length, running status is decoded and the tempo, time signature and
+	key signature meta events are reported in track -1 (the tempo map) before any other events at the
+	same time.
+
+	The file is memory-mapped and parsed in-place. The reader doesn't use any global state, so several
+	MIDI files can be read at the same time in different threads.
+
+	\code
+	  CAMidiFileReader reader;
+	  if (reader.readFile("song.mid")) {
+	      for (const CAMidiFileEvent& e : reader.events()) {
+	          ...
+	      }
+	  }
+	\endcode
+
+	\sa CAMidiImport
+*/
+
+namespace {
+const quint32 MIDI_FILE_MAGIC = 0x4d546864; // "MThd"
+const quint32 MIDI_TRACK_MAGIC = 0x4d54726b; // "MTrk"
+
+inline quint32 readInt(const unsigned char* p, int n)
+{
+    quint32 val = 0;
+    for (int i = 0; i < n; i++) {
+        val = (val << 8) | p[i];
+    }
+    return val;
+}
+}
+
+CAMidiFileReader::CAMidiFileReader()
+    : _format(0)
+    , _tracks(0)
+    , _timeBase(0)
+{
+}
+
+CAMidiFileReader::~CAMidiFileReader()
+{
+}
+
+/*!
+	Memory-maps and reads the MIDI file named \a fileName.
+	Returns True on success, False otherwise. See errorString() for details.
+*/
+bool CAMidiFileReader::readFile(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        _errorString = QObject::tr("Unable to open file %1 for reading").arg(fileName);
+        return false;
+    }
+
+    uchar* data = file.map(0, file.size());
+    if (!data) {
+        // mapping not supported (eg. resource files), fallback to reading
+        return readDevice(&file);
+    }
+
+    bool ret = readData(data, file.size());
+    file.unmap(data);
+
+    return ret;
+}
+
+/*!
+	Reads the MIDI file from the given opened \a device.
+	Returns True on success, False otherwise. See errorString() for details.
+*/
+bool CAMidiFileReader::readDevice(QIODevice* device)
+{
+    QByteArray data = device->readAll();
+    return readData(reinterpret_cast<const unsigned char*>(data.constData()), data.size());
+}
+
+/*!
+	Parses the MIDI file stored in memory at \a data of the given \a size.
+	Returns True on success, False otherwise. See errorString() for details.
+*/
+bool CAMidiFileReader::readData(const unsigned char* data, qint64 size)
+{
+    _events.clear();
+    _errorString.clear();
+
+    if (size < 14 || readInt(data, 4) != MIDI_FILE_MAGIC) {
+        _errorString = QObject::tr("Bad header, probably not a real midi file");
+        return false;
+    }
+
+    quint32 headerLength = readInt(data + 4, 4);
+    if (headerLength < 6 || headerLength > size - 8) {
+        _errorString = QObject::tr("Bad header length, probably not a real midi file");
+        return false;
+    }
+
+    _format = readInt(data + 8, 2);
+    _tracks = readInt(data + 10, 2);
+    _timeBase = readInt(data + 12, 2);
+    if (_timeBase & 0x8000) {
+        // SMPTE time division, use ticks per frame times frames per second as ticks per quarter at 120 bpm
+        _timeBase = (-static_cast<signed char>(_timeBase >> 8)) * (_timeBase & 0xff) / 2;
+    }
+    if (_timeBase <= 0) {
+        _errorString = QObject::tr("Bad time division in the header");
+        return false;
+    }
+
+    // default tempo
+    addEvent(CAMidiFileEvent::Tempo, 0, -1, 0, 60000000 / 120);
+
+    qint64 pos = 8 + headerLength;
+    int track = 0;
+    while (pos + 8 <= size && track < _tracks) {
+        quint32 chunkType = readInt(data + pos, 4);
+        qint64 chunkLength = readInt(data + pos + 4, 4);
+        pos += 8;
+        if (chunkLength > size - pos) {
+            // truncated file, read what we can
+            chunkLength = size - pos;
+        }
+
+        if (chunkType == MIDI_TRACK_MAGIC) { // skip any unknown chunks
+            if (!readTrack(data + pos, chunkLength, track)) {
+                return false;
+            }
+            track++;
+        }
+        pos += chunkLength;
+    }
+
+    sortEvents();
+    return true;
+}
+
+/*!
+	Reads a single track chunk of the given \a size located at \a data.
+*/
+bool CAMidiFileReader::readTrack(const unsigned char* data, qint64 size, int track)
+{
+    qint64 pos = 0;
+    int time = 0;
+    int runningStatus = 0;
+    QVector<int> openNotes; // indices of note events waiting for their note off
+
+    auto readVar = [&](int& val) -> bool {
+        val = 0;
+        for (int i = 0; i < 4; i++) {
+            if (pos >= size) {
+                return false;
+            }
+            unsigned char c = data[pos++];
+            val = (val << 7) | (c & 0x7f);
+            if (!(c & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto finishNote = [&](int channel, int pitch) {
+        for (int i = openNotes.size() - 1; i >= 0; i--) {
+            CAMidiFileEvent& n = _events[openNotes[i]];
+            if (n.data1 == pitch && n.channel == channel) {
+                n.length = qMax(time - n.time, 0);
+                openNotes.remove(i);
+                break;
+            }
+        }
+    };
+
+    while (pos < size) {
+        int delta;
+        if (!readVar(delta)) {
+            break;
+        }
+        time += delta;
+
+        if (pos >= size) {
+            break;
+        }
+        int status = data[pos];
+        if (status & 0x80) {
+            pos++;
+            if (status < 0xf0) {
+                runningStatus = status;
+            }
+        } else if (runningStatus) {
+            status = runningStatus; // running status, reuse the data byte
+        } else {
+            _errorString = QObject::tr("Data byte without status in track %1").arg(track);
+            return false;
+        }
+
+        int type = status & 0xf0;
+        int channel = status & 0x0f;
+        int dataLength = (type == 0xc0 || type == 0xd0) ? 1 : 2;
+        if (type != 0xf0 && pos + dataLength > size) {
+            break;
+        }
+
+        switch (type) {
+        case 0x80: // note off
+            finishNote(channel, data[pos]);
+            break;
+        case 0x90: // note on
+            if (data[pos + 1] == 0) {
+                finishNote(channel, data[pos]); // note on with zero velocity is note off
+            } else {
+                openNotes << _events.size();
+                addEvent(CAMidiFileEvent::Note, time, track, channel, data[pos], data[pos + 1]);
+            }
+            break;
+        case 0xa0:
+            addEvent(CAMidiFileEvent::KeyTouch, time, track, channel, data[pos], data[pos + 1]);
+            break;
+        case 0xb0:
+            addEvent(CAMidiFileEvent::Control, time, track, channel, data[pos], data[pos + 1]);
+            break;
+        case 0xc0:
+            addEvent(CAMidiFileEvent::Program, time, track, channel, data[pos]);
+            break;
+        case 0xd0:
+            addEvent(CAMidiFileEvent::Pressure, time, track, channel, data[pos]);
+            break;
+        case 0xe0:
+            addEvent(CAMidiFileEvent::PitchBend, time, track, channel, (data[pos] | (data[pos + 1] << 7)) - 0x2000);
+            break;
+        case 0xf0: {
+            dataLength = 0;
+            int metaType = -1;
+            if (status == 0xff) {
+                if (pos >= size) {
+                    break;
+                }
+                metaType = data[pos++];
+            }
+
+            int length;
+            if (!readVar(length) || length > size - pos) {
+                pos = size;
+                break;
+            }
+            const unsigned char* meta = data + pos;
+
+            if (status != 0xff) {
+                addEvent(CAMidiFileEvent::SysEx, time, track, 0, status, length);
+            } else if (metaType == 0x2f) {
+                pos = size; // end of track
+            } else if (metaType == 0x51 && length >= 3) {
+                addEvent(CAMidiFileEvent::Tempo, time, -1, 0, readInt(meta, 3));
+            } else if (metaType == 0x58 && length >= 2) {
+                addEvent(CAMidiFileEvent::TimeSignature, time, -1, 0, meta[0], 1 << qMin<int>(meta[1], 16));
+            } else if (metaType == 0x59 && length >= 2) {
+                addEvent(CAMidiFileEvent::KeySignature, time, -1, 0, static_cast<signed char>(meta[0]), meta[1] == 1 ? 1 : 0);
+            } else if (metaType >= 0x01 && metaType <= 0x07) {
+                addEvent(CAMidiFileEvent::Text, time, track, 0, metaType, length);
+            } else if (metaType == 0x54 && length >= 5) {
+                addEvent(CAMidiFileEvent::SmpteOffset, time, track, 0, meta[0], meta[1]);
+            }
+
+            if (pos < size) {
+                pos += length;
+            }
+            break;
+        }
+        }
+
+        pos += dataLength;
+    }
+
+    // finish any left-over notes at the end of the track
+    for (int i = 0; i < openNotes.size(); i++) {
+        CAMidiFileEvent& n = _events[openNotes[i]];
+        n.length = qMax(time - n.time, 0);
+    }
+
+    return true;
+}
+
+void CAMidiFileReader::addEvent(CAMidiFileEvent::CAMidiFileEventType type, int time, int track, int channel, int data1, int data2, int length)
+{
+    CAMidiFileEvent e;
+    e.time = time;
+    e.length = length;
+    e.track = track;
+    e.data1 = data1;
+    e.data2 = data2;
+    e.type = static_cast<unsigned char>(type);
+    e.channel = static_cast<unsigned char>(channel);
+    _events << e;
+}
+
+/*!
+	Merges the events of all the tracks by time. At the same time the tempo map events go first
+	followed by the events in the order of tracks and the order in the track.
+*/
+void CAMidiFileReader::sortEvents()
+{
+    std::stable_sort(_events.begin(), _events.end(), [](const CAMidiFileEvent& a, const CAMidiFileEvent& b) {
+        return (a.time < b.time) || (a.time == b.time && a.track < b.track);
+    });
+}
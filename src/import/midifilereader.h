@@ -0,0 +1,73 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef MIDIFILEREADER_H_
+#define MIDIFILEREADER_H_
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+class QIODevice;
+
+/*!
+	Single event read from the Standard MIDI File.
+	Note on and note off messages are already paired into a single Note event with the length.
+*/
+struct CAMidiFileEvent {
+    enum CAMidiFileEventType {
+        Note, // data1 = pitch, data2 = velocity, length in ticks
+        Control, // data1 = controller number, data2 = value
+        Program, // data1 = program number
+        PitchBend, // data1 = pitch bend centered around zero
+        Pressure, // data1 = channel pressure
+        KeyTouch, // data1 = pitch, data2 = pressure
+        SysEx,
+        Tempo, // data1 = microseconds per quarter
+        TimeSignature, // data1 = top, data2 = bottom
+        KeySignature, // data1 = number of sharps (positive) or flats (negative), data2 = 1 if minor
+        Text,
+        SmpteOffset
+    };
+
+    int time; // absolute time in ticks
+    int length; // length in ticks of the Note event
+    int track; // track index, -1 for the tempo map events
+    int data1;
+    int data2;
+    unsigned char type; // CAMidiFileEventType
+    unsigned char channel;
+};
+
+class CAMidiFileReader {
+public:
+    CAMidiFileReader();
+    ~CAMidiFileReader();
+
+    bool readFile(const QString& fileName);
+    bool readDevice(QIODevice* device);
+    bool readData(const unsigned char* data, qint64 size);
+
+    inline int format() { return _format; }
+    inline int tracks() { return _tracks; }
+    inline int timeBase() { return _timeBase; }
+    inline const QVector<CAMidiFileEvent>& events() { return _events; }
+    inline const QString& errorString() { return _errorString; }
+
+private:
+    bool readTrack(const unsigned char* data, qint64 size, int track);
+    void addEvent(CAMidiFileEvent::CAMidiFileEventType type, int time, int track, int channel, int data1 = 0, int data2 = 0, int length = 0);
+    void sortEvents();
+
+    int _format;
+    int _tracks;
+    int _timeBase;
+    QVector<CAMidiFileEvent> _events;
+    QString _errorString;
+};
+
+#endif /* MIDIFILEREADER_H_ */
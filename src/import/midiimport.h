@@ -56,7 +56,7 @@ public:
 
 private:
     // Alternatives during developement
-    CASheet* importSheetImplPmidiParser(CASheet* sheet);
+    CASheet* importSheetImplMidiFileReader(CASheet* sheet);
     void importMidiEvents();
 
     void initMidiImport();
@@ -174,6 +174,10 @@ void CAMusicXmlImport::readScorePartwise()
             }
         }
     }
+
+    for (int i = 0; i < _document->sheetList().size(); i++) {
+        reportSheetImported(_document->sheetList()[i]);
+    }
 }
 
 void CAMusicXmlImport::readScoreTimewise()
@@ -311,6 +315,8 @@ void CAMusicXmlImport::readMeasure(QString partId)
         }
     }
 
+    updateProgress();
+
     // Finish the measure (add barlines to all staffs)
     for (int staffIdx = 0; staffIdx < _partMapStaff[partId].size(); staffIdx++) {
         CAStaff* staff = _partMapStaff[partId][staffIdx];
@@ -8,6 +8,7 @@
 #include "import/mxlimport.h"
 #include <QDebug>
 #include <QDir>
+#include <QTemporaryDir>
 #include <iostream> // debug
 
 CAMXLImport::CAMXLImport(QTextStream* stream)
@@ -26,24 +27,24 @@ CAMXLImport::~CAMXLImport()
 
 CADocument* CAMXLImport::importDocumentImpl()
 {
-    int arg = 2;
     _zipArchivePath = fileName();
-    // Extract whole archive to temp folder
-    zip_extract(fileName().toLatin1().constData(), QDir::tempPath().toLatin1().constData(), [](const char* filename, void* arg) {
-        static int i = 0;
-        int n = *static_cast<int*>(arg);
-        qDebug().noquote() << "Extracted: " << filename << "(" << ++i << " of " << n << ")\n";
-
-        return 0;
-    },
-        &arg);
+    // Extract whole archive to a private temp folder, so several archives can be imported at the same time
+    QTemporaryDir extractDir;
+    if (!extractDir.isValid()) {
+        qDebug() << "Failed to create a temporary folder for " << fileName();
+        return nullptr;
+    }
+    if (zip_extract(fileName().toLocal8Bit().constData(), extractDir.path().toLocal8Bit().constData(), nullptr, nullptr) < 0) {
+        qDebug() << "Failed to extract " << fileName();
+        return nullptr;
+    }
 
-    QFileInfo containerInfo(QDir::tempPath() + QString("/META-INF/container.xml"));
+    QFileInfo containerInfo(extractDir.path() + QString("/META-INF/container.xml"));
     QString musicXMLFileName;
     bool eocRes = openContainer(containerInfo);
     if (eocRes) {
         eocRes = readContainerInfo(musicXMLFileName);
-        QFileInfo musicXMLFileInfo(QDir::tempPath() + "/" + musicXMLFileName);
+        QFileInfo musicXMLFileInfo(extractDir.path() + "/" + musicXMLFileName);
         if (musicXMLFileInfo.exists()) {
             setStreamFromFile(musicXMLFileInfo.filePath());
             return CAMusicXmlImport::importDocumentImpl();
@@ -6,7 +6,9 @@
 	Licensed under the GNU GENERAL PUBLIC LICENSE. See COPYING for details.
 */
 
+#include <QGuiApplication>
 #include <QObject>
+#include <QScreen>
 #include <iostream> //debugging
 
 #include "canorus.h"
@@ -33,13 +35,28 @@ class CAMenuToolButton;
 
 	Key strockes within 100 ms will be combined into a chord.
 
+	In the step input mode (see CASettings::midiInStepInput()) the notes played in a phrase
+	are appended to the voice without any pause. The current view is relayouted at most once
+	per display frame in which a note arrived, and the staff is synchronized only if a barline
+	was added meanwhile. The other views are rebuilt and the undo command is pushed at the end
+	of the phrase, after PHRASE_IDLE_TIME ms without new notes or in finishPhrase().
+	The undo command of the phrase is kept by CAUndo as the pending command, so any other
+	change of the document finishes the phrase first (see CAUndo::createPendingUndoCommand()).
+
 	Accents are set according the current key pitch. Automatic tracking of the scene is done too.
 
+	Midi messages are received from CAMidiDevice::midiInMessage() in the GUI thread.
+	The time from the key press to the inserted note is collected in latency() and
+	reported to the hook set by setLatencyHook(), if any.
+
 	todo: User selectable (to be implemented) midi pitches can be set to be interpreted as rest input,
 	punctuation and so on.  Inserting at the currently selected note.
 
 */
 
+CAKeybdInput::CALatencyHook CAKeybdInput::_latencyHook = nullptr;
+const int CAKeybdInput::PHRASE_IDLE_TIME = 1000;
+
 CAKeybdInput::CAKeybdInput(CAMainWin* mw)
 {
     _mw = mw;
@@ -50,6 +67,13 @@ CAKeybdInput::CAKeybdInput(CAMainWin* mw)
     _tup = nullptr;
     _lastMidiInVoice = nullptr;
     _noteLayout.clear();
+
+    _phraseVoice = nullptr;
+    _phraseBarlines = false;
+    _phraseTimer.setSingleShot(true);
+    QObject::connect(&_phraseTimer, &QTimer::timeout, [this]() { finishPhrase(); });
+    _updateTimer.setSingleShot(true);
+    QObject::connect(&_updateTimer, &QTimer::timeout, [this]() { updatePhrase(); });
 }
 
 /*!
@@ -59,19 +83,15 @@ CAKeybdInput::~CAKeybdInput()
 {
 }
 
-void CAKeybdInput::onMidiInEvent(QVector<unsigned char> m)
+void CAKeybdInput::onMidiInMessage(const CAMidiMessage& m)
 {
     unsigned char event, velocity;
-    std::cout << "MidiInEvent: ";
-    for (int i = 0; i < m.size(); i++)
-        std::cout << static_cast<int>(m[i]) << " ";
-    std::cout << std::endl;
-    if (m.size() < 3) // only note on/off here which are 3 bytes
+    if (m.size < 3) // only note on/off here which are 3 bytes
         return;
-    event = m[0];
-    velocity = m[2];
+    event = m.data[0];
+    velocity = m.data[2];
     if (event == CAMidiDevice::Midi_Note_On && velocity != 0) {
-        //CADiatonicPitch x = CADiatonicPitch::diatonicPitchFromMidiPitch( m[1] );
+        //CADiatonicPitch x = CADiatonicPitch::diatonicPitchFromMidiPitch( m.data[1] );
         midiInEventToScore(_mw->currentScoreView(), m);
     }
 }
@@ -79,17 +99,18 @@ void CAKeybdInput::onMidiInEvent(QVector<unsigned char> m)
 /*!
 	This is the entry point the midi input device. All note on events are passed over here.
 */
-void CAKeybdInput::midiInEventToScore(CAScoreView* v, QVector<unsigned char> m)
+void CAKeybdInput::midiInEventToScore(CAScoreView* v, const CAMidiMessage& m)
 {
 
     int i;
-    CADiatonicPitch p = CADiatonicPitch::diatonicPitchFromMidiPitch(m[1]);
+    CADiatonicPitch p = CADiatonicPitch::diatonicPitchFromMidiPitch(m.data[1]);
     CADiatonicPitch nonenharmonicPitch;
 
     CAVoice* voice = _mw->currentVoice();
+    bool stepInput = CACanorus::settings()->midiInStepInput();
     if (voice) {
 
-        int cpitch = m[1];
+        int cpitch = m.data[1];
         /*
 
 		// will publish this only when it's configurable. Have only a four octave keyboard ...
@@ -139,9 +160,16 @@ void CAKeybdInput::midiInEventToScore(CAScoreView* v, QVector<unsigned char> m)
         // if notes come in sufficiently close together we make a chord of them
         bool appendToChord = _midiInChordTimer.isActive();
 
-        // we create undo only for chords as a whole
-        if (!appendToChord)
+        // we create undo only for chords as a whole, or for the whole phrase in the step input mode
+        if (stepInput) {
+            if (_phraseVoice != voice) {
+                finishPhrase();
+                CACanorus::undo()->createPendingUndoCommand(_mw->document(), QObject::tr("insert midi notes", "undo"), [this]() { finishPhrase(); });
+                _phraseVoice = voice;
+            }
+        } else if (!appendToChord) {
             CACanorus::undo()->createUndoCommand(_mw->document(), QObject::tr("insert midi note", "undo"));
+        }
 
         // If we are still in the processing of a tuplet, check if it's still there.
         // Possibly editing on the GUI could have moved it around or away, and no crash please.
@@ -209,14 +237,12 @@ void CAKeybdInput::midiInEventToScore(CAScoreView* v, QVector<unsigned char> m)
                         note = new CANote(nonenharmonicPitch, lll[i], voice, -1);
                         voice->append(note, appendToChord);
                         _noteLayout.append(voice->lastMusElement());
-                        std::cout << " -- " << lll[i].musicLength() << "." << lll[i].dotted();
-                        CAStaff::placeAutoBar(note);
+                        _phraseBarlines |= CAStaff::placeAutoBar(note, !stepInput) && stepInput;
                         if (i > 0) {
                             _mw->musElementFactory()->configureSlur(staff, prevNote, note);
                         }
                         prevNote = note;
                     }
-                    std::cout << " -- " << std::endl;
                 }
 
             } else {
@@ -238,40 +264,24 @@ void CAKeybdInput::midiInEventToScore(CAScoreView* v, QVector<unsigned char> m)
         // We make shure not to try to place a barline inside a chord or inside a tuplet
         if (CACanorus::settings()->autoBar() && !appendToChord && (!_tupPla || _tupPla->isFirstInTuplet())) {
             if (note)
-                CAStaff::placeAutoBar(note);
+                _phraseBarlines |= CAStaff::placeAutoBar(note, !stepInput) && stepInput;
             else
-                CAStaff::placeAutoBar(rest);
+                _phraseBarlines |= CAStaff::placeAutoBar(rest, !stepInput) && stepInput;
         }
 
-        voice->synchronizeMusElements(); // probably not needed
-
-        CACanorus::undo()->pushUndoCommand();
-
-        // now we try to highlight the inserted note/chord by selection:
-        if (!appendToChord) {
-            v->clearSelection(); // remove old note/chord from selection
-        }
-        QList<CAPlayable*> lp = voice->getChord(voice->lastMusElement()->timeStart());
-        QList<CAMusElement*> lme;
-        for (int i = 0; i < lp.size(); i++)
-            lme << static_cast<CAMusElement*>(lp[i]);
-        _mw->currentScoreView()->addToSelection(lme);
-
-        // When I looking the last appended note is note showing up. Where goes it missing?
-        // Still without a clue. georg
-        // QList<CADrawableMusElement*> list = v->selection();
-        // std::cout << " Selektierte Elemente: " << list.size() << " Stück, oben "<<lp.size()<<" und "<<lme.size() << std::endl;
-
-        // scene tracking
-        QRectF scene = v->worldCoords();
-        double xlast = v->timeToCoordsSimpleVersion(voice->lastTimeStart());
-        if (((xlast + 50) > scene.right())) { // the magic number 50 should be defined, ist the width of an element
-            scene.translate(scene.width() / 2, 0);
-            v->setWorldCoords(scene, false, true);
+        if (stepInput) {
+            // the undo command is pushed and the view updated later, see finishPhrase() and updatePhrase()
+            measureLatency(m);
+            _phraseTimer.start(PHRASE_IDLE_TIME);
+            if (!_updateTimer.isActive()) {
+                _updateTimer.start(updateInterval());
+            }
+        } else {
+            voice->synchronizeMusElements(); // probably not needed
+            CACanorus::undo()->pushUndoCommand();
+            measureLatency(m);
+            updateView(v, voice);
         }
-        v->updateHelpers();
-        v->repaint();
-        CACanorus::rebuildUI(_mw->document(), _mw->currentSheet());
 
         // start timer eventually for chord detection
         if (!_midiInChordTimer.isActive()) {
@@ -280,6 +290,129 @@ void CAKeybdInput::midiInEventToScore(CAScoreView* v, QVector<unsigned char> m)
     }
 }
 
+/*!
+	Rebuilds all the views of the current sheet and highlights the last inserted note or chord
+	in the view \a v.
+*/
+void CAKeybdInput::updateView(CAScoreView* v, CAVoice* voice)
+{
+    CACanorus::rebuildUI(_mw->document(), _mw->currentSheet());
+    selectLastChord(v, voice);
+}
+
+/*!
+	Highlights the last inserted note or chord in the view \a v and scrolls the view to it.
+	The view must be rebuilt first, so the inserted notes have their drawable elements.
+*/
+void CAKeybdInput::selectLastChord(CAScoreView* v, CAVoice* voice)
+{
+    v->clearSelection(); // remove old note/chord from selection
+    QList<CAPlayable*> lp = voice->getChord(voice->lastMusElement()->timeStart());
+    QList<CAMusElement*> lme;
+    for (int i = 0; i < lp.size(); i++)
+        lme << static_cast<CAMusElement*>(lp[i]);
+    v->addToSelection(lme);
+
+    // scene tracking
+    QRectF scene = v->worldCoords();
+    double xlast = v->timeToCoordsSimpleVersion(voice->lastTimeStart());
+    if (((xlast + 50) > scene.right())) { // the magic number 50 should be defined, ist the width of an element
+        scene.translate(scene.width() / 2, 0);
+        v->setWorldCoords(scene, false, true);
+    }
+    v->updateHelpers();
+    v->repaint();
+}
+
+/*!
+	Returns True, if the voice of the current phrase is still in the current sheet.
+*/
+bool CAKeybdInput::isPhraseValid()
+{
+    return _phraseVoice && _mw->currentSheet() && _mw->currentSheet()->voiceList().contains(_phraseVoice);
+}
+
+/*!
+	Synchronizes the voice of the current phrase and its staff, if a barline was added to it.
+*/
+void CAKeybdInput::synchronizePhrase()
+{
+    _phraseVoice->synchronizeMusElements();
+    if (_phraseBarlines) {
+        _phraseVoice->staff()->synchronizeVoices();
+        _phraseBarlines = false;
+    }
+}
+
+/*!
+	Relayouts the current view with the notes of the current phrase. Called by the update timer
+	at most once per display frame in which a note arrived. The other views are rebuilt in
+	finishPhrase().
+*/
+void CAKeybdInput::updatePhrase()
+{
+    if (!isPhraseValid()) {
+        return; // the voice was removed meanwhile
+    }
+
+    synchronizePhrase();
+    CAScoreView* v = _mw->currentScoreView();
+    if (v && v->sheet() == _mw->currentSheet()) {
+        v->rebuild();
+        v->checkScrollBars();
+        selectLastChord(v, _phraseVoice);
+    }
+}
+
+/*!
+	Finishes the current step input phrase: rebuilds the views and pushes the undo command
+	of the whole phrase. CAUndo calls this before any other undo command is created.
+*/
+void CAKeybdInput::finishPhrase()
+{
+    _phraseTimer.stop();
+    if (!_phraseVoice) {
+        return;
+    }
+
+    _updateTimer.stop();
+    if (isPhraseValid()) {
+        synchronizePhrase();
+        if (_mw->currentScoreView()) {
+            updateView(_mw->currentScoreView(), _phraseVoice);
+        } else {
+            CACanorus::rebuildUI(_mw->document(), _mw->currentSheet());
+        }
+    }
+    _phraseVoice = nullptr;
+    _phraseBarlines = false;
+    CACanorus::undo()->pushPendingUndoCommand();
+}
+
+/*!
+	Returns the interval in ms of the view updates during the step input matching the display refresh rate.
+*/
+int CAKeybdInput::updateInterval()
+{
+    QScreen* screen = QGuiApplication::primaryScreen();
+    return (screen && screen->refreshRate() > 0 ? qMax(qRound(1000 / screen->refreshRate()), 1) : 16);
+}
+
+/*!
+	Adds the time from the key press of the midi message \a m until now to latency().
+*/
+void CAKeybdInput::measureLatency(const CAMidiMessage& m)
+{
+    qint64 latency = CAMidiDevice::monotonicTime() - m.time;
+    _latency.events++;
+    _latency.total += latency;
+    _latency.max = qMax(_latency.max, latency);
+
+    if (_latencyHook) {
+        _latencyHook(latency);
+    }
+}
+
 /*!
 	This function looks up the current key signiture. Then it computes the proper accidentials
 	for the note.
@@ -15,16 +15,51 @@
 #include "ui/mainwin.h"
 
 class CAMainWin;
+struct CAMidiMessage;
+
+/*!
+	Latency from the midi key press to the inserted note in microseconds.
+*/
+struct CAMidiInLatency {
+    int events = 0;
+    qint64 total = 0;
+    qint64 max = 0;
+
+    inline qint64 average() const { return events ? total / events : 0; }
+};
 
 class CAKeybdInput {
 public:
+    typedef void (*CALatencyHook)(qint64 latency);
+
     CAKeybdInput(CAMainWin* m);
     ~CAKeybdInput();
-    void onMidiInEvent(QVector<unsigned char> m);
+    void onMidiInMessage(const CAMidiMessage& m);
+
+    inline const CAMidiInLatency& latency() { return _latency; }
+    inline void resetLatency() { _latency = CAMidiInLatency(); }
+    static inline void setLatencyHook(CALatencyHook hook) { _latencyHook = hook; }
+
+    void finishPhrase();
+
+    static const int PHRASE_IDLE_TIME;
 
 private:
     CAMainWin* _mw;
-    void midiInEventToScore(CAScoreView* v, QVector<unsigned char> m);
+    void midiInEventToScore(CAScoreView* v, const CAMidiMessage& m);
+    void measureLatency(const CAMidiMessage& m);
+    void updateView(CAScoreView* v, CAVoice* voice);
+    void selectLastChord(CAScoreView* v, CAVoice* voice);
+    bool isPhraseValid();
+    void synchronizePhrase();
+    void updatePhrase();
+    int updateInterval();
+    CAVoice* _phraseVoice; // voice of the current step input phrase, null if none
+    bool _phraseBarlines; // barlines were added to the phrase voice since the staff was synchronized
+    QTimer _phraseTimer; // finishes the phrase when idle
+    QTimer _updateTimer; // throttles the view updates
+    CAMidiInLatency _latency;
+    static CALatencyHook _latencyHook;
     QTimer _midiInChordTimer;
     //CASheet *_lastMidiInSheet;
     //CAStaff *_lastMidiInStaff;
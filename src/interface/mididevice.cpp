@@ -5,7 +5,14 @@
 	Licensed under the GNU GENERAL PUBLIC LICENSE. See COPYING for details.
 */
 
+#include <QCoreApplication>
+#include <QEvent>
+#include <QThread>
+
+#include <chrono>
+
 #include "interface/mididevice.h"
+#include "core/midirecorder.h"
 #include "score/diatonickey.h"
 #include "score/diatonicpitch.h"
 #include "score/sheet.h"
@@ -31,12 +38,113 @@ QStringList CAMidiDevice::GM_INSTRUMENTS = QStringList() <<
 	of the non-real-time Midi classes. It needs also the time to write the
 	midi event to a file.
 
+	Midi input events are received in the input thread of the device and passed to the thread
+	of the device object (the GUI thread) through a lock-free queue. The GUI thread is woken up by
+	a single high priority event for all the messages queued meanwhile, which emits midiInMessage()
+	for each of them.
+
 	\warning MIDI INPUT is not available for Swig and therefore scripting languages yet.
 */
 
+namespace {
+const QEvent::Type MIDI_INPUT_EVENT = static_cast<QEvent::Type>(QEvent::User + 100);
+}
+
 CAMidiDevice::CAMidiDevice()
     : QObject()
+    , _recorder(nullptr)
+    , _recording(0)
+    , _inputPosted(false)
+{
+}
+
+/*!
+	\fn void CAMidiDevice::setTrack(int track)
+	Sets the \a track of the messages sent afterwards. CAPlayback sets it to the index of the
+	voice in CAPlaybackTimeline::voices() before sending the messages of the voice. The file
+	writers use it to put every voice into its own track, the other devices ignore it.
+*/
+
+/*!
+	Sends the \a message of the given \a size at the given \a time. The playback thread calls
+	this for every event, so the devices should override it and send the message without
+	copying it. The default implementation copies the message and calls the QVector version.
+*/
+void CAMidiDevice::send(const unsigned char* message, int size, int time)
+{
+    QVector<unsigned char> m(size);
+    for (int i = 0; i < size; i++) {
+        m[i] = message[i];
+    }
+    send(m, time);
+}
+
+/*!
+	Queues the midi input \a message for the GUI thread. Called from the input thread.
+	The message is lost, if the GUI thread is stuck and the queue is full.
+*/
+void CAMidiDevice::postInput(const CAMidiMessage& message)
+{
+    if (!_input.push(message)) {
+        return;
+    }
+
+    if (!_inputPosted.exchange(true)) {
+        QCoreApplication::postEvent(this, new QEvent(MIDI_INPUT_EVENT), Qt::HighEventPriority);
+    }
+}
+
+/*!
+	Sets the recorder \a r which receives the midi input events in the input thread.
+	Waits until the input thread finishes passing the current event to the previous recorder,
+	so the previous recorder can be flushed and deleted as soon as this returns.
+*/
+void CAMidiDevice::setRecorder(CAMidiRecorder* r)
+{
+    _recorder.store(r);
+    while (_recording.load()) {
+        QThread::yieldCurrentThread(); // recordEvent() only pushes into a queue, this is short
+    }
+}
+
+/*!
+	Passes the midi input \a message to the current recorder, if any. Called from the input
+	thread. The recorder isn't changed by setRecorder() while it is in use here.
+*/
+void CAMidiDevice::recordInput(const CAMidiMessage& message)
+{
+    _recording++;
+    CAMidiRecorder* recorder = _recorder.load();
+    if (recorder) {
+        recorder->recordEvent(message);
+    }
+    _recording--;
+}
+
+/*!
+	Emits midiInMessage() for every queued midi input message in the GUI thread.
+*/
+void CAMidiDevice::customEvent(QEvent* event)
+{
+    if (event->type() != MIDI_INPUT_EVENT) {
+        QObject::customEvent(event);
+        return;
+    }
+
+    _inputPosted = false; // cleared first, so a message pushed meanwhile posts a new event
+    CAMidiMessage message;
+    while (_input.pop(message)) {
+        emit midiInMessage(message);
+    }
+}
+
+/*!
+	Returns the current time of the monotonic clock in microseconds.
+	Midi input events are timestamped using this clock.
+*/
+qint64 CAMidiDevice::monotonicTime()
 {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
 /*!
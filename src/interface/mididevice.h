@@ -14,10 +14,25 @@
 #include <QStringList>
 #include <QVector>
 
+#include <atomic>
+
+#include "core/ringbuffer.h"
 #include "score/diatonicpitch.h"
 
 class CASheet;
 class CADiatonicKey;
+class CAMidiRecorder;
+
+#ifndef SWIG
+/*!
+	Short midi message received from the midi input. Sysex messages are not passed.
+*/
+struct CAMidiMessage {
+    qint64 time; // monotonic time of the message in microseconds, see CAMidiDevice::monotonicTime()
+    unsigned char size;
+    unsigned char data[3];
+};
+#endif
 
 class CAMidiDevice : public QObject {
 #ifndef SWIG
@@ -29,7 +44,8 @@ class CAMidiDevice : public QObject {
 public:
     enum CAMidiDeviceType {
         RtMidiDevice,
-        MidiExportDevice
+        MidiExportDevice,
+        SynthMidiDevice
     };
 
     CAMidiDevice();
@@ -81,18 +97,41 @@ public:
     virtual void closeOutputPort() = 0;
     virtual void closeInputPort() = 0;
     virtual void send(QVector<unsigned char> message, int time) = 0; // message and absolute canorus time (independent of tempo)
-    virtual void sendMetaEvent(int time, char event, char a, char b, int c) = 0; // absolute time of the meta event which is meant only for midi file export
+#ifndef SWIG
+    virtual void send(const unsigned char* message, int size, int time); // same without allocating the message
+#endif
+    virtual void sendMetaEvent(int time, char event, char a, char b, int c) = 0; // absolute time of the meta event, Meta_Tempo: a = bpm, c = microseconds per quarter
+    virtual void setTrack(int) {} // track of the following messages, the index of the voice in the playback timeline
+
+#ifndef SWIG
+    inline CAMidiRecorder* recorder() { return _recorder.load(std::memory_order_acquire); }
+    void setRecorder(CAMidiRecorder* r);
+#endif
+
+    static qint64 monotonicTime();
 
 #ifndef SWIG
 signals:
-    void midiInEvent(QVector<unsigned char> message);
+    void midiInMessage(const CAMidiMessage& message);
 #endif
 
 protected:
+#ifndef SWIG
+    void postInput(const CAMidiMessage& message);
+    void recordInput(const CAMidiMessage& message);
+    void customEvent(QEvent* event);
+#endif
+
     void setRealTime(bool r) { _realTime = r; }
     inline void setMidiDeviceType(CAMidiDeviceType t) { _midiDeviceType = t; }
     CAMidiDeviceType _midiDeviceType;
     bool _realTime; // is the device
+#ifndef SWIG
+    std::atomic<CAMidiRecorder*> _recorder; // receives the midi input events directly in the input thread
+    std::atomic<int> _recording; // number of input threads currently passing an event to the recorder
+    CARingBuffer<CAMidiMessage, 1024> _input; // midi input events waiting for the GUI thread
+    std::atomic<bool> _inputPosted; // the GUI thread was already woken up to process the input events
+#endif
 
 private:
     static QStringList GM_INSTRUMENTS;
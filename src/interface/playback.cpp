@@ -7,23 +7,20 @@
 
 #include <QPen>
 #include <QRect>
-#include <QVector> // needed for RtMidi send message
+#include <QSet>
 
 #include <iostream>
+#include <thread>
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <time.h>
+#endif
 
 #include "interface/mididevice.h"
 #include "interface/playback.h"
-#include "score/barline.h"
-#include "score/context.h"
-#include "score/dynamic.h"
-#include "score/instrumentchange.h"
-#include "score/keysignature.h"
-#include "score/mark.h"
+#include "interface/playbacktimeline.h"
 #include "score/note.h"
 #include "score/sheet.h"
-#include "score/staff.h"
-#include "score/tempo.h"
-#include "score/timesignature.h"
 #include "score/voice.h"
 
 /*!
@@ -39,10 +36,19 @@
 	3) Optionally configure playback (setInitTimeStart() to start playback from the specific time. Default 0).
 	4) Call myPlaybackObject->run(). This will start playing in a new thread.
 	5) Call myPlaybackObject->stop() to stop the playback. Playback also stops automatically when finished.
-	6) Playback is also used for creating the events for midi file export. Therefore the music length time _curTime
-	   is also transferred as a paramter in send() and sendMetaEvent() to export the music lengths independent of tempo.
+	6) The music length time of the event is also transferred as a paramter in send() and sendMetaEvent() to
+	   record the music lengths independent of tempo.
+
+	7) Call render() instead of run() to render the playback offline in one pass, eg. into a midi file writer or
+	   a software synthesizer. setTimeEnd() and setRenderSelection() limit the rendered part of the sheet.
+
+	The playback takes a snapshot of the sheet CAPlaybackTimeline when it is created, so only the changed
+	parts of the sheet are compiled and the playback thread only dispatches the events. Use setTimeline()
+	to play a different timeline.
 
 	The playbackFinished() signal is emitted once playback has finished or stopped.
+	When played in real time, the latenessMeasured() signal is emitted before with the
+	lateness of the dispatched events. It is also returned by lateness() after the playback.
 
 	If you want to immediately play only given elements (eg. when inserting notes), call playImmediately().
 */
@@ -54,6 +60,7 @@ CAPlayback::CAPlayback(CASheet* s, CAMidiDevice* m)
     _sheet = s;
     _midiDevice = m;
     _playSelectionOnly = false;
+    compileTimeline();
 }
 
 /*!
@@ -74,11 +81,10 @@ CAPlayback::CAPlayback(CAMidiDevice* m)
 */
 void CAPlayback::initPlayback()
 {
-    _repeating = 0;
-    _lastRepeatOpenIdx = nullptr;
     _curTime = 0;
-    _streamIdx = nullptr;
+    _timeline = nullptr;
     _stop = false;
+    _notificationsLost = false;
     _stopLock = false;
 
     // override this settings in actual constructor
@@ -86,13 +92,13 @@ void CAPlayback::initPlayback()
     _midiDevice = nullptr;
     _playSelectionOnly = false;
     _initTimeStart = 0;
-    _sleepFactor = 1.0; // set by tempo to determine the miliseconds for sleep
+    _timeEnd = -1;
 
     connect(this, SIGNAL(finished()), SLOT(stopNow()));
 }
 
 /*!
-	Destructor deletes the created arrays.
+	Destructor deletes the timeline snapshot.
 */
 CAPlayback::~CAPlayback()
 {
@@ -101,11 +107,31 @@ CAPlayback::~CAPlayback()
         wait();
     }
 
-    if (_lastRepeatOpenIdx)
-        delete[] _lastRepeatOpenIdx;
+    delete _timeline;
+}
+
+/*!
+	Sets the sheet to play and takes the snapshot of its timeline.
+*/
+void CAPlayback::setSheet(CASheet* s)
+{
+    _sheet = s;
+    delete _timeline;
+    _timeline = nullptr;
+    compileTimeline();
+}
+
+/*!
+	Sets the compiled \a timeline to play. The playback takes the ownership of the timeline,
+	eg. of a CAPlaybackTimeline::snapshot().
+*/
+void CAPlayback::setTimeline(CAPlaybackTimeline* timeline)
+{
+    if (timeline != _timeline) {
+        delete _timeline;
+    }
 
-    if (_streamIdx)
-        delete[] _streamIdx;
+    _timeline = timeline;
 }
 
 /*!
@@ -113,7 +139,18 @@ CAPlayback::~CAPlayback()
  */
 void CAPlayback::playImmediately(QList<CAMusElement*> elts, int port)
 {
-    _selection << elts;
+    // the playback thread doesn't touch the score, so the notes may be deleted anytime
+    for (int i = 0; i < elts.size(); i++) {
+        if (elts[i]->musElementType() == CAMusElement::Note) {
+            CANote* note = static_cast<CANote*>(elts[i]);
+            CAImmediateNote n;
+            n.channel = note->voice()->midiChannel();
+            n.program = note->voice()->midiProgram();
+            n.pitch = static_cast<unsigned char>(CADiatonicPitch::diatonicPitchToMidiPitch(note->diatonicPitch()) + note->voice()->midiPitchOffset());
+            n.length = note->timeLength() * 4;
+            _selection.push(n);
+        }
+    }
 
     midiDevice()->openOutputPort(port);
 
@@ -122,6 +159,32 @@ void CAPlayback::playImmediately(QList<CAMusElement*> elts, int port)
     }
 }
 
+/*!
+	Returns the list of currently playing notes and rests.
+
+	The playback thread only sends the notifications about the started and finished
+	elements through a lock-free queue. They are applied here, so this function should
+	only be called from the thread which created the playback (usually the GUI thread),
+	eg. on its repaint timer.
+*/
+QList<CAPlayable*>& CAPlayback::curPlaying()
+{
+    if (_notificationsLost.exchange(false)) {
+        _curPlaying.clear(); // the queue overflowed, start over with the following notifications
+    }
+
+    CAPlaybackNotification n;
+    while (_notifications.pop(n)) {
+        if (n.started) {
+            _curPlaying << n.playable;
+        } else {
+            _curPlaying.removeOne(n.playable);
+        }
+    }
+
+    return _curPlaying;
+}
+
 void CAPlayback::run()
 {
     if (_playSelectionOnly) {
@@ -129,145 +192,210 @@ void CAPlayback::run()
         return;
     }
 
-    // list of all the music element lists (ie. streams) taken from all the contexts
-    QList<QList<CAMusElement*>> stream;
-    QVector<unsigned char> message; // midi 3-byte message sent to midi device
-
-    // initializes all the streams, indices, repeat barlines etc.
-    if (!streamList().size()) {
-        initStreams(sheet());
-    }
+    compileTimeline();
+    setStop(false);
+
+    const QVector<CAPlaybackEvent>& events = _timeline->events();
+    int startTime = _timeline->playbackTime(getInitTimeStart());
+    int i = _timeline->indexAt(startTime);
+    restoreState(i);
+
+    // deadlines are absolute from the start, so the scheduling errors don't accumulate
+    _lateness = CAPlaybackLateness();
+    qint64 startUsec = (i < events.size() ? events[i].usec : 0);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (; i < events.size() && !_stop; i++) {
+        if (midiDevice()->isRealTime()) {
+            std::chrono::steady_clock::time_point deadline = start + std::chrono::microseconds(events[i].usec - startUsec);
+            if (!waitUntil(deadline)) {
+                break; // stopped while waiting
+            }
 
-    if (!streamList().size())
-        stop();
-    else
-        setStop(false);
-
-    int minLength = -1;
-    int mSeconds = 0; // actual song time, used when creating a midi file
-    while (!_stop || _curPlaying.size()) { // at stop true: enter to switch all notes off
-        for (int i = 0; i < _curPlaying.size(); i++) {
-            if (_stop || _curPlaying[i]->timeEnd() <= _curTime) {
-                // note off
-                CANote* note = dynamic_cast<CANote*>(_curPlaying[i]);
-                if (note) {
-                    message << (128 + note->voice()->midiChannel()); // note off
-                    message << static_cast<uchar>(CADiatonicPitch::diatonicPitchToMidiPitch(note->diatonicPitch()) + note->voice()->midiPitchOffset());
-                    message << (127);
-                    if ((note->musElementType() != CAMusElement::Rest) && // first because rest has no tie
-                        !(note->tieStart() && note->tieStart()->noteEnd()))
-                        midiDevice()->send(message, _curTime);
-                    message.clear();
-                }
-                _curPlaying.removeAt(i--);
+            qint64 lateness = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - deadline).count();
+            if (!_lateness.events) {
+                _lateness.first = lateness;
             }
+            _lateness.last = lateness;
+            _lateness.events++;
+            _lateness.total += lateness;
+            _lateness.max = qMax(_lateness.max, lateness);
         }
 
-        for (int i = 0; i < streamList().size(); i++) {
-            loopUntilPlayable(i);
+        dispatch(events[i], events[i].time - startTime);
+    }
+
+    if (_lateness.events) {
+        emit latenessMeasured(_lateness);
+    }
+
+    stopSounding();
+    stop();
+}
+
+/*!
+	Sleeps until the given \a deadline of the monotonic clock.
+	The sleep is interrupted in short steps to check whether the playback was stopped.
+	Returns False, if the playback was stopped, otherwise True.
+*/
+bool CAPlayback::waitUntil(std::chrono::steady_clock::time_point deadline)
+{
+    const std::chrono::milliseconds step(50);
+    while (!_stop) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return true;
         }
 
-        if (_stop)
-            continue; // no notes on anymore
-
-        minLength = -1;
-        for (int i = 0; i < streamList().size(); i++) {
-
-            while (streamAt(i).size() > streamIdx(i) && streamAt(i).at(streamIdx(i))->timeStart() == _curTime) {
-
-                // check if a rest carries a tempo mark
-                CAMusElement* me = streamAt(i).at(streamIdx(i));
-                if (me->musElementType() == CAMusElement::Rest) {
-                    for (int j = 0; j < me->markList().size(); j++) {
-                        if (me->markList()[j]->markType() == CAMark::Tempo) {
-                            CATempo* tempo = static_cast<CATempo*>(me->markList()[j]);
-                            midiDevice()->sendMetaEvent(_curTime, CAMidiDevice::Meta_Tempo, static_cast<char>(tempo->bpm()), 0, 0);
-                        }
-                    }
-                }
-
-                // note on
-
-                CANote* note = dynamic_cast<CANote*>(streamAt(i).at(streamIdx(i)));
-                if (note) {
-                    QVector<unsigned char> message;
-
-                    // send dynamic information
-                    for (int j = 0; j < note->markList().size(); j++) {
-                        if (note->markList()[j]->markType() == CAMark::Dynamic) {
-                            message << (176 + note->voice()->midiChannel()); // set volume
-                            message << (CAMidiDevice::Midi_Ctl_Volume /* 7 */);
-                            message << static_cast<uchar>(qRound(127 * static_cast<CADynamic*>(note->markList()[j])->volume() / 100.0));
-                            midiDevice()->send(message, _curTime);
-                            message.clear();
-                        } else if (note->markList()[j]->markType() == CAMark::InstrumentChange) {
-                            message << (192 + note->voice()->midiChannel()); // change program
-                            message << static_cast<unsigned char>(static_cast<CAInstrumentChange*>(note->markList()[j])->instrument());
-                            midiDevice()->send(message, _curTime);
-                            message.clear();
-                        } else if (note->markList()[j]->markType() == CAMark::Tempo) {
-                            updateSleepFactor(static_cast<CATempo*>(note->markList()[j]));
-                            CATempo* tempo = static_cast<CATempo*>(note->markList()[j]);
-                            midiDevice()->sendMetaEvent(_curTime, CAMidiDevice::Meta_Tempo, tempo->bpm(), 0, 0);
-                        }
-                    }
-
-                    message << (144 + note->voice()->midiChannel()); // note on
-                    message << static_cast<uchar>(CADiatonicPitch::diatonicPitchToMidiPitch(note->diatonicPitch()) + note->voice()->midiPitchOffset());
-                    message << (127);
-                    if (!note->tieEnd())
-                        midiDevice()->send(message, _curTime);
-                    message.clear();
-                }
-
-                if (streamAt(i).at(streamIdx(i))->isPlayable()) {
-                    _curPlaying << static_cast<CAPlayable*>(streamAt(i).at(streamIdx(i)));
-                }
-
-                int delta;
-                if ((delta = (streamAt(i).at(streamIdx(i))->timeEnd() - _curTime)) < minLength
-                    || minLength == -1)
-                    minLength = delta;
-
-                streamIdx(i)++;
-            }
+        std::chrono::steady_clock::time_point wakeUp = (deadline - now > step ? now + step : deadline);
+#ifdef Q_OS_LINUX
+        // steady_clock is CLOCK_MONOTONIC, sleep to the absolute time with the sub-millisecond precision
+        std::chrono::nanoseconds ns = std::chrono::duration_cast<std::chrono::nanoseconds>(wakeUp.time_since_epoch());
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(ns.count() / 1000000000);
+        ts.tv_nsec = static_cast<long>(ns.count() % 1000000000);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+            ;
+#else
+        std::this_thread::sleep_until(wakeUp);
+#endif
+    }
+
+    return false;
+}
 
-            // calculate the pause needed by msleep
-            // last playables in the stream - _curPlaying is otherwise always set!
-            // pre-last pass, set minLength to their timeLengths to stop the notes
-            for (int j = 0; j < _curPlaying.size(); j++) {
-                if ((_curPlaying[j]->timeEnd() - _curTime) < minLength || minLength == -1)
-                    minLength = _curPlaying[j]->timeEnd() - _curTime;
+/*!
+	Renders the playback offline in the current thread. All the events are sent to the
+	midi device in a single pass without waiting, each with its time relative to the start.
+	This is used for writing the events to a file or to a software synthesizer.
+
+	The rendering starts at getInitTimeStart() and finishes at getTimeEnd(). If a selection
+	was set by setRenderSelection(), only the notes of the selected elements are rendered
+	from the start of the first to the end of the last selected element.
+	The programs, volumes and tempo in effect at the start are sent first.
+*/
+void CAPlayback::render()
+{
+    compileTimeline();
+
+    int timeStart = getInitTimeStart();
+    int timeEnd = getTimeEnd();
+    QSet<CAPlayable*> selected;
+    if (!_renderSelection.isEmpty()) {
+        timeStart = -1;
+        for (int i = 0; i < _renderSelection.size(); i++) {
+            if (_renderSelection[i]->isPlayable()) {
+                selected << static_cast<CAPlayable*>(_renderSelection[i]);
+                timeStart = (timeStart == -1 ? _renderSelection[i]->timeStart() : qMin(timeStart, _renderSelection[i]->timeStart()));
+                timeEnd = qMax(timeEnd, _renderSelection[i]->timeEnd());
             }
         }
+        if (selected.isEmpty()) {
+            return;
+        }
+    }
+
+    const QVector<CAPlaybackEvent>& events = _timeline->events();
+    int startTime = _timeline->playbackTime(timeStart);
+    int endTime = (timeEnd < 0 ? -1 : _timeline->playbackTime(timeEnd));
+    int i = _timeline->indexAt(startTime);
+    restoreState(i);
 
-        if (minLength == -1) {
-            // last pass, notes indices are at the ends and no notes are played anymore
-            setStop(true);
+    for (; i < events.size() && (endTime < 0 || events[i].time < endTime || (events[i].time == endTime && events[i].isNoteOff())); i++) {
+        const CAPlaybackEvent& e = events[i];
+        if (e.type == CAPlaybackEvent::PlayableStart || e.type == CAPlaybackEvent::PlayableEnd) {
+            continue;
+        }
+        if (selected.size() && (e.isNoteOn() || e.isNoteOff()) && !selected.contains(e.playable)) {
+            continue;
         }
 
-        if (minLength != -1) {
-            mSeconds += qRound(minLength * _sleepFactor);
+        dispatch(e, e.time - startTime);
+    }
+
+    _curTime = (endTime < 0 ? _curTime : endTime - startTime);
+    stopSounding();
+}
 
-            if (midiDevice()->isRealTime())
-                msleep(static_cast<ulong>(qRound(minLength * _sleepFactor)));
+/*!
+	Takes the snapshot of the sheet timeline, if none was set. Only the parts of the sheet
+	changed since the last snapshot are compiled.
+*/
+void CAPlayback::compileTimeline()
+{
+    if (!_timeline && sheet()) {
+        _timeline = sheet()->playbackTimeline()->snapshot();
+    }
+}
 
-            _curTime += minLength;
+/*!
+	Sends the programs, volumes and tempo set by the events before the given \a index.
+*/
+void CAPlayback::restoreState(int index)
+{
+    const QVector<CAPlaybackEvent>& events = _timeline->events();
+    for (int j = 0; j < index; j++) {
+        if (events[j].type != CAPlaybackEvent::PlayableStart && events[j].type != CAPlaybackEvent::PlayableEnd
+            && !events[j].isNoteOn() && !events[j].isNoteOff()) {
+            dispatch(events[j], 0);
         }
     }
+}
 
-    _curPlaying.clear();
-    stop();
+/*!
+	Switches off the notes which are still sounding.
+*/
+void CAPlayback::stopSounding()
+{
+    for (int j = 0; j < _curSounding.size(); j++) {
+        unsigned char message[3] = { static_cast<unsigned char>(128 + ((_curSounding[j] >> 8) & 0x0f)), static_cast<unsigned char>(_curSounding[j] & 0xff), 127 }; // note off
+        midiDevice()->setTrack(_curSounding[j] >> 12);
+        midiDevice()->send(message, 3, _curTime);
+    }
+
+    _curSounding.clear();
 }
 
 /*!
-	Calculates the sleep factor for the given tempo \a t.
-	If \a t is null, it does nothing.
- */
-void CAPlayback::updateSleepFactor(CATempo* t)
+	Sends the given playback event \a e at the given \a time to the midi device or notifies
+	the GUI about the currently playing elements.
+*/
+void CAPlayback::dispatch(const CAPlaybackEvent& e, int time)
 {
-    if (t) {
-        _sleepFactor = 60000.0f / (CAPlayableLength::playableLengthToTimeLength(t->beat()) * t->bpm());
+    _curTime = time;
+
+    switch (e.type) {
+    case CAPlaybackEvent::Midi: {
+        int note = (e.track << 12) | ((e.data[0] & 0x0f) << 8) | e.data[1];
+        if (e.isNoteOn()) {
+            _curSounding << note;
+        } else if (e.isNoteOff()) {
+            _curSounding.removeOne(note);
+        }
+
+        midiDevice()->setTrack(e.track);
+        midiDevice()->send(e.data, e.size, time);
+        break;
+    }
+    case CAPlaybackEvent::Tempo:
+        midiDevice()->sendMetaEvent(time, CAMidiDevice::Meta_Tempo, static_cast<char>(qMin(qRound(60000000.0 / e.value), 127)), 0, e.value);
+        break;
+    case CAPlaybackEvent::TimeSignature:
+        midiDevice()->sendMetaEvent(time, CAMidiDevice::Meta_Timesig, e.data[0], e.data[1], 0);
+        break;
+    case CAPlaybackEvent::KeySignature:
+        midiDevice()->sendMetaEvent(time, CAMidiDevice::Meta_Keysig, e.data[0], e.data[1], 0);
+        break;
+    case CAPlaybackEvent::PlayableStart:
+    case CAPlaybackEvent::PlayableEnd: {
+        // never block the playback thread, rather lose the notification
+        CAPlaybackNotification n;
+        n.playable = e.playable;
+        n.started = (e.type == CAPlaybackEvent::PlayableStart);
+        if (!_notifications.push(n)) {
+            _notificationsLost = true;
+        }
+        break;
+    }
     }
 }
 
@@ -281,57 +409,36 @@ void CAPlayback::updateSleepFactor(CATempo* t)
  */
 void CAPlayback::playSelectionImpl()
 {
-    QVector<unsigned char> message;
+    QList<CAImmediateNote> playing;
     QList<int> timeEnds; // time ends when the notes should turned off
     int waitTime = 16;
     int curTime = 0;
 
-    while (_selection.size() || _curPlaying.size()) {
-        while (_selection.size()) {
-            if (_selection[0]->musElementType() != CAMusElement::Note) {
-                _selection.takeFirst();
-                continue;
-            }
+    while (!_selection.isEmpty() || playing.size()) {
+        CAImmediateNote note;
+        while (_selection.pop(note)) {
+            // Note ON
+            unsigned char program[2] = { static_cast<unsigned char>(192 + note.channel), note.program }; // change program
+            midiDevice()->send(program, 2, _curTime);
 
-            CANote* note = static_cast<CANote*>(_selection.takeFirst());
+            unsigned char volume[3] = { static_cast<unsigned char>(176 + note.channel), 7, 100 }; // set volume
+            midiDevice()->send(volume, 3, _curTime);
 
-            // Note ON
-            message << (192 + note->voice()->midiChannel()); // change program
-            message << (note->voice()->midiProgram());
-            midiDevice()->send(message, _curTime);
-            message.clear();
-
-            message << (176 + note->voice()->midiChannel()); // set volume
-            message << (7);
-            message << (100);
-            midiDevice()->send(message, _curTime);
-            message.clear();
-
-            message << (144 + note->voice()->midiChannel()); // note on
-            message << static_cast<uchar>(CADiatonicPitch::diatonicPitchToMidiPitch(note->diatonicPitch()) + note->voice()->midiPitchOffset());
-            message << (127);
-            midiDevice()->send(message, _curTime);
-            message.clear();
-
-            _curPlaying << note;
-            timeEnds << curTime + note->timeLength() * 4;
+            unsigned char noteOn[3] = { static_cast<unsigned char>(144 + note.channel), note.pitch, 127 }; // note on
+            midiDevice()->send(noteOn, 3, _curTime);
+
+            playing << note;
+            timeEnds << curTime + note.length;
         }
 
-        for (int i = 0; i < _curPlaying.size(); i++) {
+        for (int i = 0; i < playing.size(); i++) {
             if (curTime >= timeEnds[i] || _stop) {
                 // Note OFF
-                if (_curPlaying[i]->musElementType() == CAMusElement::Note) {
-                    CANote* note = static_cast<CANote*>(_curPlaying[i]);
-
-                    message << (128 + note->voice()->midiChannel()); // note off
-                    message << static_cast<uchar>(CADiatonicPitch::diatonicPitchToMidiPitch(note->diatonicPitch()) + note->voice()->midiPitchOffset());
-                    message << (127);
-                    midiDevice()->send(message, _curTime);
-                    message.clear();
-                }
+                unsigned char noteOff[3] = { static_cast<unsigned char>(128 + playing[i].channel), playing[i].pitch, 127 }; // note off
+                midiDevice()->send(noteOff, 3, _curTime);
 
                 timeEnds.removeAt(i);
-                _curPlaying.removeAt(i);
+                playing.removeAt(i);
                 i--;
             }
         }
@@ -374,95 +481,3 @@ void CAPlayback::stopNow()
     setStopLock(false);
     emit playbackFinished();
 }
-
-/*!
-	Generates streams (elements lists) of playable elements (notes, rests) from the given sheet.
-*/
-void CAPlayback::initStreams(CASheet* sheet)
-{
-    for (int i = 0; i < sheet->contextList().size(); i++) {
-        if (sheet->contextList()[i]->contextType() == CAContext::Staff) {
-            CAStaff* staff = static_cast<CAStaff*>(sheet->contextList()[i]);
-            // add all the voices lists to the common list stream
-            for (int j = 0; j < staff->voiceList().size(); j++) {
-                _streamList << staff->voiceList()[j]->musElementList();
-
-                QVector<unsigned char> message;
-                message << (192 + staff->voiceList()[j]->midiChannel()); // change program
-                message << (staff->voiceList()[j]->midiProgram());
-                midiDevice()->send(message, _curTime);
-                message.clear();
-
-                message << (176 + staff->voiceList()[j]->midiChannel()); // set volume
-                message << (7);
-                message << (100);
-                midiDevice()->send(message, _curTime);
-                message.clear();
-            }
-        }
-    }
-    _streamIdx = new int[streamList().size()];
-    _lastRepeatOpenIdx = new int[streamList().size()];
-
-    // init streams indices, current times and last repeat barlines
-    for (int i = 0; i < streamList().size(); i++) {
-        _curTime = getInitTimeStart();
-        streamIdx(i) = 0;
-        lastRepeatOpenIdx(i) = -1;
-        _repeating = false;
-        loopUntilPlayable(i, true); // ignore repeats
-    }
-
-    if (_sheet) {
-        updateSleepFactor(_sheet->getTempo(getInitTimeStart()));
-    }
-}
-
-/*!
-	Loops from the stream with the given index \a i until the last element with smaller or equal start time of the current time.
-	This function also remembers any special signs like open repeat barlines.
-*/
-void CAPlayback::loopUntilPlayable(int i, bool ignoreRepeats)
-{
-    for (int j = streamIdx(i);
-         j < streamAt(i).size() && streamAt(i).at(j)->timeStart() <= _curTime && (streamAt(i).at(j)->timeStart() != _curTime || !(streamAt(i).at(j)->musElementType() == CAMusElement::Note) || (static_cast<CANote*>(streamAt(i).at(j))->isFirstInChord()));
-         streamIdx(i) = j++) {
-
-        if (streamAt(i).at(j)->musElementType() == CAMusElement::TimeSignature) {
-
-            int beats = static_cast<CATimeSignature*>(streamAt(i).at(j))->beats();
-            int beat = static_cast<CATimeSignature*>(streamAt(i).at(j))->beat();
-            //std::cout<<"  exportiere Time Signature    "<<_curTime<<" mit "<<beats<<"/"<<beat<<std::endl;
-            midiDevice()->sendMetaEvent(_curTime, CAMidiDevice::Meta_Timesig, beats, beat, 0);
-        }
-        if (streamAt(i).at(j)->musElementType() == CAMusElement::KeySignature) {
-            //int key = (static_cast<CAKeySignature*>(streamAt(i).at(j)))->diatonicKey()->numberOfAccs();
-            CAKeySignature* ks = dynamic_cast<CAKeySignature*>(streamAt(i).at(j));
-            CADiatonicKey dk = ks->diatonicKey();
-            int key = dk.numberOfAccs();
-            int minor = dk.gender() == CADiatonicKey::Minor ? 1 : 0;
-            midiDevice()->sendMetaEvent(_curTime, CAMidiDevice::Meta_Keysig, key, minor, 0);
-        }
-
-        if (streamAt(i).at(j)->musElementType() == CAMusElement::Barline && static_cast<CABarline*>(streamAt(i).at(j))->barlineType() == CABarline::RepeatOpen) {
-            lastRepeatOpenIdx(i) = j;
-        }
-
-        if (streamAt(i).at(j)->musElementType() == CAMusElement::Barline && static_cast<CABarline*>(streamAt(i).at(j))->barlineType() == CABarline::RepeatClose && !ignoreRepeats) {
-            if (!_repeating) {
-                // set the new index in ALL streams
-                for (int k = 0; k < streamList().size(); k++) {
-                    streamIdx(k) = lastRepeatOpenIdx(k) + 1;
-                }
-
-                _curTime = streamAt(i).at(streamIdx(i))->timeStart();
-                j = streamIdx(i);
-                _repeating = true;
-            }
-        }
-    }
-
-    // last element if non-playable is exception - increase the index counter
-    if (streamIdx(i) == streamAt(i).size() - 1 && !streamAt(i).at(streamIdx(i))->isPlayable())
-        streamIdx(i)++;
-}
@@ -9,14 +9,38 @@
 #define PLAYBACK_H_
 
 #include <QList>
+#include <QMetaType>
 #include <QThread>
 
+#include <atomic>
+#include <chrono>
+
+#include "core/ringbuffer.h"
+
 class CAMidiDevice;
 class CASheet;
 class CAMusElement;
 class CAPlayable;
-class CANote;
-class CATempo;
+class CAPlaybackTimeline;
+struct CAPlaybackEvent;
+
+/*!
+	Lateness of the events dispatched by the last playback in microseconds.
+	The drift is the change of the lateness from the first to the last event.
+*/
+struct CAPlaybackLateness {
+    int events = 0;
+    qint64 total = 0;
+    qint64 max = 0;
+    qint64 first = 0;
+    qint64 last = 0;
+
+    inline qint64 average() const { return events ? total / events : 0; }
+    inline qint64 drift() const { return last - first; }
+};
+#ifndef SWIG
+Q_DECLARE_METATYPE(CAPlaybackLateness)
+#endif
 
 class CAPlayback : public QThread {
 #ifndef SWIG
@@ -28,16 +52,24 @@ public:
     ~CAPlayback();
 
     void run();
+    void render();
     void stop();
 
     void playImmediately(QList<CAMusElement*> elts, int port);
 
     inline int getInitTimeStart() { return _initTimeStart; }
     inline void setInitTimeStart(int t) { _initTimeStart = t; }
+    inline int getTimeEnd() { return _timeEnd; }
+    inline void setTimeEnd(int t) { _timeEnd = t; }
+    inline const QList<CAMusElement*>& renderSelection() { return _renderSelection; }
+    inline void setRenderSelection(const QList<CAMusElement*>& elts) { _renderSelection = elts; }
     inline CAMidiDevice* midiDevice() { return _midiDevice; }
     inline CASheet* sheet() { return _sheet; }
-    inline void setSheet(CASheet* s) { _sheet = s; }
-    inline QList<CAPlayable*>& curPlaying() { return _curPlaying; }
+    void setSheet(CASheet* s);
+    inline CAPlaybackTimeline* timeline() { return _timeline; }
+    void setTimeline(CAPlaybackTimeline* timeline);
+    QList<CAPlayable*>& curPlaying();
+    inline const CAPlaybackLateness& lateness() { return _lateness; }
 
 #ifndef SWIG
 public slots:
@@ -49,19 +81,19 @@ public:
 #ifndef SWIG
 signals:
     void playbackFinished();
+    void latenessMeasured(const CAPlaybackLateness& lateness);
 #endif
 
 private:
     void initPlayback();
-    void initStreams(CASheet* sheet);
-    void loopUntilPlayable(int i, bool ignoreRepeats = false);
     void playSelectionImpl();
-    void updateSleepFactor(CATempo* t);
-
-    inline QList<CAMusElement*>& streamAt(int idx) { return _streamList[idx]; }
-    inline const QList<QList<CAMusElement*>>& streamList() { return _streamList; }
-    inline int& streamIdx(int i) { return _streamIdx[i]; }
-    inline int& lastRepeatOpenIdx(int i) { return _lastRepeatOpenIdx[i]; }
+    void compileTimeline();
+    void restoreState(int index);
+    void stopSounding();
+    void dispatch(const CAPlaybackEvent& e, int time);
+#ifndef SWIG
+    bool waitUntil(std::chrono::steady_clock::time_point deadline);
+#endif
 
     inline bool stopLock() { return _stopLock; }
     inline void setStopLock(bool lock) { _stopLock = lock; }
@@ -72,20 +104,40 @@ private:
     inline void setMidiDevice(CAMidiDevice* d) { _midiDevice = d; }
 
     inline void setStop(bool stop) { _stop = stop; }
-    bool _stop;
+    std::atomic<bool> _stop;
     bool _stopLock;
 
+#ifndef SWIG
+    struct CAImmediateNote {
+        unsigned char channel;
+        unsigned char program;
+        unsigned char pitch;
+        int length;
+    };
+
+    struct CAPlaybackNotification {
+        CAPlayable* playable;
+        bool started;
+    };
+#endif
+
     bool _playSelectionOnly;
-    QList<CAMusElement*> _selection;
+#ifndef SWIG
+    CARingBuffer<CAImmediateNote, 256> _selection; // notes to play immediately, filled by playImmediately()
+#endif
 
     int _initTimeStart;
-    float _sleepFactor;
+    int _timeEnd; // -1 for the end of the sheet
+    QList<CAMusElement*> _renderSelection; // only these elements are rendered offline
 
-    QList<QList<CAMusElement*>> _streamList;
-    QList<CAPlayable*> _curPlaying; // list of currently playing notes and rests
-    int* _streamIdx;
-    bool _repeating;
-    int* _lastRepeatOpenIdx;
+    CAPlaybackTimeline* _timeline; // snapshot of the sheet timeline, owned by the playback
+    QList<CAPlayable*> _curPlaying; // list of currently playing notes and rests, owned by the GUI thread
+#ifndef SWIG
+    CARingBuffer<CAPlaybackNotification, 4096> _notifications; // started and finished playables sent by the playback thread
+#endif
+    std::atomic<bool> _notificationsLost;
+    QList<int> _curSounding; // track, channel and pitch of the currently sounding midi notes
+    CAPlaybackLateness _lateness;
     int _curTime;
 };
 
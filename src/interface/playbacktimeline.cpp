@@ -0,0 +1,662 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <algorithm>
+
+#include "interface/playbacktimeline.h"
+#include "score/barline.h"
+#include "score/dynamic.h"
+#include "score/instrumentchange.h"
+#include "score/keysignature.h"
+#include "score/mark.h"
+#include "score/note.h"
+#include "score/playable.h"
+#include "score/playablelength.h"
+#include "score/repeatmark.h"
+#include "score/sheet.h"
+#include "score/slur.h"
+#include "score/staff.h"
+#include "score/tempo.h"
+#include "score/tempomap.h"
+#include "score/timesignature.h"
+#include "score/voice.h"
+
+/*!
+	\class CAPlaybackTimeline
+	\brief Precompiled playback events of the sheet
+
+	This class compiles the sheet into a single flat array of timestamped events sorted by
+	time. Repeats and voltas are expanded and every event has its absolute real time in
+	microseconds resolved from the tempo map of the sheet. CAPlayback only dispatches the events from
+	this array, either in real time or rendered offline, eg. by CAMidiExport into the midi file tracks.
+
+	Voices are compiled independently of each other in parallel. Compiled events of each
+	voice are kept in the score time, so after an edit only the changed range of the voice
+	needs to be recompiled by calling update(). Repeats and the tempo map are then resolved
+	again over the whole sheet, which is cheap.
+
+	Every sheet keeps its timeline, see CASheet::playbackTimeline(). The score model reports
+	the changed ranges of the voices by calling invalidate() when the elements, marks or ties
+	change, and the next update() recompiles only those ranges. The timeline is shared by the
+	GUI, playback and export threads, so they play and export its snapshot():
+
+	\code
+	  std::unique_ptr<CAPlaybackTimeline> timeline(sheet->playbackTimeline()->snapshot());
+	  for (const CAPlaybackEvent& e : timeline->events()) {
+	      ...
+	  }
+	\endcode
+
+	\sa CAPlayback, CAPlaybackEvent
+*/
+
+/*!
+	Ritardandos and accellerandos are written as a tempo event every sixteenth.
+*/
+const int CAPlaybackTimeline::TEMPO_RAMP_STEP = 64;
+
+namespace {
+class CAPlaybackTimelineJob : public QRunnable {
+public:
+    CAPlaybackTimelineJob(CAVoice* voice, bool signs, QVector<CAPlaybackEvent>* events)
+        : _voice(voice)
+        , _signs(signs)
+        , _events(events)
+    {
+    }
+
+    void run() { *_events = CAPlaybackTimeline::compileVoice(_voice, 0, -1, _signs); }
+
+private:
+    CAVoice* _voice;
+    bool _signs;
+    QVector<CAPlaybackEvent>* _events;
+};
+
+bool scoreTimeLessThan(const CAPlaybackEvent& a, const CAPlaybackEvent& b)
+{
+    return a.scoreTime < b.scoreTime || (a.scoreTime == b.scoreTime && a.order < b.order);
+}
+
+bool isEnd(const CAPlaybackEvent& e)
+{
+    return e.isNoteOff() || e.type == CAPlaybackEvent::PlayableEnd;
+}
+
+int firstIndexAt(const QList<CAMusElement*>& elts, int time)
+{
+    return std::lower_bound(elts.begin(), elts.end(), time, [](CAMusElement* elt, int t) { return elt->timeStart() < t; }) - elts.begin();
+}
+}
+
+CAPlaybackTimeline::CAPlaybackTimeline(CASheet* sheet)
+    : _sheet(sheet)
+    , _valid(false)
+{
+}
+
+/*!
+	Copies the compiled events of the \a other timeline. The containers are implicitly
+	shared, so the copy is cheap. Called with the mutex of \a other locked, see snapshot().
+*/
+CAPlaybackTimeline::CAPlaybackTimeline(const CAPlaybackTimeline& other)
+    : _sheet(other._sheet)
+    , _voices(other._voices)
+    , _voiceEvents(other._voiceEvents)
+    , _segments(other._segments)
+    , _events(other._events)
+    , _valid(other._valid)
+{
+}
+
+CAPlaybackTimeline::~CAPlaybackTimeline()
+{
+}
+
+/*!
+	Compiles the whole sheet.
+*/
+void CAPlaybackTimeline::compile()
+{
+    QMutexLocker locker(&_mutex);
+    compileImpl();
+}
+
+/*!
+	Recompiles the ranges of the voices changed since the last update. The whole sheet is
+	compiled, if it wasn't compiled yet or the voices were added or removed.
+*/
+void CAPlaybackTimeline::update()
+{
+    QMutexLocker locker(&_mutex);
+    if (!_valid || !sheet() || sheet()->voiceList() != _voices) {
+        compileImpl();
+        return;
+    }
+    if (_changes.isEmpty()) {
+        return;
+    }
+
+    for (QHash<CAVoice*, int>::const_iterator i = _changes.constBegin(); i != _changes.constEnd(); i++) {
+        updateImpl(i.key(), i.value(), -1);
+    }
+    _changes.clear();
+
+    compileSegments();
+    expand();
+}
+
+/*!
+	Brings the timeline up to date and returns its copy owned by the caller. The copy is not
+	changed by the following edits and it shares the events with this timeline until they
+	change, so taking it is cheap. Use the snapshot to play or export the sheet in another
+	thread.
+*/
+CAPlaybackTimeline* CAPlaybackTimeline::snapshot()
+{
+    update();
+
+    QMutexLocker locker(&_mutex);
+    return new CAPlaybackTimeline(*this);
+}
+
+/*!
+	Marks the whole timeline as changed. The sheet is compiled again on the next update().
+*/
+void CAPlaybackTimeline::invalidate()
+{
+    QMutexLocker locker(&_mutex);
+    _valid = false;
+    _changes.clear();
+}
+
+/*!
+	Marks the given \a voice as changed from \a timeStart on. Nothing happens, if the sheet
+	wasn't compiled yet.
+*/
+void CAPlaybackTimeline::invalidateVoice(CAVoice* voice, int timeStart)
+{
+    QMutexLocker locker(&_mutex);
+    if (_valid) {
+        _changes[voice] = (_changes.contains(voice) ? qMin(_changes[voice], timeStart) : timeStart);
+    }
+}
+
+/*!
+	Marks the given \a voice as changed from \a timeStart on in the timeline of its sheet.
+	Called by the score model when the voice changes.
+*/
+void CAPlaybackTimeline::invalidate(CAVoice* voice, int timeStart)
+{
+    if (voice && voice->staff() && voice->staff()->sheet()) {
+        voice->staff()->sheet()->playbackTimeline()->invalidateVoice(voice, qMax(timeStart, 0));
+    }
+}
+
+/*!
+	Marks the voice of the given \a elt as changed from the element on in the timeline of its
+	sheet. Shared elements (eg. barlines, signatures) change all the voices of the staff.
+	Called by the score model when the element or its marks change.
+*/
+void CAPlaybackTimeline::invalidate(CAMusElement* elt)
+{
+    if (!elt || !elt->context() || elt->context()->contextType() != CAContext::Staff) {
+        return;
+    }
+
+    if (elt->isPlayable()) {
+        invalidate(static_cast<CAPlayable*>(elt)->voice(), elt->timeStart());
+    } else {
+        for (CAVoice* voice : static_cast<CAStaff*>(elt->context())->voiceList()) {
+            invalidate(voice, elt->timeStart());
+        }
+    }
+}
+
+/*!
+	Compiles the whole sheet. The mutex must be locked.
+*/
+void CAPlaybackTimeline::compileImpl()
+{
+    _valid = true;
+    _changes.clear();
+    _voices.clear();
+    _voiceEvents.clear();
+    if (!sheet()) {
+        _segments.clear();
+        _events.clear();
+        return;
+    }
+
+    _voices = sheet()->voiceList();
+    QVector<QVector<CAPlaybackEvent>> compiled(_voices.size());
+    QThreadPool pool;
+    for (int i = 0; i < _voices.size(); i++) {
+        pool.start(new CAPlaybackTimelineJob(_voices[i], i == 0, &compiled[i]));
+    }
+    pool.waitForDone();
+
+    for (int i = 0; i < _voices.size(); i++) {
+        _voiceEvents[_voices[i]] = compiled[i];
+    }
+
+    compileSegments();
+    expand();
+}
+
+/*!
+	Recompiles the music elements of the given \a voice starting in the range from
+	\a timeStart to \a timeEnd. If \a timeEnd is -1, the voice is recompiled until the end.
+	Call this after changing the voice. If the lengths of the elements changed, the times
+	of all the following elements changed as well, so \a timeEnd should be -1.
+
+	If the voice was added to or removed from the sheet, the whole sheet is recompiled.
+*/
+void CAPlaybackTimeline::update(CAVoice* voice, int timeStart, int timeEnd)
+{
+    QMutexLocker locker(&_mutex);
+    if (!_valid || !sheet() || !_voiceEvents.contains(voice) || sheet()->voiceList() != _voices) {
+        compileImpl();
+        return;
+    }
+
+    updateImpl(voice, timeStart, timeEnd);
+    compileSegments();
+    expand();
+}
+
+/*!
+	Recompiles the given range of the \a voice without resolving the repeats and the tempo.
+	The mutex must be locked.
+*/
+void CAPlaybackTimeline::updateImpl(CAVoice* voice, int timeStart, int timeEnd)
+{
+    // extend the range to the whole tied notes crossing its borders
+    const QList<CAMusElement*>& elts = voice->musElementList();
+    int i = firstIndexAt(elts, timeStart);
+    for (int j = i; j < elts.size() && elts[j]->timeStart() == elts[i]->timeStart(); j++) {
+        if (elts[j]->musElementType() == CAMusElement::Note) {
+            CANote* note = static_cast<CANote*>(elts[j]);
+            while (note->tieEnd() && note->tieEnd()->noteStart()) {
+                note = note->tieEnd()->noteStart();
+            }
+            timeStart = qMin(timeStart, note->timeStart());
+        }
+    }
+    if (timeEnd >= 0) {
+        int last = firstIndexAt(elts, timeEnd) - 1;
+        for (int j = last; j >= 0 && elts[j]->timeStart() == elts[last]->timeStart(); j--) {
+            if (elts[j]->musElementType() == CAMusElement::Note) {
+                CANote* note = static_cast<CANote*>(elts[j]);
+                while (note->tieStart() && note->tieStart()->noteEnd()) {
+                    note = note->tieStart()->noteEnd();
+                }
+                timeEnd = qMax(timeEnd, note->timeStart() + 1);
+            }
+        }
+    }
+
+    QVector<CAPlaybackEvent>& events = _voiceEvents[voice];
+    events.erase(std::remove_if(events.begin(), events.end(), [timeStart, timeEnd](const CAPlaybackEvent& e) {
+        return e.origin >= timeStart && (timeEnd < 0 || e.origin < timeEnd);
+    }),
+        events.end());
+
+    int size = events.size();
+    events << compileVoice(voice, timeStart, timeEnd, voice == _voices.first());
+    std::inplace_merge(events.begin(), events.begin() + size, events.end(), scoreTimeLessThan);
+}
+
+/*!
+	Compiles the music elements of the given \a voice starting in the range from \a timeStart
+	to \a timeEnd (-1 for the end of the voice) and returns the events sorted by the score time.
+	Time and key signatures are only compiled, if \a signs is True.
+
+	This function only reads the score, so it can be called for several voices at the
+	same time.
+*/
+QVector<CAPlaybackEvent> CAPlaybackTimeline::compileVoice(CAVoice* voice, int timeStart, int timeEnd, bool signs)
+{
+    const QList<CAMusElement*>& elts = voice->musElementList();
+    QVector<CAPlaybackEvent> events;
+    events.reserve(elts.size() * 4);
+
+    unsigned char channel = voice->midiChannel() & 0x0f;
+    if (timeStart <= 0) {
+        CAPlaybackEvent e = event(CAPlaybackEvent::Midi, 0, 0, 1);
+        e.size = 2;
+        e.data[0] = 0xc0 | channel; // change program
+        e.data[1] = voice->midiProgram();
+        events << e;
+
+        e.size = 3;
+        e.data[0] = 0xb0 | channel; // set volume
+        e.data[1] = 7;
+        e.data[2] = 100;
+        events << e;
+    }
+
+    for (int i = firstIndexAt(elts, timeStart); i < elts.size() && (timeEnd < 0 || elts[i]->timeStart() < timeEnd); i++) {
+        CAMusElement* elt = elts[i];
+        int t = elt->timeStart();
+
+        switch (elt->musElementType()) {
+        case CAMusElement::TimeSignature:
+            if (signs) {
+                CAPlaybackEvent e = event(CAPlaybackEvent::TimeSignature, t, t, 1);
+                e.data[0] = static_cast<unsigned char>(static_cast<CATimeSignature*>(elt)->beats());
+                e.data[1] = static_cast<unsigned char>(static_cast<CATimeSignature*>(elt)->beat());
+                events << e;
+            }
+            break;
+        case CAMusElement::KeySignature:
+            if (signs) {
+                CADiatonicKey dk = static_cast<CAKeySignature*>(elt)->diatonicKey();
+                CAPlaybackEvent e = event(CAPlaybackEvent::KeySignature, t, t, 1);
+                e.data[0] = static_cast<unsigned char>(dk.numberOfAccs());
+                e.data[1] = dk.gender() == CADiatonicKey::Minor ? 1 : 0;
+                events << e;
+            }
+            break;
+        case CAMusElement::Note:
+            compileNote(static_cast<CANote*>(elt), events);
+            break;
+        default:
+            break;
+        }
+
+        if (elt->isPlayable()) {
+            for (CAMark* mark : elt->markList()) {
+                if (mark->markType() == CAMark::Tempo) {
+                    CATempo* tempo = static_cast<CATempo*>(mark);
+                    CAPlaybackEvent e = event(CAPlaybackEvent::Tempo, t, t, 1);
+                    e.value = qRound(60000000.0 * CAPlayableLength::playableLengthToTimeLength(CAPlayableLength::Quarter) / (CAPlayableLength::playableLengthToTimeLength(tempo->beat()) * qMax<int>(tempo->bpm(), 1)));
+                    events << e;
+                }
+            }
+
+            CAPlaybackEvent e = event(CAPlaybackEvent::PlayableStart, t, t, 3);
+            e.playable = static_cast<CAPlayable*>(elt);
+            events << e;
+
+            e = event(CAPlaybackEvent::PlayableEnd, elt->timeEnd(), t, 0);
+            e.playable = static_cast<CAPlayable*>(elt);
+            events << e;
+        }
+    }
+
+    std::stable_sort(events.begin(), events.end(), scoreTimeLessThan);
+    return events;
+}
+
+/*!
+	Compiles the dynamics, instrument changes and the note on and note off events of the
+	given \a note. Tied notes are played as a single note.
+*/
+void CAPlaybackTimeline::compileNote(CANote* note, QVector<CAPlaybackEvent>& events)
+{
+    CAVoice* voice = note->voice();
+    unsigned char channel = voice->midiChannel() & 0x0f;
+    int t = note->timeStart();
+
+    for (CAMark* mark : note->markList()) {
+        if (mark->markType() == CAMark::Dynamic) {
+            CAPlaybackEvent e = event(CAPlaybackEvent::Midi, t, t, 1);
+            e.size = 3;
+            e.data[0] = 0xb0 | channel; // set volume
+            e.data[1] = 7;
+            e.data[2] = static_cast<unsigned char>(qRound(127 * static_cast<CADynamic*>(mark)->volume() / 100.0));
+            events << e;
+        } else if (mark->markType() == CAMark::InstrumentChange) {
+            CAPlaybackEvent e = event(CAPlaybackEvent::Midi, t, t, 1);
+            e.size = 2;
+            e.data[0] = 0xc0 | channel; // change program
+            e.data[1] = static_cast<unsigned char>(static_cast<CAInstrumentChange*>(mark)->instrument());
+            events << e;
+        }
+    }
+
+    unsigned char pitch = static_cast<unsigned char>(CADiatonicPitch::diatonicPitchToMidiPitch(note->diatonicPitch()) + voice->midiPitchOffset());
+
+    if (!note->tieEnd() || !note->tieEnd()->noteStart()) {
+        CANote* last = note;
+        while (last->tieStart() && last->tieStart()->noteEnd()) {
+            last = last->tieStart()->noteEnd();
+        }
+
+        CAPlaybackEvent e = event(CAPlaybackEvent::Midi, t, t, 2);
+        e.size = 3;
+        e.data[0] = 0x90 | channel; // note on
+        e.data[1] = pitch;
+        e.data[2] = 127;
+        e.value = last->timeEnd();
+        e.playable = note;
+        events << e;
+    }
+
+    if (!note->tieStart() || !note->tieStart()->noteEnd()) {
+        CANote* first = note;
+        while (first->tieEnd() && first->tieEnd()->noteStart()) {
+            first = first->tieEnd()->noteStart();
+        }
+
+        CAPlaybackEvent e = event(CAPlaybackEvent::Midi, note->timeEnd(), t, 0);
+        e.size = 3;
+        e.data[0] = 0x80 | channel; // note off
+        e.data[1] = pitch;
+        e.data[2] = 127;
+        e.value = first->timeStart();
+        e.playable = note;
+        events << e;
+    }
+}
+
+CAPlaybackEvent CAPlaybackTimeline::event(CAPlaybackEvent::CAPlaybackEventType type, int time, int origin, int order)
+{
+    CAPlaybackEvent e;
+    e.usec = 0;
+    e.time = time;
+    e.scoreTime = time;
+    e.origin = origin;
+    e.track = 0;
+    e.value = 0;
+    e.playable = nullptr;
+    e.type = static_cast<unsigned char>(type);
+    e.order = static_cast<unsigned char>(order);
+    e.size = 0;
+    e.data[0] = e.data[1] = e.data[2] = 0;
+    return e;
+}
+
+/*!
+	Generates the list of score time segments in the order they are played from the
+	barlines of the first voice. Sections between the repeat barlines are played twice.
+	The first volta is skipped the second time.
+*/
+void CAPlaybackTimeline::compileSegments()
+{
+    _segments.clear();
+
+    int end = 0;
+    for (CAVoice* voice : _voices) {
+        end = qMax(end, voice->lastTimeEnd());
+    }
+
+    int segmentStart = 0;
+    int repeatStart = 0;
+    int voltaStart = -1;
+    if (_voices.size()) {
+        // barlines are shared among the voices of the staff and are aligned in all the staffs
+        for (CAMusElement* elt : _voices.first()->musElementList()) {
+            if (elt->musElementType() != CAMusElement::Barline) {
+                continue;
+            }
+
+            int t = elt->timeStart();
+            for (CAMark* mark : elt->markList()) {
+                if (voltaStart == -1 && mark->markType() == CAMark::RepeatMark
+                    && static_cast<CARepeatMark*>(mark)->repeatMarkType() == CARepeatMark::Volta
+                    && static_cast<CARepeatMark*>(mark)->voltaNumber() <= 1) {
+                    voltaStart = t;
+                }
+            }
+
+            CABarline::CABarlineType type = static_cast<CABarline*>(elt)->barlineType();
+            if (type == CABarline::RepeatClose || type == CABarline::RepeatCloseOpen) {
+                _segments << qMakePair(segmentStart, t);
+                if (voltaStart != -1 && voltaStart > repeatStart) {
+                    // play the repeated section without the first volta
+                    _segments << qMakePair(repeatStart, voltaStart);
+                    segmentStart = t;
+                } else {
+                    segmentStart = repeatStart;
+                }
+                voltaStart = -1;
+            }
+            if (type == CABarline::RepeatOpen || type == CABarline::RepeatCloseOpen) {
+                if (segmentStart < t) {
+                    _segments << qMakePair(segmentStart, t);
+                }
+                segmentStart = repeatStart = t;
+                voltaStart = -1;
+            }
+        }
+    }
+
+    if (segmentStart < end || _segments.isEmpty()) {
+        _segments << qMakePair(segmentStart, end);
+    }
+}
+
+/*!
+	Expands the compiled events of all the voices over the segments, sorts them by the
+	playback time and resolves their real time from the tempo map of the sheet.
+
+	Tempo events are generated from the tempo map at the start of every segment and at
+	every tempo change, so the tempo is correct after jumping back to the repeat and the
+	ritardandos are approximated in steps of TEMPO_RAMP_STEP.
+*/
+void CAPlaybackTimeline::expand()
+{
+    _events.clear();
+
+    CATempoMap* tempoMap = sheet()->tempoMap();
+    const int quarter = CAPlayableLength::playableLengthToTimeLength(CAPlayableLength::Quarter);
+
+    int offset = 0;
+    qint64 segmentUsec = 0;
+    for (int s = 0; s < _segments.size(); s++) {
+        int start = _segments[s].first;
+        int end = _segments[s].second;
+        bool continuedBefore = s > 0 && _segments[s - 1].second == start;
+        bool continuedAfter = s + 1 < _segments.size() && _segments[s + 1].first == end;
+        int first = _events.size();
+
+        QVector<int> tempoTimes = tempoMap->changeTimes(start, end, TEMPO_RAMP_STEP);
+        if (tempoTimes.isEmpty() || tempoTimes.first() != start) {
+            tempoTimes.prepend(start);
+        }
+        for (int i = 0; i < tempoTimes.size(); i++) {
+            int t = tempoTimes[i];
+            int next = (i + 1 < tempoTimes.size() ? tempoTimes[i + 1] : t + quarter);
+            CAPlaybackEvent e = event(CAPlaybackEvent::Tempo, t, t, 1);
+            e.time = offset + t - start;
+            e.value = static_cast<int>((tempoMap->realTime(next) - tempoMap->realTime(t)) * quarter / (next - t)); // average tempo until the next change
+            _events << e;
+        }
+
+        for (int track = 0; track < _voices.size(); track++) {
+            const QVector<CAPlaybackEvent>& events = _voiceEvents[_voices[track]];
+            int i = std::lower_bound(events.begin(), events.end(), start, [](const CAPlaybackEvent& e, int t) { return e.scoreTime < t; }) - events.begin();
+
+            if (!continuedBefore) {
+                // restart the notes held over the start of the segment
+                for (int j = 0; j < i; j++) {
+                    if (events[j].isNoteOn() && events[j].value > start) {
+                        CAPlaybackEvent e = events[j];
+                        e.scoreTime = start;
+                        e.time = offset;
+                        e.track = track;
+                        _events << e;
+
+                        if (e.value > end && !continuedAfter) {
+                            e.data[0] = 0x80 | (e.data[0] & 0x0f);
+                            e.order = 0;
+                            e.scoreTime = end;
+                            e.time = offset + end - start;
+                            _events << e;
+                        }
+                    }
+                }
+            }
+
+            for (; i < events.size() && events[i].scoreTime <= end; i++) {
+                const CAPlaybackEvent& e = events[i];
+                if ((e.scoreTime == start && isEnd(e) && s > 0) || (e.scoreTime == end && !isEnd(e))) {
+                    continue; // belongs to the neighbour segment
+                }
+                if (e.type == CAPlaybackEvent::Tempo) {
+                    continue; // generated from the tempo map above
+                }
+
+                _events << e;
+                _events.last().time = offset + e.scoreTime - start;
+                _events.last().track = track;
+
+                if (e.isNoteOn() && e.value > end && !continuedAfter) {
+                    // stop the notes held over the end of the segment
+                    CAPlaybackEvent off = e;
+                    off.data[0] = 0x80 | (e.data[0] & 0x0f);
+                    off.order = 0;
+                    off.scoreTime = end;
+                    off.time = offset + end - start;
+                    off.track = track;
+                    _events << off;
+                }
+            }
+        }
+
+        // resolve the real time
+        qint64 startUsec = tempoMap->realTime(start);
+        for (int i = first; i < _events.size(); i++) {
+            _events[i].usec = segmentUsec + tempoMap->realTime(_events[i].scoreTime) - startUsec;
+        }
+
+        offset += end - start;
+        segmentUsec += tempoMap->realTime(end) - startUsec;
+    }
+
+    std::stable_sort(_events.begin(), _events.end(), [](const CAPlaybackEvent& a, const CAPlaybackEvent& b) {
+        return a.time < b.time || (a.time == b.time && a.order < b.order);
+    });
+}
+
+/*!
+	Returns the playback time when the given \a scoreTime is played for the first time.
+*/
+int CAPlaybackTimeline::playbackTime(int scoreTime)
+{
+    int offset = 0;
+    for (int s = 0; s < _segments.size(); s++) {
+        if (scoreTime >= _segments[s].first && scoreTime < _segments[s].second) {
+            return offset + scoreTime - _segments[s].first;
+        }
+        offset += _segments[s].second - _segments[s].first;
+    }
+    return offset;
+}
+
+/*!
+	Returns the index of the first event at or after the given playback \a time.
+*/
+int CAPlaybackTimeline::indexAt(int time)
+{
+    return std::lower_bound(_events.begin(), _events.end(), time, [](const CAPlaybackEvent& e, int t) { return e.time < t; }) - _events.begin();
+}
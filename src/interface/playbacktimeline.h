@@ -0,0 +1,106 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef PLAYBACKTIMELINE_H_
+#define PLAYBACKTIMELINE_H_
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QVector>
+
+class CASheet;
+class CAVoice;
+class CAMusElement;
+class CAPlayable;
+class CANote;
+
+/*!
+	Single timestamped event of the compiled playback timeline.
+*/
+struct CAPlaybackEvent {
+    enum CAPlaybackEventType {
+        Midi, // data = midi message of the given size
+        Tempo, // value = microseconds per quarter
+        TimeSignature, // data[0] = beats, data[1] = beat
+        KeySignature, // data[0] = number of sharps (positive) or flats (negative), data[1] = 1 if minor
+        PlayableStart, // playable starts sounding
+        PlayableEnd // playable stops sounding
+    };
+
+    qint64 usec; // absolute real time in microseconds from the beginning
+    int time; // playback time with the repeats expanded
+    int scoreTime; // time of the event in the score
+    int origin; // start time of the music element which created the event
+    int track; // index of the voice in CAPlaybackTimeline::voices()
+    int value; // Tempo: microseconds per quarter, note on: time of the note off, note off: time of the note on
+    CAPlayable* playable; // PlayableStart, PlayableEnd: the playable element, note on and off: the note
+    unsigned char type; // CAPlaybackEventType
+    unsigned char order; // events at the same time are sorted by this value
+    unsigned char size; // Midi: size of the message
+    unsigned char data[3];
+
+    inline bool isNoteOn() const { return type == Midi && (data[0] & 0xf0) == 0x90; }
+    inline bool isNoteOff() const { return type == Midi && (data[0] & 0xf0) == 0x80; }
+};
+
+class CAPlaybackTimeline {
+public:
+    CAPlaybackTimeline(CASheet* sheet = nullptr);
+    ~CAPlaybackTimeline();
+
+    void compile();
+    void update();
+    void update(CAVoice* voice, int timeStart = 0, int timeEnd = -1);
+    CAPlaybackTimeline* snapshot();
+
+    void invalidate();
+    void invalidateVoice(CAVoice* voice, int timeStart);
+    inline bool isValid() { return _valid; }
+
+    static void invalidate(CAVoice* voice, int timeStart = 0);
+    static void invalidate(CAMusElement* elt);
+
+    inline CASheet* sheet() { return _sheet; }
+    inline void setSheet(CASheet* s) { _sheet = s; }
+
+    inline const QVector<CAPlaybackEvent>& events() { return _events; }
+    inline const QList<CAVoice*>& voices() { return _voices; }
+    inline const QList<QPair<int, int>>& segments() { return _segments; }
+    inline bool isEmpty() { return _events.isEmpty(); }
+
+    int playbackTime(int scoreTime);
+    int indexAt(int time);
+
+    static QVector<CAPlaybackEvent> compileVoice(CAVoice* voice, int timeStart = 0, int timeEnd = -1, bool signs = false);
+
+    static const int TEMPO_RAMP_STEP;
+
+private:
+    CAPlaybackTimeline(const CAPlaybackTimeline& other);
+
+    void compileImpl();
+    void updateImpl(CAVoice* voice, int timeStart, int timeEnd);
+    void compileSegments();
+    void expand();
+
+    static void compileNote(CANote* note, QVector<CAPlaybackEvent>& events);
+    static CAPlaybackEvent event(CAPlaybackEvent::CAPlaybackEventType type, int time, int origin, int order);
+
+    CASheet* _sheet;
+    QList<CAVoice*> _voices;
+    QHash<CAVoice*, QVector<CAPlaybackEvent>> _voiceEvents; // compiled events of every voice in the score time
+    QList<QPair<int, int>> _segments; // score time segments [start, end) in the order they are played
+    QVector<CAPlaybackEvent> _events;
+
+    bool _valid; // the sheet was compiled
+    QHash<CAVoice*, int> _changes; // time of the first change in each changed voice since the last update
+    QMutex _mutex; // guards the shared timeline of the sheet, see CASheet::playbackTimeline()
+};
+
+#endif /* PLAYBACKTIMELINE_H_ */
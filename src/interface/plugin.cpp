@@ -14,6 +14,9 @@
 
 #include "interface/plugin.h"
 #include "interface/pluginaction.h"
+#include "interface/pluginjob.h"
+#include "score/document.h"
+#include "score/sheet.h"
 
 #ifndef SWIGCPP
 #include "canorus.h"
@@ -94,6 +97,15 @@ bool CAPlugin::callAction(CAPluginAction* action, CAMainWin* mainWin, CADocument
 #endif
 #ifdef USE_PYTHON
     QList<PyObject*> pythonArgs;
+    CADocument* snapshot = nullptr; // copy of the document for the background actions, see CAPluginJob
+#ifndef SWIGCPP
+    if (action->background() && action->lang() == "python") {
+        if (!document || !mainWin || mainWin->isPluginJobRunning()) {
+            return false; // one background action per main window at a time
+        }
+        snapshot = document->clone();
+    }
+#endif
 #endif
 
     // Convert arguments to its needed scripting language types
@@ -114,7 +126,7 @@ bool CAPlugin::callAction(CAPluginAction* action, CAMainWin* mainWin, CADocument
 #ifdef USE_PYTHON
             if (action->lang() == "python") {
                 PyEval_RestoreThread(CASwigPython::mainThreadState);
-                pythonArgs << CASwigPython::toPythonObject(document, CASwigPython::Document);
+                pythonArgs << CASwigPython::toPythonObject(snapshot ? snapshot : document, CASwigPython::Document);
                 PyEval_ReleaseThread(CASwigPython::mainThreadState);
             }
 #endif
@@ -134,9 +146,13 @@ bool CAPlugin::callAction(CAPluginAction* action, CAMainWin* mainWin, CADocument
 #endif
 #ifdef USE_PYTHON
             if (action->lang() == "python") {
-                if (mainWin->currentSheet()) {
+                CASheet* sheet = mainWin->currentSheet();
+                if (sheet && snapshot) {
+                    sheet = snapshot->sheetList().value(document->sheetList().indexOf(sheet), nullptr);
+                }
+                if (sheet) {
                     PyEval_RestoreThread(CASwigPython::mainThreadState);
-                    pythonArgs << CASwigPython::toPythonObject(mainWin->currentSheet(), CASwigPython::Sheet);
+                    pythonArgs << CASwigPython::toPythonObject(sheet, CASwigPython::Sheet);
                     PyEval_ReleaseThread(CASwigPython::mainThreadState);
                 } else {
                     error = true;
@@ -168,7 +184,7 @@ bool CAPlugin::callAction(CAPluginAction* action, CAMainWin* mainWin, CADocument
 #ifdef USE_PYTHON
             if (action->lang() == "python") {
 #ifndef SWIGCPP
-                if (mainWin->currentScoreView()) {
+                if (mainWin->currentScoreView() && !snapshot) { // elements of the edited document are not passed to the background actions
                     CAScoreView* v = mainWin->currentScoreView();
                     if (!v->selection().size() || v->selection().front()->drawableMusElementType() != CADrawableMusElement::DrawableNote) {
                         error = true;
@@ -193,12 +209,12 @@ bool CAPlugin::callAction(CAPluginAction* action, CAMainWin* mainWin, CADocument
 #ifdef USE_PYTHON
             if (action->lang() == "python") {
 #ifndef SWIGCPP
-                if (mainWin->currentScoreView()) {
+                if (mainWin->currentScoreView() && !snapshot) {
                     QList<CAMusElement*> musElements = mainWin->currentScoreView()->musElementSelection();
-                    PyObject* list = PyList_New(0);
                     PyEval_RestoreThread(CASwigPython::mainThreadState);
+                    PyObject* list = PyList_New(musElements.size());
                     for (int i = 0; i < musElements.size(); i++) {
-                        PyList_Append(list, CASwigPython::toPythonObject(musElements[i], CASwigPython::MusElement));
+                        PyList_SET_ITEM(list, i, CASwigPython::toPythonObject(musElements[i], CASwigPython::MusElement)); // steals the reference
                     }
                     PyEval_ReleaseThread(CASwigPython::mainThreadState);
 
@@ -278,11 +294,24 @@ bool CAPlugin::callAction(CAPluginAction* action, CAMainWin* mainWin, CADocument
 #endif
 #ifdef USE_PYTHON
         if (action->lang() == "python") {
-            error = (!CASwigPython::callFunction(_dirName + "/" + action->filename(), action->function(), pythonArgs));
+#ifndef SWIGCPP
+            if (snapshot) {
+                // the changes are applied and the user interface rebuilt when the job finishes
+                mainWin->startPluginJob(new CAPluginJob(_dirName + "/" + action->filename(), action->function(), pythonArgs, document, snapshot));
+                return true;
+            }
+#endif
+            PyObject* ret = CASwigPython::callFunction(_dirName + "/" + action->filename(), action->function(), pythonArgs, true);
+            error = (!ret);
+            CASwigPython::releaseObject(ret);
         }
 #endif
     }
 
+#ifdef USE_PYTHON
+    delete snapshot; // the arguments couldn't be converted
+#endif
+
 #ifndef SWIGCPP
     if (action->refresh()) {
         if (rebuildDocument == true)
@@ -29,6 +29,7 @@ CAPluginAction::CAPluginAction(CAPlugin* plugin, QString name, QString lang, QSt
     _function = function;
     _filename = filename;
     _args = args;
+    _background = false;
 
     connect(this, SIGNAL(triggered(bool)), this, SLOT(triggeredSlot(bool)));
 }
@@ -51,6 +51,7 @@ public:
             return localeText("");
     }
     bool refresh() { return _refresh; }
+    bool background() { return _background; }
 
     void setPlugin(CAPlugin* plugin) { _plugin = plugin; }
     void setName(QString name) { _name = name; }
@@ -75,6 +76,7 @@ public:
         this->setText(localText());
     }
     void setRefresh(bool refresh) { _refresh = refresh; }
+    void setBackground(bool background) { _background = background; }
 
 private:
     CAPlugin* _plugin; /// Pointer to the plugin which this action belongs to
@@ -88,6 +90,7 @@ private:
     QHash<QString, QString> _importFilter; /// Text written in import dialog's filter
     QHash<QString, QString> _text; /// Text written on a menu item or the toolbar button
     bool _refresh; /// Should the UI be rebuilt when calling the action.
+    bool _background; /// Should the action run in a worker thread on a copy of the document, see CAPluginJob.
 
 #ifndef SWIG
 private slots:
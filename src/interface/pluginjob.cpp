@@ -0,0 +1,180 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifdef USE_PYTHON
+#include "interface/pluginjob.h"
+
+#include "score/document.h"
+
+/*!
+	\class CAPluginJob
+	\brief Python plugin action running in a worker thread
+
+	Long running plugin actions marked with <background/> in the plugin descriptor are run
+	in this thread, so the user interface stays responsive. The action gets a copy of the
+	document (the snapshot) instead of the edited one and must not touch the user interface.
+
+	The action changes the edited document by returning a callable or a list of callables.
+	They are called with the edited document on the GUI thread when the job finishes, see
+	applyChanges(). For example:
+
+	\code
+	  def analyse(document):
+	      result = ... # long analysis of the snapshot
+	      CanorusPython.setProgress(50)
+	      if CanorusPython.isCanceled():
+	          return None
+	      def apply(document):
+	          ... # insert the result
+	      return apply
+	\endcode
+
+	The progress is shown in the status bar of the main window by CAMainWinProgressCtl. When
+	the user cancels the job, KeyboardInterrupt is raised in the action.
+
+	Status is 1 while running, 0 when the action succeeded, -1 when it raised an exception
+	and -2 when it was canceled.
+*/
+
+/*!
+	Creates a job calling the \a function of the Python file \a fileName with the arguments
+	\a args. The job takes the references of \a args and the ownership of the \a snapshot
+	of the edited \a document.
+*/
+CAPluginJob::CAPluginJob(const QString& fileName, const QString& function, QList<PyObject*> args, CADocument* document, CADocument* snapshot)
+    : _fileName(fileName)
+    , _function(function)
+    , _args(args)
+    , _document(document)
+    , _snapshot(snapshot)
+    , _result(nullptr)
+    , _canceled(false)
+    , _threadId(0)
+{
+    setStatus(1);
+}
+
+/*!
+	Destructor. Must be called on the GUI thread, after the job finished.
+*/
+CAPluginJob::~CAPluginJob()
+{
+    PyEval_RestoreThread(CASwigPython::mainThreadState);
+    for (PyObject* arg : _args)
+        Py_XDECREF(arg); // the job never ran
+    Py_XDECREF(_result);
+    PyEval_ReleaseThread(CASwigPython::mainThreadState);
+
+    delete _snapshot;
+}
+
+const QString CAPluginJob::readableStatus()
+{
+    switch (status()) {
+    case 1:
+        return QObject::tr("Running plugin");
+    case 0:
+        return QObject::tr("Ready");
+    case -1:
+        return QObject::tr("Plugin failed");
+    case -2:
+        return QObject::tr("Plugin canceled");
+    }
+
+    return QString();
+}
+
+void CAPluginJob::run()
+{
+    PyGILState_STATE state = PyGILState_Ensure();
+    _threadId = PyThread_get_thread_ident();
+    if (!_canceled) {
+        _result = CASwigPython::callFunctionLocked(_fileName, _function, _args, true);
+    } else {
+        for (PyObject* arg : _args)
+            Py_XDECREF(arg);
+    }
+    _args.clear();
+    _threadId = 0;
+    PyGILState_Release(state);
+
+    setProgress(100);
+    setStatus(_canceled ? -2 : (_result ? 0 : -1));
+}
+
+/*!
+	Cancels the job. The action gets KeyboardInterrupt, isCanceled() is True and the changes
+	are not applied. Called from the GUI thread.
+*/
+void CAPluginJob::cancel()
+{
+    _canceled = true;
+
+    PyEval_RestoreThread(CASwigPython::mainThreadState);
+    if (_threadId) {
+        PyThreadState_SetAsyncExc(_threadId, PyExc_KeyboardInterrupt);
+    }
+    PyEval_ReleaseThread(CASwigPython::mainThreadState);
+}
+
+/*!
+	Calls the callables returned by the action with the edited \a document in a single batch,
+	so they are a single undo step. Called from the GUI thread when the job finished.
+
+	Returns True, if the action succeeded and all the changes were applied.
+*/
+bool CAPluginJob::applyChanges(CADocument* document)
+{
+    if (status() != 0) {
+        return false;
+    }
+    if (_result == Py_None) {
+        return true; // nothing to change
+    }
+
+    PyEval_RestoreThread(CASwigPython::mainThreadState);
+    PyObject* changes = nullptr;
+    if (PyCallable_Check(_result)) {
+        changes = PyTuple_Pack(1, _result);
+    } else {
+        changes = PySequence_Fast(_result, "background plugin action must return a callable or a list of callables");
+    }
+    bool batch = changes;
+    bool success = changes;
+    if (batch) {
+        PyEval_ReleaseThread(CASwigPython::mainThreadState);
+        document->beginBatch();
+        PyEval_RestoreThread(CASwigPython::mainThreadState);
+
+        PyObject* pyDocument = CASwigPython::toPythonObject(document, CASwigPython::Document);
+        for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(changes) && success; i++) {
+            PyObject* ret = PyObject_CallFunctionObjArgs(PySequence_Fast_GET_ITEM(changes, i), pyDocument, nullptr);
+            success = ret;
+            Py_XDECREF(ret);
+        }
+        Py_DECREF(pyDocument);
+        Py_DECREF(changes);
+    }
+    if (!success && PyErr_Occurred())
+        PyErr_Print();
+    PyEval_ReleaseThread(CASwigPython::mainThreadState);
+
+    if (batch) {
+        document->endBatch();
+    }
+
+    return success;
+}
+
+/*!
+	Returns the job running in the current thread or Null, if called outside of a job.
+*/
+CAPluginJob* CAPluginJob::currentJob()
+{
+    return dynamic_cast<CAPluginJob*>(QThread::currentThread());
+}
+#endif
@@ -0,0 +1,54 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifdef USE_PYTHON
+#ifndef PLUGINJOB_H_
+#define PLUGINJOB_H_
+
+// Python.h, which swigpython.h includes, must be included before any other headers
+#include "scripting/swigpython.h"
+
+#include <QList>
+#include <QString>
+
+#include <atomic>
+
+#include "core/file.h"
+
+class CADocument;
+
+class CAPluginJob : public CAFile {
+public:
+    CAPluginJob(const QString& fileName, const QString& function, QList<PyObject*> args, CADocument* document, CADocument* snapshot);
+    virtual ~CAPluginJob();
+
+    const QString readableStatus();
+    void cancel();
+    inline bool isCanceled() { return _canceled; }
+    inline void reportProgress(int progress) { setProgress(progress); }
+    inline CADocument* document() { return _document; }
+
+    bool applyChanges(CADocument* document);
+
+    static CAPluginJob* currentJob();
+
+protected:
+    void run();
+
+private:
+    QString _fileName;
+    QString _function;
+    QList<PyObject*> _args; // stolen by the function call
+    CADocument* _document; // edited document the job was started for, only compared, never dereferenced
+    CADocument* _snapshot; // copy of the document passed to the plugin, owned by the job
+    PyObject* _result;
+    std::atomic<bool> _canceled;
+    unsigned long _threadId; // Python identifier of the running thread, guarded by the GIL
+};
+
+#endif /* PLUGINJOB_H_ */
+#endif
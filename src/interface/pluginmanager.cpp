@@ -279,6 +279,7 @@ bool CAPluginManager::startElement(const QString&, const QString&, const QString
             _curActionParentMenu.clear();
             _curActionParentToolbar.clear();
             _curActionRefresh = false;
+            _curActionBackground = false;
         } else if (qName == "menu") {
             _curMenuTitle.clear();
             _curMenuName.clear();
@@ -333,6 +334,7 @@ bool CAPluginManager::endElement(const QString&, const QString&, const QString&
             action->setImportFilters(_curActionImportFilter);
             action->setTexts(_curActionText);
             action->setRefresh(_curActionRefresh);
+            action->setBackground(_curActionBackground);
 
             if (!_curActionParentToolbar.isEmpty())
                 ;
@@ -408,6 +410,8 @@ bool CAPluginManager::endElement(const QString&, const QString&, const QString&
             _curActionImportFilter[_curActionLocale] = _curChars;
         } else if (qName == "refresh") {
             _curActionRefresh = true;
+        } else if (qName == "background") {
+            _curActionBackground = true;
         } else
             // menu level
             if (qName == "title") {
@@ -75,6 +75,7 @@ private:
     QHash<QString, QString> _curActionExportFilter, _curActionImportFilter;
     QString _curActionParentMenu, _curActionParentToolbar;
     bool _curActionRefresh;
+    bool _curActionBackground;
     QString _curActionLang, _curActionFunction, _curActionFilename;
     QList<QString> _curActionArgs;
 
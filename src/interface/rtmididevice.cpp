@@ -23,7 +23,7 @@
 	RtMidi written by Gary P. Scavone (http://www.music.mcgill.ca/~gary/rtmidi/).
 
 	Usage:
-	1) When created, Input and Output MIDI devices get initialized.
+	1) When first used, Input and Output MIDI devices get initialized.
 	2) Call getOutputPorts() and getInputPorts() to retreive a map of portNumber/portName.
 	3) Call openOutputPort(port) and/or openInputPort(port) to open an Output/Input port.
 	4) Send MIDI events (for midi output) using send(QVector<unsigned char>).
@@ -40,13 +40,27 @@ CARtMidiDevice::CARtMidiDevice()
     _in = nullptr;
     _outOpen = false;
     _inOpen = false;
+    _inTime = -1;
     setRealTime(true);
 
     // create midi client names which hold the current pid
     _pid = QCoreApplication::applicationPid();
     _midiNameOut << "Canorus Out (" << _pid << ")";
     _midiNameIn << "Canorus In (" << _pid << ")";
+    _clientsInitialized = false;
+}
 
+/*!
+	Creates the RtMidi input and output clients, if not created yet. Connecting to the MIDI
+	system takes a while, so it's not done until the ports are needed.
+	The mutex must be locked.
+*/
+void CARtMidiDevice::initClients()
+{
+    if (_clientsInitialized)
+        return;
+
+    _clientsInitialized = true;
     try {
         _out = new RtMidiOut(RtMidi::UNSPECIFIED, _midiNameOut.str());
         _in = new RtMidiIn(RtMidi::UNSPECIFIED, _midiNameIn.str());
@@ -57,9 +71,12 @@ CARtMidiDevice::CARtMidiDevice()
 
 bool CARtMidiDevice::openOutputPort(int port)
 {
+    QMutexLocker locker(&_mutex);
     if (port == -1 || _outOpen)
         return false;
 
+    initClients();
+
     if (_out && static_cast<int>(_out->getPortCount()) > port) { // check outputs
         try {
             _out->openPort(static_cast<unsigned int>(port));
@@ -77,9 +94,12 @@ bool CARtMidiDevice::openOutputPort(int port)
 
 bool CARtMidiDevice::openInputPort(int port)
 {
+    QMutexLocker locker(&_mutex);
     if (port == -1 || _inOpen)
         return false;
 
+    initClients();
+
     if (_in && static_cast<int>(_in->getPortCount()) > port) { // check outputs
         try {
             _in->openPort(static_cast<unsigned int>(port));
@@ -87,7 +107,8 @@ bool CARtMidiDevice::openInputPort(int port)
             error.printMessage();
             return false; // error when opening the port
         }
-        _in->setCallback(&rtMidiInCallback); // sets the callback function
+        _inTime = -1;
+        _in->setCallback(&rtMidiInCallback, this); // sets the callback function
         _inOpen = true;
         return true; // port opened successfully
     } else {
@@ -98,19 +119,57 @@ bool CARtMidiDevice::openInputPort(int port)
 
 /*!
 	Callback function which gets called by RtMidi automatically when an information on MidiIn device has come.
+	It is called in the RtMidi input thread. The event is timestamped and passed to the recorder,
+	if any, directly in this thread and queued for the GUI thread.
 */
-void rtMidiInCallback(double, std::vector<unsigned char>* message, void*)
+void rtMidiInCallback(double deltatime, std::vector<unsigned char>* message, void* userData)
 {
-    (void)message; // Only used in with SWIGCPP
+    CARtMidiDevice* device = static_cast<CARtMidiDevice*>(userData);
+    qint64 time = device->inputTimestamp(deltatime);
+    if (message->empty() || message->size() > 3) {
+        return; // sysex
+    }
+
+    CAMidiMessage m;
+    m.time = time;
+    m.size = static_cast<unsigned char>(message->size());
+    for (unsigned int i = 0; i < message->size(); i++) {
+        m.data[i] = (*message)[i];
+    }
+
+    device->recordInput(m);
+
 #ifndef SWIGCPP
-    emit CACanorus::midiDevice()->midiInEvent(QVector<unsigned char>::fromStdVector(*message));
+    device->postInput(m);
 #else
         // call scripting callback?
 #endif
 }
 
+/*!
+	Returns the monotonic time in microseconds of the midi input event received \a deltatime
+	seconds after the previous one. Only called from the input thread.
+
+	RtMidi measures \a deltatime with the driver timestamps, so it doesn't depend on when the
+	input thread was woken up. The deltas are accumulated from the first event which is stamped
+	with the monotonic clock. If the accumulated time gets ahead of the clock or falls behind it
+	for more than a second, it's synchronized with the clock again.
+*/
+qint64 CARtMidiDevice::inputTimestamp(double deltatime)
+{
+    qint64 now = monotonicTime();
+    qint64 time = _inTime + qRound64(deltatime * 1000000);
+    if (_inTime < 0 || time > now || now - time > 1000000) {
+        time = now;
+    }
+    _inTime = time;
+
+    return time;
+}
+
 void CARtMidiDevice::closeOutputPort()
 {
+    QMutexLocker locker(&_mutex);
     try {
         if (_outOpen)
             _out->closePort();
@@ -122,6 +181,7 @@ void CARtMidiDevice::closeOutputPort()
 
 void CARtMidiDevice::closeInputPort()
 {
+    QMutexLocker locker(&_mutex);
     try {
         if (_inOpen) {
             _in->cancelCallback();
@@ -135,6 +195,9 @@ void CARtMidiDevice::closeInputPort()
 
 QMap<int, QString> CARtMidiDevice::getOutputPorts()
 {
+    QMutexLocker locker(&_mutex);
+    initClients();
+
     QMap<int, QString> outPorts;
     try {
         for (int i = 0; _out && i < static_cast<int>(_out->getPortCount()); i++)
@@ -148,6 +211,9 @@ QMap<int, QString> CARtMidiDevice::getOutputPorts()
 
 QMap<int, QString> CARtMidiDevice::getInputPorts()
 {
+    QMutexLocker locker(&_mutex);
+    initClients();
+
     QMap<int, QString> inPorts;
     try {
         for (int i = 0; _in && i < static_cast<int>(_in->getPortCount()); i++)
@@ -172,9 +238,16 @@ CARtMidiDevice::~CARtMidiDevice()
 /*!
 	Sends the given \a message to the midi device. \a offset is ignored because CARtMidiDevice is a realtime device.
 */
-void CARtMidiDevice::send(QVector<unsigned char> message, int)
+void CARtMidiDevice::send(QVector<unsigned char> message, int time)
+{
+    send(message.constData(), message.size(), time);
+}
+
+/*!
+	Sends the \a message of the given \a size to the midi device without copying it.
+*/
+void CARtMidiDevice::send(const unsigned char* message, int size, int)
 {
-    std::vector<unsigned char> messageVector = message.toStdVector();
     if (_outOpen)
-        _out->sendMessage(&messageVector);
+        _out->sendMessage(message, static_cast<size_t>(size));
 }
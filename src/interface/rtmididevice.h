@@ -9,6 +9,7 @@
 #define RTMIDIDEVICE_H_
 
 #include "interface/mididevice.h"
+#include <QMutex>
 #include <sstream>
 
 class RtMidiOut;
@@ -19,6 +20,10 @@ void rtMidiInCallback(double deltatime, std::vector<unsigned char>* message, voi
 #endif
 
 class CARtMidiDevice : public CAMidiDevice {
+#ifndef SWIG
+    friend void rtMidiInCallback(double deltatime, std::vector<unsigned char>* message, void* userData);
+#endif
+
 public:
     CARtMidiDevice();
     virtual ~CARtMidiDevice();
@@ -31,16 +36,25 @@ public:
     void closeOutputPort();
     void closeInputPort();
     void send(QVector<unsigned char> message, int time);
+#ifndef SWIG
+    void send(const unsigned char* message, int size, int time);
+#endif
     void sendMetaEvent(int, char, char, char, int) {}
 
 private:
+    qint64 inputTimestamp(double deltatime);
+    void initClients();
+
     RtMidiOut* _out;
     RtMidiIn* _in;
     bool _outOpen;
     bool _inOpen;
+    qint64 _inTime; // monotonic time of the last input event in microseconds, -1 before the first one
     qint64 _pid;
     std::stringstream _midiNameIn;
     std::stringstream _midiNameOut;
+    bool _clientsInitialized; // RtMidi clients are created on the first use
+    QMutex _mutex; // guards the clients and the ports, the ports are enumerated in the background on startup
 };
 
 #endif /* RTMIDIDEVICE_H_ */
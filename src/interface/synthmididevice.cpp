@@ -0,0 +1,544 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QFile>
+#include <QObject>
+#include <QtEndian>
+#include <QtMath>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CANORUS_SYNTH_SSE2
+#endif
+
+#include "interface/synthmididevice.h"
+#include "score/playablelength.h"
+
+/*!
+	\class CASynthMidiDevice
+	\brief Built-in software synthesizer
+
+	CASynthMidiDevice is a non-real-time midi device which renders the received midi events
+	into 16-bit stereo PCM audio. It doesn't need any sound hardware or external synthesizer,
+	so it is used for rendering audio proofs on headless machines. The output is
+	deterministic: the same events always produce the same samples.
+
+	The synthesizer is a simple wave table synth. Each GM instrument family is mapped to one
+	of the few built-in wave forms and envelopes, the percussion channel 10 plays short noise bursts.
+	At most MAX_VOICES notes sound at once, the quietest one is stolen when a new note starts.
+	Voices are rendered in blocks of BLOCK_SIZE frames and mixed using SSE2, if available.
+
+	Usage:
+	1) Call setFileName() and openOutputPort(WavFilePort) to write a WAV file,
+	   openOutputPort(StdoutPort) to stream the WAV to the standard output or setDevice() and
+	   openOutputPort(DevicePort) to write it to an already opened device, eg. by CAWavExport.
+	2) Set the device to CAPlayback and call CAPlayback::render(). The event times are
+	   converted to samples using the tempo meta events.
+	3) Call closeOutputPort() to render the release of the last notes and finish the file.
+
+	\code
+	  CASynthMidiDevice synth;
+	  synth.setFileName("proof.wav");
+	  if (synth.openOutputPort(CASynthMidiDevice::WavFilePort)) {
+	      CAPlayback playback(sheet, &synth);
+	      playback.render();
+	      synth.closeOutputPort();
+	  }
+	\endcode
+
+	\sa CAPlayback::render()
+*/
+
+const int CASynthMidiDevice::MAX_VOICES = 64;
+const int CASynthMidiDevice::BLOCK_SIZE = 256;
+
+namespace {
+const int TABLE_BITS = 12;
+const int TABLE_SIZE = 1 << TABLE_BITS;
+const int TABLE_COUNT = 4;
+const float MASTER_GAIN = 0.25f;
+const double ATTACK_TIME = 0.005; // seconds
+const double RELEASE_TIME = 0.08;
+const double MAX_TAIL_TIME = 2.0; // longest rendered release after closing the port
+
+struct CASynthPatch {
+    int table; // index of the wave table
+    double decay; // seconds to reach the sustain level
+    float sustain;
+};
+
+// wave table and envelope for every GM instrument family (program / 8)
+const CASynthPatch SYNTH_PATCHES[16] = {
+    { 0, 1.5, 0.0f }, // piano
+    { 0, 0.8, 0.0f }, // chromatic percussion
+    { 1, 0.1, 0.9f }, // organ
+    { 2, 1.2, 0.0f }, // guitar
+    { 0, 1.0, 0.3f }, // bass
+    { 2, 0.2, 0.8f }, // strings
+    { 2, 0.2, 0.8f }, // ensemble
+    { 2, 0.1, 0.8f }, // brass
+    { 3, 0.1, 0.8f }, // reed
+    { 0, 0.1, 0.8f }, // pipe
+    { 3, 0.1, 0.7f }, // synth lead
+    { 1, 0.5, 0.7f }, // synth pad
+    { 1, 0.5, 0.5f }, // synth effects
+    { 2, 1.0, 0.0f }, // ethnic
+    { 0, 0.3, 0.0f }, // percussive
+    { 0, 0.3, 0.0f } // sound effects
+};
+}
+
+CASynthMidiDevice::CASynthMidiDevice(int sampleRate)
+    : CAMidiDevice()
+{
+    _midiDeviceType = SynthMidiDevice;
+    setRealTime(false);
+
+    _device = nullptr;
+    _out = nullptr;
+    _outOpen = false;
+    _sampleRate = sampleRate;
+    _framesWritten = 0;
+    _tempoTime = 0;
+    _tempoFrame = 0;
+    _framesPerTick = 0;
+
+    _voices.reserve(MAX_VOICES);
+    _voiceBuffer.resize(BLOCK_SIZE);
+    _left.resize(BLOCK_SIZE);
+    _right.resize(BLOCK_SIZE);
+    _pcm.resize(BLOCK_SIZE * 2);
+
+    initTables();
+}
+
+CASynthMidiDevice::~CASynthMidiDevice()
+{
+    closeOutputPort();
+}
+
+QMap<int, QString> CASynthMidiDevice::getOutputPorts()
+{
+    QMap<int, QString> ports;
+    ports[WavFilePort] = QObject::tr("WAV file");
+    ports[StdoutPort] = QObject::tr("Standard output");
+    ports[DevicePort] = QObject::tr("Output device");
+    return ports;
+}
+
+QMap<int, QString> CASynthMidiDevice::getInputPorts()
+{
+    return QMap<int, QString>();
+}
+
+/*!
+	Opens the WAV file set by setFileName(), the standard output or the device set by
+	setDevice(), depending on the given \a port, and resets the synthesizer. Returns True
+	on success, False otherwise. See errorString() for details.
+*/
+bool CASynthMidiDevice::openOutputPort(int port)
+{
+    if (_outOpen) {
+        return false;
+    }
+
+    if (port == DevicePort) {
+        if (!_device || !_device->isWritable()) {
+            _errorString = QObject::tr("The output device is not opened for writing");
+            return false;
+        }
+        _out = _device;
+    } else if (!openFile(port)) {
+        return false;
+    }
+
+    _outOpen = true;
+    _errorString.clear();
+
+    _voices.clear();
+    _framesWritten = 0;
+    _tempoTime = 0;
+    _tempoFrame = 0;
+    _framesPerTick = _sampleRate * 0.5 / CAPlayableLength::playableLengthToTimeLength(CAPlayableLength::Quarter); // 120 bpm
+    for (int i = 0; i < 16; i++) {
+        _program[i] = 0;
+        _volume[i] = 100 / 127.0f;
+        _pan[i] = 0.5f;
+    }
+
+    // a streamed file doesn't know its length in advance
+    writeHeader(_out->isSequential() ? 0xffffffff : 0);
+
+    return true;
+}
+
+/*!
+	Opens the WAV file set by setFileName() or the standard output for the given \a port.
+*/
+bool CASynthMidiDevice::openFile(int port)
+{
+    QFile* file = new QFile(port == StdoutPort ? QString() : _fileName);
+    bool opened = false;
+    if (port == StdoutPort) {
+        opened = file->open(stdout, QIODevice::WriteOnly, QFileDevice::DontCloseHandle);
+    } else if (port == WavFilePort) {
+        opened = file->open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+
+    if (!opened) {
+        _errorString = QObject::tr("Unable to open file %1 for writing").arg(port == StdoutPort ? QObject::tr("Standard output") : _fileName);
+        delete file;
+        return false;
+    }
+
+    _out = file;
+    return true;
+}
+
+/*!
+	Renders the release of the sounding notes, finishes the WAV header and closes the output.
+	The device set by setDevice() is left open.
+*/
+void CASynthMidiDevice::closeOutputPort()
+{
+    if (!_outOpen) {
+        return;
+    }
+
+    for (int i = 0; i < _voices.size(); i++) {
+        _voices[i].released = true;
+    }
+    qint64 tail = 0;
+    while (!_voices.isEmpty() && tail < MAX_TAIL_TIME * _sampleRate) {
+        renderBlock(BLOCK_SIZE);
+        tail += BLOCK_SIZE;
+    }
+    _voices.clear();
+
+    if (!_out->isSequential() && _out->seek(0)) {
+        writeHeader(static_cast<quint32>(qMin<qint64>(_framesWritten * 4, 0xffffffff - 36)));
+        _out->seek(_out->size());
+    }
+
+    if (_out != _device) {
+        _out->close();
+        delete _out;
+    }
+    _out = nullptr;
+    _outOpen = false;
+}
+
+void CASynthMidiDevice::send(QVector<unsigned char> message, int time)
+{
+    send(message.constData(), message.size(), time);
+}
+
+/*!
+	Renders the audio up to the given \a time and applies the note on, note off,
+	program change and volume and pan control change \a message of the given \a size.
+*/
+void CASynthMidiDevice::send(const unsigned char* message, int size, int time)
+{
+    if (!_outOpen || size <= 0) {
+        return;
+    }
+
+    advanceTo(time);
+
+    int channel = message[0] & 0x0f;
+    switch (message[0] & 0xf0) {
+    case Midi_Note_On:
+        if (size >= 3 && message[2] > 0) {
+            noteOn(channel, message[1], message[2]);
+        } else if (size >= 2) {
+            noteOff(channel, message[1]);
+        }
+        break;
+    case Midi_Note_Off:
+        if (size >= 2) {
+            noteOff(channel, message[1]);
+        }
+        break;
+    case Midi_Prog_Change:
+        if (size >= 2) {
+            _program[channel] = message[1] & 0x7f;
+        }
+        break;
+    case Midi_Control_Chg:
+        if (size >= 3) {
+            if (message[1] == Midi_Ctl_Volume) {
+                _volume[channel] = (message[2] & 0x7f) / 127.0f;
+            } else if (message[1] == Midi_Ctl_Pan) {
+                _pan[channel] = (message[2] & 0x7f) / 127.0f;
+            }
+        }
+        break;
+    }
+}
+
+/*!
+	Only the tempo meta event is used. It changes the length of the music time
+	tick in samples from the given \a time on. \a c is the tempo in microseconds per quarter,
+	\a a the tempo in beats per minute is used if \a c is not set.
+*/
+void CASynthMidiDevice::sendMetaEvent(int time, char event, char a, char, int c)
+{
+    if (!_outOpen || event != Meta_Tempo) {
+        return;
+    }
+
+    int usPerQuarter = (c > 0 ? c : 60000000 / qMax(static_cast<unsigned char>(a), static_cast<unsigned char>(1)));
+
+    advanceTo(time);
+    _tempoFrame += (time - _tempoTime) * _framesPerTick;
+    _tempoTime = time;
+    _framesPerTick = usPerQuarter / 1000000.0 * _sampleRate / CAPlayableLength::playableLengthToTimeLength(CAPlayableLength::Quarter);
+}
+
+void CASynthMidiDevice::noteOn(int channel, int pitch, int velocity)
+{
+    if (_voices.size() == MAX_VOICES) {
+        // steal the quietest voice
+        int quietest = 0;
+        for (int i = 1; i < _voices.size(); i++) {
+            if (_voices[i].level < _voices[quietest].level) {
+                quietest = i;
+            }
+        }
+        _voices.remove(quietest);
+    }
+
+    const CASynthPatch& patch = SYNTH_PATCHES[_program[channel] >> 3];
+
+    CASynthVoice v;
+    v.channel = channel;
+    v.pitch = pitch;
+    v.phase = 0;
+    v.noise = 0x12345678u ^ static_cast<quint32>(pitch << 8 | channel);
+    v.gain = (velocity & 0x7f) / 127.0f;
+    v.level = 0;
+    v.attack = static_cast<float>(1.0 / (ATTACK_TIME * _sampleRate));
+    v.release = static_cast<float>(1.0 / (RELEASE_TIME * _sampleRate));
+    v.released = false;
+    v.attacking = true;
+
+    if (channel == 9) {
+        // percussion, short noise burst
+        v.step = 0;
+        v.decay = static_cast<float>(1.0 / (0.15 * _sampleRate));
+        v.sustain = 0;
+        v.table = nullptr;
+        v.gain *= 0.5f;
+    } else {
+        double frequency = 440.0 * std::pow(2.0, (pitch - 69) / 12.0);
+        v.step = static_cast<quint32>(frequency / _sampleRate * 4294967296.0);
+        v.decay = static_cast<float>((1.0 - patch.sustain) / (patch.decay * _sampleRate));
+        v.sustain = patch.sustain;
+        v.table = _tables.constData() + patch.table * TABLE_SIZE;
+    }
+
+    _voices << v;
+}
+
+void CASynthMidiDevice::noteOff(int channel, int pitch)
+{
+    for (int i = 0; i < _voices.size(); i++) {
+        if (_voices[i].channel == channel && _voices[i].pitch == pitch && !_voices[i].released) {
+            _voices[i].released = true;
+            break;
+        }
+    }
+}
+
+/*!
+	Renders the audio up to the given music \a time using the current tempo.
+*/
+void CASynthMidiDevice::advanceTo(int time)
+{
+    qint64 frame = llround(_tempoFrame + (time - _tempoTime) * _framesPerTick);
+    if (frame > _framesWritten) {
+        renderFrames(frame - _framesWritten);
+    }
+}
+
+void CASynthMidiDevice::renderFrames(qint64 frames)
+{
+    while (frames > 0) {
+        int n = static_cast<int>(qMin<qint64>(frames, BLOCK_SIZE));
+        renderBlock(n);
+        frames -= n;
+    }
+}
+
+/*!
+	Renders and mixes all the sounding voices into a block of the given number of \a frames
+	and writes it to the output.
+*/
+void CASynthMidiDevice::renderBlock(int frames)
+{
+    float* left = _left.data();
+    float* right = _right.data();
+    for (int i = 0; i < frames; i++) {
+        left[i] = 0;
+        right[i] = 0;
+    }
+
+    for (int i = _voices.size() - 1; i >= 0; i--) {
+        CASynthVoice& v = _voices[i];
+        renderVoice(v, _voiceBuffer.data(), frames);
+
+        // constant power panning
+        float pan = _pan[v.channel];
+        float gain = MASTER_GAIN * v.gain * _volume[v.channel];
+        mix(left, _voiceBuffer.constData(), gain * static_cast<float>(std::cos(pan * M_PI_2)), frames);
+        mix(right, _voiceBuffer.constData(), gain * static_cast<float>(std::sin(pan * M_PI_2)), frames);
+
+        if (v.released && v.level <= 0) {
+            _voices.remove(i);
+        }
+    }
+
+    interleave(left, right, _pcm.data(), frames);
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    for (int i = 0; i < frames * 2; i++) {
+        _pcm[i] = qToLittleEndian(_pcm[i]);
+    }
+#endif
+    _out->write(reinterpret_cast<const char*>(_pcm.constData()), frames * 4);
+    _framesWritten += frames;
+}
+
+/*!
+	Generates the given number of \a frames of the \a voice with its envelope applied into \a out.
+*/
+void CASynthMidiDevice::renderVoice(CASynthVoice& v, float* out, int frames)
+{
+    for (int i = 0; i < frames; i++) {
+        if (v.released) {
+            v.level = qMax(v.level - v.release, 0.0f);
+        } else if (v.attacking) {
+            v.level += v.attack;
+            if (v.level >= 1) {
+                v.level = 1;
+                v.attacking = false;
+            }
+        } else if (v.level > v.sustain) {
+            v.level = qMax(v.level - v.decay, v.sustain);
+        }
+
+        float sample;
+        if (v.table) {
+            sample = v.table[v.phase >> (32 - TABLE_BITS)];
+            v.phase += v.step;
+        } else {
+            v.noise = v.noise * 1664525u + 1013904223u;
+            sample = static_cast<qint32>(v.noise) / 2147483648.0f;
+        }
+        out[i] = sample * v.level;
+    }
+
+    if (!v.released && !v.attacking && v.level <= 0) {
+        v.released = true; // decayed completely, free the voice
+    }
+}
+
+/*!
+	Adds the \a src samples multiplied by \a gain to \a dst.
+*/
+void CASynthMidiDevice::mix(float* dst, const float* src, float gain, int frames)
+{
+    int i = 0;
+#ifdef CANORUS_SYNTH_SSE2
+    __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= frames; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+    }
+#endif
+    for (; i < frames; i++) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+/*!
+	Converts the \a left and \a right float channels to interleaved 16-bit samples
+	stored in \a out, clipping the values out of range.
+*/
+void CASynthMidiDevice::interleave(const float* left, const float* right, qint16* out, int frames)
+{
+    int i = 0;
+#ifdef CANORUS_SYNTH_SSE2
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    const __m128 hi = _mm_set1_ps(32767.0f);
+    const __m128 lo = _mm_set1_ps(-32768.0f);
+    for (; i + 4 <= frames; i += 4) {
+        __m128i l = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(left + i), scale), hi), lo));
+        __m128i r = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(right + i), scale), hi), lo));
+        __m128i lr = _mm_unpacklo_epi16(_mm_packs_epi32(l, l), _mm_packs_epi32(r, r));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2), lr);
+    }
+#endif
+    for (; i < frames; i++) {
+        out[i * 2] = static_cast<qint16>(std::lrint(qBound(-32768.0f, left[i] * 32767.0f, 32767.0f)));
+        out[i * 2 + 1] = static_cast<qint16>(std::lrint(qBound(-32768.0f, right[i] * 32767.0f, 32767.0f)));
+    }
+}
+
+/*!
+	Writes the 44 bytes long header of the 16-bit stereo PCM WAV file with the given
+	\a dataSize in bytes. 0xffffffff is used for the unknown length when streaming.
+*/
+void CASynthMidiDevice::writeHeader(quint32 dataSize)
+{
+    uchar header[44];
+    memcpy(header, "RIFF", 4);
+    qToLittleEndian<quint32>(dataSize == 0xffffffff ? dataSize : dataSize + 36, header + 4);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    qToLittleEndian<quint32>(16, header + 16); // fmt chunk size
+    qToLittleEndian<quint16>(1, header + 20); // PCM
+    qToLittleEndian<quint16>(2, header + 22); // channels
+    qToLittleEndian<quint32>(_sampleRate, header + 24);
+    qToLittleEndian<quint32>(_sampleRate * 4, header + 28); // bytes per second
+    qToLittleEndian<quint16>(4, header + 32); // bytes per frame
+    qToLittleEndian<quint16>(16, header + 34); // bits per sample
+    memcpy(header + 36, "data", 4);
+    qToLittleEndian<quint32>(dataSize, header + 40);
+
+    _out->write(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+/*!
+	Generates the wave tables: sine, organ (first three harmonics), a band-limited
+	saw tooth for strings and brass and a band-limited square for reeds.
+*/
+void CASynthMidiDevice::initTables()
+{
+    _tables.resize(TABLE_COUNT * TABLE_SIZE);
+    float* sine = _tables.data();
+    float* organ = sine + TABLE_SIZE;
+    float* saw = organ + TABLE_SIZE;
+    float* square = saw + TABLE_SIZE;
+
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        double x = 2 * M_PI * i / TABLE_SIZE;
+        sine[i] = static_cast<float>(std::sin(x));
+        organ[i] = static_cast<float>((std::sin(x) + 0.5 * std::sin(2 * x) + 0.25 * std::sin(3 * x)) / 1.5);
+
+        double s = 0, q = 0;
+        for (int k = 1; k <= 12; k++) {
+            s += std::sin(k * x) / k;
+            if (k % 2) {
+                q += std::sin(k * x) / k;
+            }
+        }
+        saw[i] = static_cast<float>(s / 1.8);
+        square[i] = static_cast<float>(q / 1.2);
+    }
+}
@@ -0,0 +1,114 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef SYNTHMIDIDEVICE_H_
+#define SYNTHMIDIDEVICE_H_
+
+#include <QString>
+#include <QVector>
+
+#include "interface/mididevice.h"
+
+class QIODevice;
+
+class CASynthMidiDevice : public CAMidiDevice {
+public:
+    enum CASynthOutputPort {
+        WavFilePort = 0,
+        StdoutPort = 1,
+        DevicePort = 2
+    };
+
+    CASynthMidiDevice(int sampleRate = 44100);
+    virtual ~CASynthMidiDevice();
+
+    QMap<int, QString> getOutputPorts();
+    QMap<int, QString> getInputPorts();
+
+    bool openOutputPort(int port);
+    bool openInputPort(int) { return false; }
+    void closeOutputPort();
+    void closeInputPort() {}
+    void send(QVector<unsigned char> message, int time);
+#ifndef SWIG
+    void send(const unsigned char* message, int size, int time);
+#endif
+    void sendMetaEvent(int time, char event, char a, char b, int c);
+
+    inline const QString& fileName() { return _fileName; }
+    inline void setFileName(const QString& fileName) { _fileName = fileName; }
+    inline QIODevice* device() { return _device; }
+    inline void setDevice(QIODevice* device) { _device = device; }
+    inline int sampleRate() { return _sampleRate; }
+    inline qint64 framesWritten() { return _framesWritten; }
+    inline const QString& errorString() { return _errorString; }
+
+    static const int MAX_VOICES;
+    static const int BLOCK_SIZE;
+
+private:
+#ifndef SWIG
+    struct CASynthVoice {
+        int channel;
+        int pitch;
+        quint32 phase; // oscillator phase, the upper bits index the wave table
+        quint32 step; // phase increment per frame
+        quint32 noise; // state of the noise generator for the percussion channel
+        float gain; // velocity
+        float level; // current envelope level
+        float attack; // envelope increments per frame
+        float decay;
+        float release;
+        float sustain;
+        bool released;
+        bool attacking;
+        const float* table;
+    };
+#endif
+
+    bool openFile(int port);
+    void noteOn(int channel, int pitch, int velocity);
+    void noteOff(int channel, int pitch);
+    void advanceTo(int time);
+    void renderFrames(qint64 frames);
+    void renderBlock(int frames);
+    void renderVoice(CASynthVoice& voice, float* out, int frames);
+    void writeHeader(quint32 dataSize);
+    void initTables();
+
+    static void mix(float* dst, const float* src, float gain, int frames);
+    static void interleave(const float* left, const float* right, qint16* out, int frames);
+
+    QString _fileName;
+    QIODevice* _device; // opened by the caller, used by DevicePort
+    QIODevice* _out;
+    bool _outOpen;
+    QString _errorString;
+
+    int _sampleRate;
+    qint64 _framesWritten;
+
+    // tempo map of the received events
+    int _tempoTime;
+    double _tempoFrame;
+    double _framesPerTick;
+
+    unsigned char _program[16];
+    float _volume[16];
+    float _pan[16];
+
+#ifndef SWIG
+    QVector<CASynthVoice> _voices;
+#endif
+    QVector<float> _tables; // sine, organ, saw-like, square-like wave tables of TABLE_SIZE samples each
+    QVector<float> _voiceBuffer;
+    QVector<float> _left;
+    QVector<float> _right;
+    QVector<qint16> _pcm;
+};
+
+#endif /* SYNTHMIDIDEVICE_H_ */
@@ -5,6 +5,7 @@
 	Licensed under the GNU GENERAL PUBLIC LICENSE. See COPYING for details.
 */
 
+#include <QHash>
 #include <QPainter>
 
 #include "layout/drawable.h"
@@ -42,3 +43,19 @@ void CADrawable::drawVScaleHandles(QPainter* p, CADrawSettings s)
     p->drawRect(s.x + qRound((width() * s.z) / 2 - (SCALE_HANDLES_SIZE * s.z) / 2), s.y + qRound(((height() - SCALE_HANDLES_SIZE / 2.0) * s.z)),
         qRound(SCALE_HANDLES_SIZE * s.z), qRound(SCALE_HANDLES_SIZE * s.z));
 }
+
+/*!
+	Returns codepoint for an Feta (Emmentaler) glyph by its \a name.
+	The glyph map is built on the first call.
+ */
+int CADrawable::fetaCodepoint(const QString& name)
+{
+    static const QHash<QString, int> fetaMap = []() {
+        QHash<QString, int> _fetaMap;
+// populate glyph->codepoint map using generated list
+#include "fonts/fetaList.cxx"
+        return _fetaMap;
+    }();
+
+    return fetaMap.value(name);
+}
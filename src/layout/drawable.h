@@ -10,6 +10,7 @@
 
 #include <QColor>
 #include <QRectF>
+#include <QString>
 
 class QPainter;
 
@@ -51,6 +52,8 @@ public:
     void drawHScaleHandles(QPainter* p, const CADrawSettings s);
     void drawVScaleHandles(QPainter* p, const CADrawSettings s);
 
+    static int fetaCodepoint(const QString& name);
+
     inline CADrawableType drawableType() { return _drawableType; }
     inline double xPos() const { return _xPos; }
     inline double yPos() const { return _yPos; }
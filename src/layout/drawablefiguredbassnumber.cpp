@@ -6,7 +6,6 @@
 */
 
 #include "layout/drawablefiguredbassnumber.h"
-#include "canorus.h"
 #include "layout/drawablefiguredbasscontext.h"
 #include "score/figuredbassmark.h"
 #include <QPainter>
@@ -41,15 +40,15 @@ void CADrawableFiguredBassNumber::draw(QPainter* p, const CADrawSettings s)
     QString accs;
     if (figuredBassMark()->accs().contains(_number)) {
         if (figuredBassMark()->accs()[_number] == -2) {
-            accs += QString(CACanorus::fetaCodepoint("accidentals.flatflat"));
+            accs += QString(fetaCodepoint("accidentals.flatflat"));
         } else if (figuredBassMark()->accs()[_number] == -1) {
-            accs += QString(CACanorus::fetaCodepoint("accidentals.flat"));
+            accs += QString(fetaCodepoint("accidentals.flat"));
         } else if (figuredBassMark()->accs()[_number] == 0) {
-            accs += QString(CACanorus::fetaCodepoint("accidentals.natural"));
+            accs += QString(fetaCodepoint("accidentals.natural"));
         } else if (figuredBassMark()->accs()[_number] == 1) {
-            accs += QString(CACanorus::fetaCodepoint("accidentals.sharp"));
+            accs += QString(fetaCodepoint("accidentals.sharp"));
         } else if (figuredBassMark()->accs()[_number] == 2) {
-            accs += QString(CACanorus::fetaCodepoint("accidentals.doublesharp"));
+            accs += QString(fetaCodepoint("accidentals.doublesharp"));
         }
     }
 
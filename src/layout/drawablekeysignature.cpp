@@ -5,7 +5,6 @@
 	Licensed under the GNU GENERAL PUBLIC LICENSE. See COPYING for details.
 */
 
-#include <QComboBox> // needed for populateComboBox()
 #include <QPainter>
 
 #include "layout/drawableaccidental.h"
@@ -15,8 +15,6 @@ class CADrawableStaff;
 class CAKeySignature;
 class CADrawableAccidental;
 
-class QComboBox;
-
 class CADrawableKeySignature : public CADrawableMusElement {
 public:
     CADrawableKeySignature(CAKeySignature* keySig, CADrawableStaff* staff, double x, double y);
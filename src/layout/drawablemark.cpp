@@ -14,7 +14,6 @@
 
 #include "interface/mididevice.h" // needed for instrument change
 
-#include "canorus.h"
 #include "score/articulation.h"
 #include "score/bookmark.h"
 #include "score/crescendo.h"
@@ -264,16 +263,16 @@ void CADrawableMark::draw(QPainter* p, CADrawSettings s)
         int y = qRound(s.y + (inverted ? 0 : (height() * s.z)));
         switch (static_cast<CAFermata*>(mark())->fermataType()) {
         case CAFermata::NormalFermata:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.ufermata") + inverted));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.ufermata") + inverted));
             break;
         case CAFermata::ShortFermata:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.ushortfermata") + inverted));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.ushortfermata") + inverted));
             break;
         case CAFermata::LongFermata:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.ulongfermata") + inverted));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.ulongfermata") + inverted));
             break;
         case CAFermata::VeryLongFermata:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.uverylongfermata") + inverted));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.uverylongfermata") + inverted));
             break;
         }
         break;
@@ -317,15 +316,15 @@ void CADrawableMark::draw(QPainter* p, CADrawSettings s)
         switch (static_cast<CARepeatMark*>(mark())->repeatMarkType()) {
         case CARepeatMark::Segno:
         case CARepeatMark::DalSegno:
-            p->drawText(s.x, s.y, QString(CACanorus::fetaCodepoint("scripts.segno")));
+            p->drawText(s.x, s.y, QString(fetaCodepoint("scripts.segno")));
             break;
         case CARepeatMark::Coda:
         case CARepeatMark::DalCoda:
-            p->drawText(s.x, s.y, QString(CACanorus::fetaCodepoint("scripts.coda")));
+            p->drawText(s.x, s.y, QString(fetaCodepoint("scripts.coda")));
             break;
         case CARepeatMark::VarCoda:
         case CARepeatMark::DalVarCoda:
-            p->drawText(s.x, s.y, QString(CACanorus::fetaCodepoint("scripts.varcoda")));
+            p->drawText(s.x, s.y, QString(fetaCodepoint("scripts.varcoda")));
             break;
         case CARepeatMark::Volta:
             break;
@@ -357,8 +356,8 @@ void CADrawableMark::draw(QPainter* p, CADrawSettings s)
         QFont font("Emmentaler");
         font.setPixelSize(qRound(DEFAULT_TEXT_SIZE * 1.6 * s.z));
         p->setFont(font);
-        p->drawText(s.x, s.y + qRound(height() * s.z), QString(CACanorus::fetaCodepoint("pedal.Ped")));
-        p->drawText(s.x + qRound((width() - 10) * s.z), s.y + qRound(height() * s.z), QString(CACanorus::fetaCodepoint("pedal.*")));
+        p->drawText(s.x, s.y + qRound(height() * s.z), QString(fetaCodepoint("pedal.Ped")));
+        p->drawText(s.x + qRound((width() - 10) * s.z), s.y + qRound(height() * s.z), QString(fetaCodepoint("pedal.*")));
 
         break;
     }
@@ -371,85 +370,85 @@ void CADrawableMark::draw(QPainter* p, CADrawSettings s)
         int y = s.y + qRound(height() * s.z);
         switch (static_cast<CAArticulation*>(mark())->articulationType()) {
         case CAArticulation::Accent:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.sforzato")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.sforzato")));
             break;
         case CAArticulation::Marcato:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.umarcato")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.umarcato")));
             break;
         case CAArticulation::Staccatissimo:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.ustaccatissimo")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.ustaccatissimo")));
             break;
         case CAArticulation::Espressivo:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.espr")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.espr")));
             break;
         case CAArticulation::Staccato:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.staccato")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.staccato")));
             break;
         case CAArticulation::Tenuto:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.tenuto")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.tenuto")));
             break;
         case CAArticulation::Breath:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.rcomma")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.rcomma")));
             break;
         case CAArticulation::Portato:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.uportato")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.uportato")));
             break;
         case CAArticulation::UpBow:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.upbow")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.upbow")));
             break;
         case CAArticulation::DownBow:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.downbow")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.downbow")));
             break;
         case CAArticulation::Flageolet:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.flageolet")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.flageolet")));
             break;
         case CAArticulation::Open:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.open")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.open")));
             break;
         case CAArticulation::Stopped:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.stopped")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.stopped")));
             break;
         case CAArticulation::Turn:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.turn")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.turn")));
             break;
         case CAArticulation::ReverseTurn:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.reverseturn")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.reverseturn")));
             break;
         case CAArticulation::Trill:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.trill")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.trill")));
             break;
         case CAArticulation::Prall:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.prall")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.prall")));
             break;
         case CAArticulation::Mordent:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.mordent")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.mordent")));
             break;
         case CAArticulation::PrallPrall:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.prallprall")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.prallprall")));
             break;
         case CAArticulation::PrallMordent:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.prallmordent")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.prallmordent")));
             break;
         case CAArticulation::UpPrall:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.upprall")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.upprall")));
             break;
         case CAArticulation::DownPrall:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.downprall")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.downprall")));
             break;
         case CAArticulation::UpMordent:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.upmordent")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.upmordent")));
             break;
         case CAArticulation::DownMordent:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.downmordent")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.downmordent")));
             break;
         case CAArticulation::PrallDown:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.pralldown")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.pralldown")));
             break;
         case CAArticulation::PrallUp:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.prallup")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.prallup")));
             break;
         case CAArticulation::LinePrall:
-            p->drawText(x, y, QString(CACanorus::fetaCodepoint("scripts.lineprall")));
+            p->drawText(x, y, QString(fetaCodepoint("scripts.lineprall")));
             break;
         case CAArticulation::Undefined:
             fprintf(stderr, "Warning: CADrawableMark::draw - Unhandled A-Type %d", static_cast<CAArticulation*>(mark())->articulationType());
@@ -479,15 +478,15 @@ QString CADrawableMark::fingerListToString(const QList<CAFingering::CAFingerNumb
         if (list[i] > 0 && list[i] < 6)
             text += QString::number(list[i]);
         else if (list[i] == CAFingering::Thumb)
-            text += QString(CACanorus::fetaCodepoint("scripts.thumb"));
+            text += QString(fetaCodepoint("scripts.thumb"));
         else if (list[i] == CAFingering::LHeel)
-            text += QString(CACanorus::fetaCodepoint("scripts.upedalheel"));
+            text += QString(fetaCodepoint("scripts.upedalheel"));
         else if (list[i] == CAFingering::RHeel)
-            text += QString(CACanorus::fetaCodepoint("scripts.dpedalheel"));
+            text += QString(fetaCodepoint("scripts.dpedalheel"));
         else if (list[i] == CAFingering::LToe)
-            text += QString(CACanorus::fetaCodepoint("scripts.upedaltoe"));
+            text += QString(fetaCodepoint("scripts.upedaltoe"));
         else if (list[i] == CAFingering::RToe)
-            text += QString(CACanorus::fetaCodepoint("scripts.dpedaltoe"));
+            text += QString(fetaCodepoint("scripts.dpedaltoe"));
     }
 
     return text;
@@ -8,7 +8,6 @@
 #ifndef DRAWABLETIMESIGNATURE_H_
 #define DRAWABLETIMESIGNATURE_H_
 
-#include "canorus.h"
 #include "layout/drawablemuselement.h"
 #include "score/timesignature.h"
 
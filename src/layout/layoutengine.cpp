@@ -11,7 +11,7 @@
 
 #include "layout/layoutengine.h"
 
-#include "widgets/scoreview.h"
+#include "layout/layouttarget.h"
 
 #include "layout/drawableaccidental.h"
 #include "layout/drawablebarline.h"
@@ -66,9 +66,6 @@
 #define INITIAL_X_OFFSET 20 // space between the left border and the first music element
 #define MINIMUM_SPACE 10 // minimum space between the music elements
 
-QList<CADrawableMusElement*> CALayoutEngine::scalableElts;
-int* CALayoutEngine::streamsRehersalMarks;
-
 /*!
 	\class CAEngraver
 	\brief Class for correctly placing the abstract notes to the score canvas.
@@ -78,10 +75,10 @@ int* CALayoutEngine::streamsRehersalMarks;
 */
 
 /*!
-	Repositions the notes in the abstract sheet of the given score view \a v so they fit nicely.
+	Repositions the notes in the abstract sheet of the given layout target \a v so they fit nicely.
 	This function doesn't clear the view, but only adds the elements.
 */
-void CALayoutEngine::reposit(CAScoreView* v)
+void CALayoutEngine::reposit(CALayoutTarget* v)
 {
     //int i;
     CASheet* sheet = v->sheet();
@@ -200,7 +197,6 @@ void CALayoutEngine::reposit(CAScoreView* v)
     int* streamsRehersalMarks = new int[streams];
     for (unsigned int i = 0; i < streams; i++)
         streamsRehersalMarks[i] = 0;
-    CALayoutEngine::streamsRehersalMarks = streamsRehersalMarks;
     /// \todo replace raw pointer with shared or unique pointer
     CAClef** lastClef = new CAClef*[streams];
     for (unsigned int i = 0; i < streams; i++)
@@ -213,7 +209,7 @@ void CALayoutEngine::reposit(CAScoreView* v)
     CATimeSignature** lastTimeSig = new CATimeSignature*[streams];
     for (unsigned int i = 0; i < streams; i++)
         lastTimeSig[i] = nullptr;
-    scalableElts.clear();
+    QList<CADrawableMusElement*> scalableElts; // placed after all the other elements
 
     int timeStart = 0;
     bool done = false;
@@ -283,7 +279,7 @@ void CALayoutEngine::reposit(CAScoreView* v)
                         streamsX[i] += (clef->neededWidth() + MINIMUM_SPACE);
                         //placedSymbol = true;
 
-                        placeMarks(clef, v, static_cast<int>(i));
+                        placeMarks(clef, v, static_cast<int>(i), streamsRehersalMarks, scalableElts);
 
                         break;
                     }
@@ -304,7 +300,7 @@ void CALayoutEngine::reposit(CAScoreView* v)
                         streamsX[i] += (keySig->neededWidth() + MINIMUM_SPACE);
                         //placedSymbol = true;
 
-                        placeMarks(keySig, v, static_cast<int>(i));
+                        placeMarks(keySig, v, static_cast<int>(i), streamsRehersalMarks, scalableElts);
 
                         break;
                     }
@@ -325,7 +321,7 @@ void CALayoutEngine::reposit(CAScoreView* v)
                         streamsX[i] += (timeSig->neededWidth() + MINIMUM_SPACE);
                         //placedSymbol = true;
 
-                        placeMarks(timeSig, v, static_cast<int>(i));
+                        placeMarks(timeSig, v, static_cast<int>(i), streamsRehersalMarks, scalableElts);
 
                         break;
                     }
@@ -393,7 +389,7 @@ void CALayoutEngine::reposit(CAScoreView* v)
                 streamsX[i] += (bar->neededWidth() + MINIMUM_SPACE);
                 streamsIdx[i] = streamsIdx[i] + 1;
 
-                placeMarks(bar, v, static_cast<int>(i));
+                placeMarks(bar, v, static_cast<int>(i), streamsRehersalMarks, scalableElts);
                 placeNoteCheckerErrors(bar, v);
             }
         }
@@ -616,7 +612,7 @@ void CALayoutEngine::reposit(CAScoreView* v)
                     if (static_cast<CANote*>(elt)->isLastInChord())
                         streamsX[i] += (newElt->neededWidth() + MINIMUM_SPACE);
 
-                    placeMarks(newElt, v, static_cast<int>(i));
+                    placeMarks(newElt, v, static_cast<int>(i), streamsRehersalMarks, scalableElts);
 
                     break;
                 }
@@ -656,7 +652,7 @@ void CALayoutEngine::reposit(CAScoreView* v)
                         v->addMElement(dTuplet);
                     }
 
-                    placeMarks(newElt, v, static_cast<int>(i));
+                    placeMarks(newElt, v, static_cast<int>(i), streamsRehersalMarks, scalableElts);
 
                     break;
                 }
@@ -1000,8 +996,10 @@ void CALayoutEngine::reposit(CAScoreView* v)
 
 /*!
 	Place marks for the given music element.
+	Rehersal marks are numbered using the counters \a streamsRehersalMarks and the scalable
+	marks are appended to \a scalableElts to be placed at the end of reposit().
 */
-void CALayoutEngine::placeMarks(CADrawableMusElement* e, CAScoreView* v, int streamIdx)
+void CALayoutEngine::placeMarks(CADrawableMusElement* e, CALayoutTarget* v, int streamIdx, int* streamsRehersalMarks, QList<CADrawableMusElement*>& scalableElts)
 {
     CAMusElement* elt = e->musElement();
     double xCoord = e->xPos();
@@ -1054,7 +1052,7 @@ void CALayoutEngine::placeMarks(CADrawableMusElement* e, CAScoreView* v, int str
     }
 }
 
-void CALayoutEngine::placeNoteCheckerErrors(CADrawableMusElement* dMusElt, CAScoreView* v)
+void CALayoutEngine::placeNoteCheckerErrors(CADrawableMusElement* dMusElt, CALayoutTarget* v)
 {
     QList<CANoteCheckerError*> ncErrors = dMusElt->musElement()->noteCheckerErrorList();
     for (int i = 0; i < ncErrors.size(); i++) {
@@ -10,18 +10,16 @@
 
 #include <QList>
 
-class CAScoreView;
+class CALayoutTarget;
 class CADrawableMusElement;
 
 class CALayoutEngine {
 public:
-    static void reposit(CAScoreView* v);
+    static void reposit(CALayoutTarget* v);
 
 private:
-    static void placeMarks(CADrawableMusElement*, CAScoreView*, int);
-    static void placeNoteCheckerErrors(CADrawableMusElement*, CAScoreView*);
-    static int* streamsRehersalMarks;
-    static QList<CADrawableMusElement*> scalableElts;
+    static void placeMarks(CADrawableMusElement*, CALayoutTarget*, int, int* streamsRehersalMarks, QList<CADrawableMusElement*>& scalableElts);
+    static void placeNoteCheckerErrors(CADrawableMusElement*, CALayoutTarget*);
 };
 
 #endif /* LAYOUTENGINE_ */
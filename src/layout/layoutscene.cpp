@@ -0,0 +1,189 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QPainter>
+
+#include <algorithm>
+
+#include "layout/layoutengine.h"
+#include "layout/layoutscene.h"
+
+#include "score/rest.h"
+#include "score/sheet.h"
+
+/*!
+	\class CALayoutScene
+	\brief Drawable elements of a sheet without the user interface
+
+	Layout scene is the layout target for the programs using the score model and the layout
+	engine without the user interface (eg. a server rendering the scores or a benchmark).
+	It only stores the drawable elements created by CALayoutEngine and paints them to any
+	QPainter device, for example QImage, QSvgGenerator or QPrinter.
+
+	Music fonts need to be registered to QFontDatabase before painting, see CACanorus::initFonts().
+
+	\code
+	  CALayoutScene scene(sheet);
+	  scene.rebuild();
+	  QImage image((scene.size() * zoom).toSize(), QImage::Format_ARGB32);
+	  image.fill(Qt::white);
+	  QPainter p(&image);
+	  scene.paint(&p, zoom);
+	\endcode
+
+	\sa CAScoreView, CALayoutTarget
+*/
+
+CALayoutScene::CALayoutScene(CASheet* sheet)
+    : _sheet(sheet)
+{
+}
+
+CALayoutScene::~CALayoutScene()
+{
+    clear();
+}
+
+/*!
+	Destroys the existing drawable elements and lays out the sheet again.
+*/
+void CALayoutScene::rebuild()
+{
+    clear();
+    if (_sheet) {
+        CALayoutEngine::reposit(this);
+    }
+}
+
+/*!
+	Destroys all the drawable elements.
+*/
+void CALayoutScene::clear()
+{
+    _mapDrawable.clear();
+    _drawableNCEList.clear(true);
+    _drawableMList.clear(true);
+    _drawableCList.clear(true);
+}
+
+/*!
+	Adds a drawable music element \a elt to the scene. There is no selection in the scene,
+	so \a select is ignored.
+*/
+void CALayoutScene::addMElement(CADrawableMusElement* elt, bool)
+{
+    _drawableMList.addElement(elt);
+    _mapDrawable.insertMulti(elt->musElement(), elt);
+    elt->drawableContext()->addMElement(elt);
+}
+
+/*!
+	Adds a drawable context \a elt to the scene.
+*/
+void CALayoutScene::addCElement(CADrawableContext* elt, bool)
+{
+    _drawableCList.addElement(elt);
+}
+
+void CALayoutScene::addDrawableNoteCheckerError(CADrawableNoteCheckerError* dnce)
+{
+    _drawableNCEList.addElement(dnce);
+}
+
+/*!
+	Finds the first drawable instance of the given abstract music element \a elt.
+*/
+CADrawableMusElement* CALayoutScene::findMElement(CAMusElement* elt)
+{
+    if (!elt) {
+        return nullptr;
+    }
+
+    return _mapDrawable.value(elt, nullptr);
+}
+
+/*!
+	Returns the X coordinate for the given Canorus \a time.
+	Returns -1, if such a time doesn't exist in the score.
+
+	\sa CAScoreView::timeToCoords()
+*/
+double CALayoutScene::timeToCoords(int time)
+{
+    CADrawableMusElement* leftElt = nullptr;
+    CADrawableMusElement* rightElt = nullptr;
+
+    QList<CAVoice*> voiceList = _sheet->voiceList();
+    for (int i = 0; i < voiceList.size(); i++) {
+        const QList<CAMusElement*>& list = voiceList[i]->musElementList();
+
+        // get the element still smaller or equal, but nearest to time
+        QList<CAMusElement*>::const_iterator it = std::lower_bound(list.constBegin(), list.constEnd(), time, [](const CAMusElement* a, int b) { return a->timeStart() < b; });
+        if (it != list.constEnd() && _mapDrawable.contains(*it)) {
+            CADrawableMusElement* dElt = _mapDrawable.values(*it).last();
+            if (!leftElt || leftElt->xPos() < dElt->xPos()) {
+                leftElt = dElt;
+            }
+        }
+
+        // and for the right element
+        it = std::upper_bound(list.constBegin(), list.constEnd(), time, [](int a, const CAMusElement* b) { return a < b->timeStart(); });
+        if (it != list.constEnd() && _mapDrawable.contains(*it)) {
+            CADrawableMusElement* dElt = _mapDrawable.values(*it).first();
+            if (!rightElt || rightElt->xPos() > dElt->xPos()) {
+                rightElt = dElt;
+            }
+        }
+    }
+
+    // get the relative position between the nearest left and the nearest right elements
+    if (leftElt && rightElt && leftElt->musElement() && rightElt->musElement()) {
+        int delta = (rightElt->musElement()->timeStart() - leftElt->musElement()->timeStart());
+        if (!delta)
+            delta = 1;
+        return leftElt->xPos() + (rightElt->xPos() - leftElt->xPos()) * static_cast<double>(time - leftElt->musElement()->timeStart() / static_cast<double>(delta));
+    } else {
+        return -1;
+    }
+}
+
+/*!
+	Returns the size of the laid out sheet in absolute world units.
+*/
+QSizeF CALayoutScene::size()
+{
+    return QSizeF(qMax(_drawableMList.getMaxX(), _drawableCList.getMaxX()), qMax(_drawableMList.getMaxY(), _drawableCList.getMaxY()));
+}
+
+/*!
+	Paints the whole sheet to the painter \a p using the given \a zoom level.
+	Contexts and music elements are painted using the given \a color, unless the element
+	has its own color. Hidden elements are not painted.
+*/
+void CALayoutScene::paint(QPainter* p, double zoom, const QColor& color)
+{
+    QSizeF world = size();
+    int w = qRound(world.width() * zoom);
+    int h = qRound(world.height() * zoom);
+
+    QList<CADrawableContext*> cList = _drawableCList.list();
+    for (int i = 0; i < cList.size(); i++) {
+        CADrawSettings s = { zoom, qRound(cList[i]->xPos() * zoom), qRound(cList[i]->yPos() * zoom), w, h, color, 0, 0 };
+        cList[i]->draw(p, s);
+    }
+
+    QList<CADrawableMusElement*> mList = _drawableMList.list();
+    for (int i = 0; i < mList.size(); i++) {
+        CAMusElement* elt = mList[i]->musElement();
+        if (elt && (!elt->isVisible() || (elt->musElementType() == CAMusElement::Rest && static_cast<CARest*>(elt)->restType() == CARest::Hidden))) {
+            continue;
+        }
+
+        CADrawSettings s = { zoom, qRound(mList[i]->xPos() * zoom), qRound(mList[i]->yPos() * zoom), w, h, (elt && elt->color().isValid()) ? elt->color() : color, 0, 0 };
+        mList[i]->draw(p, s);
+    }
+}
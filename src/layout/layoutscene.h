@@ -0,0 +1,52 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef LAYOUTSCENE_H_
+#define LAYOUTSCENE_H_
+
+#include <QColor>
+#include <QMultiHash>
+#include <QSizeF>
+
+#include "layout/kdtree.h"
+#include "layout/layouttarget.h"
+
+class QPainter;
+
+class CALayoutScene : public CALayoutTarget {
+public:
+    CALayoutScene(CASheet* sheet);
+    ~CALayoutScene();
+
+    inline CASheet* sheet() { return _sheet; }
+    inline void setSheet(CASheet* sheet) { _sheet = sheet; }
+
+    void rebuild();
+    void clear();
+
+    void addMElement(CADrawableMusElement* elt, bool select = false);
+    void addCElement(CADrawableContext* elt, bool select = false);
+    void addDrawableNoteCheckerError(CADrawableNoteCheckerError* dnce);
+
+    CADrawableMusElement* findMElement(CAMusElement* elt);
+    double timeToCoords(int time);
+
+    inline CAKDTree<CADrawableMusElement*>& drawableMElements() { return _drawableMList; }
+    inline CAKDTree<CADrawableContext*>& drawableCElements() { return _drawableCList; }
+
+    QSizeF size();
+    void paint(QPainter* p, double zoom = 1.0, const QColor& color = Qt::black);
+
+private:
+    CASheet* _sheet;
+    CAKDTree<CADrawableMusElement*> _drawableMList;
+    CAKDTree<CADrawableContext*> _drawableCList;
+    CAKDTree<CADrawableNoteCheckerError*> _drawableNCEList;
+    QMultiHash<CAMusElement*, CADrawableMusElement*> _mapDrawable; // music element -> its drawable instances
+};
+
+#endif /* LAYOUTSCENE_H_ */
@@ -0,0 +1,43 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef LAYOUTTARGET_H_
+#define LAYOUTTARGET_H_
+
+class CASheet;
+class CAMusElement;
+class CADrawableMusElement;
+class CADrawableContext;
+class CADrawableNoteCheckerError;
+
+/*!
+	\class CALayoutTarget
+	\brief Receiver of the drawable elements created by the layout engine
+
+	CALayoutEngine::reposit() creates the drawable instances of the given sheet and adds them
+	to the layout target. The target owns the added drawable elements.
+
+	CAScoreView is the layout target of the user interface. CALayoutScene is used to lay out
+	and paint the sheet without the user interface.
+
+	\sa CALayoutEngine
+*/
+class CALayoutTarget {
+public:
+    virtual ~CALayoutTarget() {}
+
+    virtual CASheet* sheet() = 0;
+
+    virtual void addMElement(CADrawableMusElement* elt, bool select = false) = 0;
+    virtual void addCElement(CADrawableContext* elt, bool select = false) = 0;
+    virtual void addDrawableNoteCheckerError(CADrawableNoteCheckerError* dnce) = 0;
+
+    virtual CADrawableMusElement* findMElement(CAMusElement* elt) = 0;
+    virtual double timeToCoords(int time) = 0;
+};
+
+#endif /* LAYOUTTARGET_H_ */
@@ -9,11 +9,14 @@
 #include <QFile>
 #include <QFont>
 #include <QSplashScreen>
+#include <QTimer>
 
 // Python.h needs to be loaded first!
 #include "canorus.h"
+#include "core/autorecovery.h"
+#include "core/converter.h"
 #include "core/settings.h"
-#include "interface/pluginmanager.h"
+#include "core/startupprofile.h"
 #include "ui/mainwin.h"
 #include "ui/settingsdialog.h"
 
@@ -34,10 +37,23 @@ void catch_sig(int)
 /*!
 	Main function. This is the first function called when Canorus is run.
 	It initializes CACanorus class and creates the main window.
+	If --convert is passed, it only converts the given files, see CAConverter.
+	If --startup-profile is passed, the duration of each initialization step is printed,
+	see CAStartupProfile.
 */
 int main(int argc, char* argv[])
 {
+    CAStartupProfile::start();
+
+    // Headless conversion doesn't need any GUI, device or scripting subsystem
+    if (CAConverter::isConvertCommand(argc, argv)) {
+        QCoreApplication convertApp(argc, argv);
+        CACanorus::initMain();
+        return CAConverter::exec(convertApp.arguments());
+    }
+
     QApplication mainApp(argc, argv);
+    CAStartupProfile::step("QApplication");
 
 #ifdef Q_WS_X11
     signal(SIGINT, catch_sig);
@@ -45,6 +61,7 @@ int main(int argc, char* argv[])
 #endif
 
     CACanorus::initSearchPaths();
+    CAStartupProfile::step("Search paths");
 
     QPixmap splashPixmap(400, 300);
     splashPixmap = QPixmap("images:splash.png");
@@ -54,9 +71,11 @@ int main(int argc, char* argv[])
     font.setPixelSize(17);
     splash.setFont(font);
     mainApp.processEvents();
+    CAStartupProfile::step("Splash screen");
 
     // Set main application properties
     CACanorus::initMain();
+    CAStartupProfile::step("Main");
 
     // Parse switch and settings command line arguments
     if (!CACanorus::parseSettingsArguments(argc, argv))
@@ -66,56 +85,51 @@ int main(int argc, char* argv[])
 
     // Load system translation if found
     CACanorus::initTranslations();
+    CAStartupProfile::step("Translations");
 
-    // Init MIDI devices
+    // Init MIDI devices, the MIDI system is connected when first used
     CACanorus::initPlayback();
+    CAStartupProfile::step("Playback");
 
-    // Load config file
+    // Load config file, the MIDI ports are enumerated in the background
     bool firstTime = !QFile::exists(CASettings::defaultSettingsPath() + "/canorus.ini");
     CASettingsDialog::CASettingsPage showSettingsPage = CACanorus::initSettings();
-
-    // Enable scripting and plugins subsystem
-    splash.showMessage(QObject::tr("Initializing Scripting engine", "splashScreen"), Qt::AlignBottom | Qt::AlignLeft, Qt::white);
-    mainApp.processEvents();
-    CACanorus::initScripting();
-
-    // Finds all the plugins
-    splash.showMessage(QObject::tr("Reading Plugins", "splashScreen"), Qt::AlignBottom | Qt::AlignLeft, Qt::white);
-    mainApp.processEvents();
-    CAPluginManager::readPlugins();
+    CAStartupProfile::step("Settings");
 
     // Initialize autosave
     splash.showMessage(QObject::tr("Initializing Automatic recovery", "splashScreen"), Qt::AlignBottom | Qt::AlignLeft, Qt::white);
     mainApp.processEvents();
     CACanorus::initAutoRecovery();
-
-    // Initialize help
-    splash.showMessage(QObject::tr("Initializing Help", "splashScreen"), Qt::AlignBottom | Qt::AlignLeft, Qt::white);
-    mainApp.processEvents();
-    CACanorus::initHelp();
+    CAStartupProfile::step("Automatic recovery");
 
     // Initialize undo/redo stacks
     splash.showMessage(QObject::tr("Initializing Undo/Redo framework", "splashScreen"), Qt::AlignBottom | Qt::AlignLeft, Qt::white);
     mainApp.processEvents();
     CACanorus::initUndo();
+    CAStartupProfile::step("Undo/Redo");
 
     // Load bundled fonts
     splash.showMessage(QObject::tr("Loading fonts", "splashScreen"), Qt::AlignBottom | Qt::AlignLeft, Qt::white);
     mainApp.processEvents();
     CACanorus::initFonts();
+    CAStartupProfile::step("Fonts");
 
     // Check for any crashed Canorus sessions and open the recovery files
     splash.showMessage(QObject::tr("Searching for recovery documents", "splashScreen"), Qt::AlignBottom | Qt::AlignLeft, Qt::white);
     mainApp.processEvents();
     CACanorus::autoRecovery()->openRecovery();
+    CAStartupProfile::step("Recovery documents");
 
     // Creates a main window of a document to open if passed in command line
     splash.showMessage(QObject::tr("Initializing Main window", "splashScreen"), Qt::AlignBottom | Qt::AlignLeft, Qt::white);
     mainApp.processEvents();
     CACanorus::parseOpenFileArguments(argc, argv);
+    CAStartupProfile::step("Open files");
 
     // If no file to open is passed in command line, create a new default main window. It's shown automatically by CACanorus::addMainWin().
-    if (!CACanorus::mainWinList().size()) {
+    // Recovered documents are still being loaded in the background and open their own main windows.
+    // The scripting isn't initialized yet, so the default document is created in C++.
+    if (!CACanorus::mainWinList().size() && !CACanorus::autoRecovery()->recoveryPending()) {
         CAMainWin* mainWin = new CAMainWin();
 
         // Init dialogs etc.
@@ -126,12 +140,7 @@ int main(int argc, char* argv[])
 
         mainWin->newDocument();
         mainWin->show();
-
-        // Init dialogs etc.
-        CACanorus::initCommonGUI(mainWin->uiSaveDialog,
-            mainWin->uiOpenDialog,
-            mainWin->uiExportDialog,
-            mainWin->uiImportDialog);
+        CAStartupProfile::step("First main window");
 
         if (firstTime) {
             mainWin->on_uiUsersGuide_triggered();
@@ -139,10 +148,37 @@ int main(int argc, char* argv[])
     }
     splash.close();
 
-    // Show settings dialog, if needed (eg. MIDI setup when running Canorus for the first time)
-    if (showSettingsPage != CASettingsDialog::UndefinedSettings) {
-        CASettingsDialog(showSettingsPage, CACanorus::mainWinList()[0]);
-    }
+    // The rest is done after the first event loop iteration shows the main window
+    QTimer::singleShot(0, [showSettingsPage]() mutable {
+        CAStartupProfile::step("First event loop iteration");
+
+        // Enable scripting and plugins subsystem, the plugin menus are added to the opened main windows
+        CACanorus::initPlugins();
+        CAStartupProfile::step("Scripting and plugins");
+
+        // Check the MIDI settings against the ports enumerated in the background
+        CASettingsDialog::CASettingsPage midiSettingsPage = CACanorus::checkMidiPorts();
+        if (showSettingsPage == CASettingsDialog::UndefinedSettings) {
+            showSettingsPage = midiSettingsPage;
+        }
+        CAStartupProfile::step("MIDI ports");
+
+        if (CAStartupProfile::isEnabled()) {
+            CAStartupProfile::print();
+        }
+
+        // Show settings dialog, if needed (eg. MIDI setup when running Canorus for the first time)
+        if (showSettingsPage != CASettingsDialog::UndefinedSettings) {
+            if (CACanorus::mainWinList().size()) {
+                CASettingsDialog(showSettingsPage, CACanorus::mainWinList()[0]);
+            } else {
+                // the main window is opened when the pending recovery is finished
+                QObject::connect(CACanorus::autoRecovery(), &CAAutoRecovery::recoveryFinished, [showSettingsPage]() {
+                    CASettingsDialog(showSettingsPage, CACanorus::mainWinList()[0]);
+                });
+            }
+        }
+    });
 
     return mainApp.exec();
 }
@@ -6,6 +6,7 @@
 */
 
 #include "score/barline.h"
+#include "interface/playbacktimeline.h"
 #include "score/mark.h"
 #include "score/staff.h"
 
@@ -38,6 +39,15 @@ CABarline::~CABarline()
 {
 }
 
+/*!
+	Sets the barline type \a t and invalidates the playback timeline of the staff.
+*/
+void CABarline::setBarlineType(CABarlineType t)
+{
+    _barlineType = t;
+    CAPlaybackTimeline::invalidate(this);
+}
+
 CABarline* CABarline::clone(CAContext* context)
 {
     CABarline* b = new CABarline(barlineType(), static_cast<CAStaff*>(context), timeStart());
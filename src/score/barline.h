@@ -33,7 +33,7 @@ public:
     int compare(CAMusElement* elt);
 
     CABarlineType barlineType() { return _barlineType; }
-    void setBarlineType(CABarlineType t) { _barlineType = t; }
+    void setBarlineType(CABarlineType t);
 
     static const QString barlineTypeToString(CABarlineType);
     static CABarlineType barlineTypeFromString(const QString);
@@ -13,6 +13,9 @@
 #include "score/sheet.h"
 #include "score/staff.h"
 
+CADocument::CABatchFunction CADocument::_beginBatchFunction = nullptr;
+CADocument::CABatchFunction CADocument::_endBatchFunction = nullptr;
+
 /*!
 	\class CADocument
 	\brief Class which represents the current document.
@@ -36,6 +39,7 @@ CADocument::CADocument()
     setTimeEdited(0);
     setArchive(new CAArchive());
     setModified(false);
+    _batchLevel = 0;
 }
 
 /*!
@@ -146,3 +150,68 @@ CASheet* CADocument::findSheet(const QString name)
 
     return nullptr;
 }
+
+/*!
+	Starts a batch of changes of the document, usually made by a script.
+
+	Until the matching endBatch(), CAStaff::synchronizeVoices() only marks the staffs and the
+	user interface isn't rebuilt. Everything is done once, when the batch ends. This
+	makes inserting many elements linear instead of quadratic. The whole batch is a single
+	undo step in the user interface, see setBatchFunctions().
+
+	The batches can be nested, only the outermost one counts.
+
+	\code
+	  document.beginBatch()
+	  for i in range(1000):
+	      voice.append(CanorusPython.CANote(...))
+	  document.endBatch()
+	\endcode
+
+	In Python, the batch is also available as a context manager "with document.batch():".
+
+	\sa endBatch(), isBatch()
+*/
+void CADocument::beginBatch()
+{
+    if (_batchLevel++ == 0 && _beginBatchFunction) {
+        _beginBatchFunction(this);
+    }
+}
+
+/*!
+	Ends the batch started by beginBatch(). When the outermost batch ends, synchronizes the
+	voices of the staffs changed in the batch and calls the function set by
+	setBatchFunctions(), which rebuilds the user interface.
+*/
+void CADocument::endBatch()
+{
+    if (_batchLevel <= 0 || --_batchLevel > 0) {
+        return;
+    }
+
+    for (CASheet* sheet : _sheetList) {
+        for (CAStaff* staff : sheet->staffList()) {
+            if (staff->isSynchronizationPending()) {
+                staff->synchronizeVoices();
+            }
+        }
+    }
+
+    if (_endBatchFunction) {
+        _endBatchFunction(this);
+    }
+}
+
+/*!
+	Sets the functions called at the beginning and at the end of the outermost batch of any
+	document. The user interface uses them to create the undo command and to check the notes
+	and rebuild the main windows once.
+
+	\sa beginBatch()
+*/
+void CADocument::setBatchFunctions(CABatchFunction begin, CABatchFunction end)
+{
+    _beginBatchFunction = begin;
+    _endBatchFunction = end;
+}
@@ -73,6 +73,15 @@ public:
     void setModified(bool m) { _modified = m; }
     void setArchive(CAArchive* a) { _archive = a; }
 
+    void beginBatch();
+    void endBatch();
+    inline bool isBatch() { return _batchLevel > 0; }
+
+#ifndef SWIG
+    typedef void (*CABatchFunction)(CADocument*);
+    static void setBatchFunctions(CABatchFunction begin, CABatchFunction end);
+#endif
+
 private:
     QList<CASheet*> _sheetList;
     QList<std::shared_ptr<CAResource> > _resourceList;
@@ -96,5 +105,11 @@ private:
     QString _fileName; // absolute filename of the document
     bool _modified; // unsaved changes
     CAArchive* _archive; // pointer to existing archive, if it exists
+    int _batchLevel; // number of nested beginBatch() calls
+
+#ifndef SWIG
+    static CABatchFunction _beginBatchFunction;
+    static CABatchFunction _endBatchFunction;
+#endif
 };
 #endif /* DOCUMENT_H_ */
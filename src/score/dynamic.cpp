@@ -6,6 +6,7 @@
 */
 
 #include "score/dynamic.h"
+#include "interface/playbacktimeline.h"
 #include "score/note.h"
 
 /*!
@@ -26,6 +27,15 @@ CADynamic::~CADynamic()
 {
 }
 
+/*!
+	Sets the \a volume percentage and invalidates the playback timeline of the note.
+*/
+void CADynamic::setVolume(const int volume)
+{
+    _volume = volume;
+    CAPlaybackTimeline::invalidate(associatedElement());
+}
+
 CADynamic* CADynamic::clone(CAMusElement* elt)
 {
     return new CADynamic(text(), volume(), (elt->musElementType() == CAMusElement::Note) ? static_cast<CANote*>(elt) : nullptr);
@@ -47,7 +47,7 @@ public:
     inline const QString text() { return _text; }
     inline void setText(const QString t) { _text = t; }
     inline int volume() { return _volume; }
-    inline void setVolume(const int v) { _volume = v; }
+    void setVolume(const int v);
 
     static const QString dynamicTextToString(CADynamicText t);
     static CADynamicText dynamicTextFromString(const QString t);
@@ -6,6 +6,7 @@
 */
 
 #include "score/instrumentchange.h"
+#include "interface/playbacktimeline.h"
 #include "score/note.h"
 
 /*!
@@ -28,6 +29,15 @@ CAInstrumentChange::~CAInstrumentChange()
 {
 }
 
+/*!
+	Sets the midi program \a instrument and invalidates the playback timeline of the note.
+*/
+void CAInstrumentChange::setInstrument(const int instrument)
+{
+    _instrument = instrument;
+    CAPlaybackTimeline::invalidate(associatedElement());
+}
+
 CAInstrumentChange* CAInstrumentChange::clone(CAMusElement* elt)
 {
     return new CAInstrumentChange(instrument(), (elt->musElementType() == CAMusElement::Note) ? static_cast<CANote*>(elt) : nullptr);
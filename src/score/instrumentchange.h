@@ -22,7 +22,7 @@ public:
     int compare(CAMusElement*);
 
     inline int instrument() { return _instrument; }
-    inline void setInstrument(const int instrument) { _instrument = instrument; }
+    void setInstrument(const int instrument);
 
 private:
     int _instrument;
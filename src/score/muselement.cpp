@@ -6,12 +6,15 @@
 */
 
 #include "score/muselement.h"
+#include "interface/playbacktimeline.h"
 #include "score/articulation.h"
 #include "score/context.h"
 #include "score/mark.h"
 #include "score/notecheckererror.h"
 #include "score/playable.h"
+#include "score/sheet.h"
 #include "score/staff.h"
+#include "score/tempomap.h"
 
 /*!
 	\class CAMusElement
@@ -81,6 +84,37 @@ bool CAMusElement::isPlayable()
     return (musElementType() == Note || musElementType() == Rest); //dynamic_cast<CAPlayable*>(this);
 }
 
+/*!
+	Returns the real time in milliseconds from the beginning of the sheet when the element starts.
+	The time is resolved from the tempo map of the sheet. Elements outside any sheet are played
+	in the default tempo where each time unit takes one millisecond.
+
+	\sa realTimeLength(), CATempoMap
+*/
+int CAMusElement::realTimeStart()
+{
+    if (!context() || !context()->sheet()) {
+        return timeStart();
+    }
+
+    return static_cast<int>(context()->sheet()->tempoMap()->realTime(timeStart()) / 1000);
+}
+
+/*!
+	Returns the length of the element in milliseconds in the tempo of the sheet.
+
+	\sa realTimeStart()
+*/
+int CAMusElement::realTimeLength()
+{
+    if (!context() || !context()->sheet()) {
+        return timeLength();
+    }
+
+    CATempoMap* tempoMap = context()->sheet()->tempoMap();
+    return static_cast<int>((tempoMap->realTime(timeEnd()) - tempoMap->realTime(timeStart())) / 1000);
+}
+
 /*!
 	Converts a music element \a type to QString.
 
@@ -181,6 +215,26 @@ void CAMusElement::addMark(CAMark* mark)
     }
 
     _markList.insert(l, mark);
+
+    if (mark->markType() == CAMark::Tempo || mark->markType() == CAMark::Ritardando) {
+        CATempoMap::invalidate(context());
+    }
+    CAPlaybackTimeline::invalidate(this);
+}
+
+/*!
+	Removes the given \a mark from the mark list. The mark is not deleted.
+*/
+void CAMusElement::removeMark(CAMark* mark)
+{
+    if (!_markList.removeAll(mark)) {
+        return;
+    }
+
+    if (mark->markType() == CAMark::Tempo || mark->markType() == CAMark::Ritardando) {
+        CATempoMap::invalidate(context());
+    }
+    CAPlaybackTimeline::invalidate(this);
 }
 
 /*!
@@ -55,9 +55,9 @@ public:
     inline void setTimeLength(int length) { _timeLength = length; }
     inline int timeEnd() { return timeStart() + timeLength(); }
 
-    inline virtual int realTimeStart() { return _timeStart; } // TODO: calculates and returns time in miliseconds
-    inline virtual int realTimeLength() { return _timeLength; } // TODO: calculates and returns time in miliseconds
-    inline int realTimeEnd() { return realTimeStart() + realTimeLength(); } // TODO: calculates and returns time in miliseconds
+    virtual int realTimeStart();
+    virtual int realTimeLength();
+    inline int realTimeEnd() { return realTimeStart() + realTimeLength(); }
 
     inline const QString name() { return _name; }
     inline void setName(const QString name) { _name = name; }
@@ -71,7 +71,7 @@ public:
     inline const QList<CAMark*> markList() { return _markList; }
     void addMark(CAMark* mark);
     void addMarks(QList<CAMark*> marks);
-    inline void removeMark(CAMark* mark) { _markList.removeAll(mark); }
+    void removeMark(CAMark* mark);
 
     inline const QList<CANoteCheckerError*>& noteCheckerErrorList() { return _noteCheckerErrorList; }
     inline void addNoteCheckerError(CANoteCheckerError* nce) { _noteCheckerErrorList << nce; }
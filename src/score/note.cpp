@@ -6,6 +6,7 @@
 */
 
 #include "score/note.h"
+#include "interface/playbacktimeline.h"
 #include "score/clef.h"
 #include "score/mark.h"
 #include "score/staff.h"
@@ -35,10 +36,10 @@ CANote::CANote(CADiatonicPitch pitch, CAPlayableLength length, CAVoice* voice, i
     _forceAccidentals = false;
     _stemDirection = StemPreferred;
 
-    setTieStart(nullptr);
+    _tieStart = nullptr;
     setSlurStart(nullptr);
     setPhrasingSlurStart(nullptr);
-    setTieEnd(nullptr);
+    _tieEnd = nullptr;
     setSlurEnd(nullptr);
     setPhrasingSlurEnd(nullptr);
 
@@ -251,12 +252,33 @@ void CANote::setStemDirection(CAStemDirection dir)
     _stemDirection = dir;
 }
 
+/*!
+	Sets the tie starting at this note and invalidates the playback timeline of the sheet.
+*/
+void CANote::setTieStart(CASlur* tieStart)
+{
+    _tieStart = tieStart;
+    CAPlaybackTimeline::invalidate(voice(), timeStart());
+}
+
+/*!
+	Sets the tie ending at this note and invalidates the playback timeline of the sheet from
+	the start of the previously tied note on.
+*/
+void CANote::setTieEnd(CASlur* tieEnd)
+{
+    CAPlaybackTimeline::invalidate(voice(), (_tieEnd && _tieEnd->noteStart()) ? _tieEnd->noteStart()->timeStart() : timeStart());
+    _tieEnd = tieEnd;
+}
+
 /*!
 	Looks at the tieStart() and tieEnd() ties and unties the note and tie if the
 	previous/next note pitch differs.
 */
 void CANote::updateTies()
 {
+    CAPlaybackTimeline::invalidate(this);
+
     // break the tie, if needed
     if (tieStart() && tieStart()->noteEnd() && diatonicPitch() != tieStart()->noteEnd()->diatonicPitch()) {
         // break the tie, if the first note isn't the same pitch
@@ -55,8 +55,8 @@ public:
     CAStemDirection actualStemDirection();
     CASlur::CASlurDirection actualSlurDirection();
 
-    inline void setTieStart(CASlur* tieStart) { _tieStart = tieStart; }
-    inline void setTieEnd(CASlur* tieEnd) { _tieEnd = tieEnd; }
+    void setTieStart(CASlur* tieStart);
+    void setTieEnd(CASlur* tieEnd);
     inline void setSlurStart(CASlur* slurStart) { _slurStart = slurStart; }
     inline void setSlurEnd(CASlur* slurEnd) { _slurEnd = slurEnd; }
     inline void setPhrasingSlurStart(CASlur* pSlurStart) { _phrasingSlurStart = pSlurStart; }
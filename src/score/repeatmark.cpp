@@ -6,6 +6,7 @@
 */
 
 #include "score/repeatmark.h"
+#include "interface/playbacktimeline.h"
 #include "score/barline.h"
 
 /*!
@@ -28,6 +29,24 @@ CARepeatMark::~CARepeatMark()
 {
 }
 
+/*!
+	Sets the repeat mark type \a t and invalidates the playback timeline of the barline.
+*/
+void CARepeatMark::setRepeatMarkType(CARepeatMarkType t)
+{
+    _repeatMarkType = t;
+    CAPlaybackTimeline::invalidate(associatedElement());
+}
+
+/*!
+	Sets the volta number \a n and invalidates the playback timeline of the barline.
+*/
+void CARepeatMark::setVoltaNumber(int n)
+{
+    _voltaNumber = n;
+    CAPlaybackTimeline::invalidate(associatedElement());
+}
+
 CARepeatMark* CARepeatMark::clone(CAMusElement* elt)
 {
     return new CARepeatMark((elt->musElementType() == CAMusElement::Barline) ? static_cast<CABarline*>(elt) : nullptr, repeatMarkType(), voltaNumber());
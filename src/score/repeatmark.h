@@ -32,10 +32,10 @@ public:
     int compare(CAMusElement*);
 
     inline CARepeatMarkType repeatMarkType() { return _repeatMarkType; }
-    inline void setRepeatMarkType(CARepeatMarkType t) { _repeatMarkType = t; }
+    void setRepeatMarkType(CARepeatMarkType t);
 
     inline int voltaNumber() { return _voltaNumber; }
-    inline void setVoltaNumber(int n) { _voltaNumber = n; }
+    void setVoltaNumber(int n);
 
     static const QString repeatMarkTypeToString(CARepeatMarkType t);
     static CARepeatMarkType repeatMarkTypeFromString(const QString r);
@@ -6,7 +6,9 @@
 */
 
 #include "score/ritardando.h"
+#include "interface/playbacktimeline.h"
 #include "score/playable.h"
+#include "score/tempomap.h"
 
 /*!
 	\class CARitardando
@@ -31,6 +33,16 @@ CARitardando::~CARitardando()
 {
 }
 
+/*!
+	Sets the final tempo in beats per minute and invalidates the tempo map of the sheet.
+*/
+void CARitardando::setFinalTempo(const int t)
+{
+    _finalTempo = t;
+    CATempoMap::invalidate(context());
+    CAPlaybackTimeline::invalidate(associatedElement());
+}
+
 CARitardando* CARitardando::clone(CAMusElement* elt)
 {
     return new CARitardando(finalTempo(), (elt->isPlayable()) ? static_cast<CAPlayable*>(elt) : nullptr, timeLength(), ritardandoType());
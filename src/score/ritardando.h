@@ -26,7 +26,7 @@ public:
     int compare(CAMusElement*);
 
     inline int finalTempo() { return _finalTempo; }
-    inline void setFinalTempo(const int t) { _finalTempo = t; }
+    void setFinalTempo(const int t);
     inline CARitardandoType ritardandoType() { return _ritardandoType; }
     inline void setRitardandoType(CARitardandoType t) { _ritardandoType = t; }
 
@@ -8,6 +8,7 @@
 #include <QHash> // used for mapping when cloning the sheet to a new sheet
 #include <QObject> // QObject::tr
 
+#include "interface/playbacktimeline.h"
 #include "score/context.h"
 #include "score/document.h"
 #include "score/lyricscontext.h"
@@ -15,6 +16,7 @@
 #include "score/sheet.h"
 #include "score/staff.h"
 #include "score/tempo.h"
+#include "score/tempomap.h"
 #include "score/voice.h"
 
 /*!
@@ -37,10 +39,14 @@ CASheet::CASheet(const QString name, CADocument* doc)
 {
     _name = name;
     _document = doc;
+    _tempoMap = new CATempoMap(this);
+    _playbackTimeline = new CAPlaybackTimeline(this);
 }
 
 CASheet::~CASheet()
 {
+    delete _playbackTimeline;
+    delete _tempoMap;
 }
 
 /*!
@@ -100,6 +106,7 @@ void CASheet::clear()
     }
 
     _contextList.clear();
+    _playbackTimeline->invalidate();
 }
 
 /*!
@@ -153,18 +160,13 @@ QList<CAPlayable*> CASheet::getChord(int time)
 
 /*!
 	Returns the Tempo element active at the given time.
+	The tempo is looked up in the tempo map of the sheet.
+
+	\sa tempoMap()
  */
 CATempo* CASheet::getTempo(int time)
 {
-    CATempo* tempo = nullptr;
-    for (int i = 0; i < staffList().size(); i++) {
-        CATempo* t = staffList()[i]->getTempo(time);
-        if (t && (!tempo || t->timeStart() > tempo->timeStart())) {
-            tempo = t;
-        }
-    }
-
-    return tempo;
+    return tempoMap()->tempo(time);
 }
 
 /*!
@@ -204,6 +206,7 @@ void CASheet::insertContextAfter(CAContext* after, CAContext* c)
     } else {
         _contextList.insert(idx + 1, c);
     }
+    _tempoMap->invalidate();
 }
 
 /*!
@@ -13,9 +13,11 @@
 
 #include "score/context.h"
 #include "score/staff.h"
+#include "score/tempomap.h"
 
 class CADocument;
 class CAPlayable;
+class CAPlaybackTimeline;
 class CATempo;
 class CANoteCheckerError;
 
@@ -28,10 +30,22 @@ public:
 
     inline const QList<CAContext*>& contextList() { return _contextList; }
     CAContext* findContext(const QString name);
-    inline void insertContext(int pos, CAContext* c) { _contextList.insert(pos, c); }
+    inline void insertContext(int pos, CAContext* c)
+    {
+        _contextList.insert(pos, c);
+        _tempoMap->invalidate();
+    }
     void insertContextAfter(CAContext* after, CAContext* c);
-    inline void addContext(CAContext* c) { _contextList << c; }
-    inline void removeContext(CAContext* c) { _contextList.removeAll(c); }
+    inline void addContext(CAContext* c)
+    {
+        _contextList << c;
+        _tempoMap->invalidate();
+    }
+    inline void removeContext(CAContext* c)
+    {
+        _contextList.removeAll(c);
+        _tempoMap->invalidate();
+    }
     QString findUniqueContextName(QString mask);
 
     CAStaff* addStaff();
@@ -40,6 +54,8 @@ public:
 
     QList<CAPlayable*> getChord(int time);
     CATempo* getTempo(int time);
+    inline CATempoMap* tempoMap() { return _tempoMap; }
+    inline CAPlaybackTimeline* playbackTimeline() { return _playbackTimeline; }
 
     inline CADocument* document() { return _document; }
     inline void setDocument(CADocument* doc) { _document = doc; }
@@ -57,6 +73,8 @@ private:
     QList<CAContext*> _contextList;
     CADocument* _document;
     QList<CANoteCheckerError*> _noteCheckerErrorList;
+    CATempoMap* _tempoMap;
+    CAPlaybackTimeline* _playbackTimeline;
 
     QString _name;
 };
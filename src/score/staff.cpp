@@ -10,10 +10,13 @@
 #include <QPainter>
 #include <iostream>
 
+#include "score/document.h"
 #include "score/note.h"
 #include "score/rest.h" // used for voice synchronization
+#include "score/sheet.h"
 #include "score/staff.h"
 #include "score/tempo.h"
+#include "score/tempomap.h"
 #include "score/tuplet.h"
 #include "score/voice.h"
 
@@ -44,6 +47,7 @@ CAStaff::CAStaff(const QString name, CASheet* s, int numberOfLines)
     _contextType = CAContext::Staff;
     _numberOfLines = numberOfLines;
     _name = name;
+    _synchronizationPending = false;
 }
 
 CAStaff::~CAStaff()
@@ -328,9 +332,17 @@ QList<CAPlayable*> CAStaff::getChord(int time)
 
 /*!
 	Returns the Tempo element active at the given time.
+	The tempo is looked up in the tempo map of the sheet. Only the marks of the staff voices
+	are searched, if the staff isn't part of a sheet.
+
+	\sa CASheet::tempoMap()
  */
 CATempo* CAStaff::getTempo(int time)
 {
+    if (sheet()) {
+        return sheet()->tempoMap()->tempo(time);
+    }
+
     CATempo* tempo = nullptr;
     for (int i = 0; i < voiceList().size(); i++) {
         CATempo* t = voiceList()[i]->getTempo(time);
@@ -342,6 +354,16 @@ CATempo* CAStaff::getTempo(int time)
     return tempo;
 }
 
+/*!
+	Returns True, if the document of the staff is in a batch of changes.
+
+	\sa CADocument::beginBatch()
+*/
+bool CAStaff::isBatch()
+{
+    return sheet() && sheet()->document() && sheet()->document()->isBatch();
+}
+
 /*!
 	Fixes voices inconsistency:
 	1) If any of the voices include signs (key sigs, clefs etc.) which aren't present in all voices,
@@ -356,10 +378,21 @@ CATempo* CAStaff::getTempo(int time)
 	insertions and synchronization of the voices every time a new element is inserted would considerably
 	slow down the import filter.
 
-	\return True, if everything was ok. False, if fixes were needed.
+	If the document is in a batch, the staff is only marked and synchronized once, when the
+	batch ends. See CADocument::beginBatch().
+
+	\return True, if everything was ok. False, if fixes were needed. In a batch, nothing is
+	checked yet and True is returned. Use isSynchronizationPending() to tell the deferred
+	synchronization apart, or call this after the batch.
 */
 bool CAStaff::synchronizeVoices()
 {
+    if (isBatch()) {
+        _synchronizationPending = true;
+        return true;
+    }
+    _synchronizationPending = false;
+
     int* pidx = new int[voiceList().size()];
     for (int i = 0; i < voiceList().size(); i++)
         pidx[i] = -1; // array of current indices of voices at current timeStart
@@ -520,9 +553,12 @@ bool CAStaff::synchronizeVoices()
 	It searches for the time signature in effect for the last bar, not to get fooled by
 	time signature(s) already present at a time signature change.
 
+	If \a synchronize is False, the barline is only placed in the element's voice. Call
+	synchronizeVoices() afterwards when placing several barlines at once.
+
 	\return True, if a new barline was placed; otherwise False.
  */
-bool CAStaff::placeAutoBar(CAPlayable* elt)
+bool CAStaff::placeAutoBar(CAPlayable* elt, bool synchronize)
 {
     if (!elt)
         return false;
@@ -545,7 +581,9 @@ bool CAStaff::placeAutoBar(CAPlayable* elt)
     if (t) {
         if ((b ? (b->timeStart()) : 0) + t->barDuration() <= elt->timeStart()) {
             elt->voice()->insert(elt, new CABarline(CABarline::Single, elt->staff(), elt->timeStart()));
-            elt->staff()->synchronizeVoices();
+            if (synchronize) {
+                elt->staff()->synchronizeVoices();
+            }
 
             return true;
         }
@@ -52,8 +52,10 @@ public:
     CATempo* getTempo(int time);
 
     bool synchronizeVoices();
+    bool isBatch();
+    inline bool isSynchronizationPending() { return _synchronizationPending; }
 
-    static bool placeAutoBar(CAPlayable* elt);
+    static bool placeAutoBar(CAPlayable* elt, bool synchronize = true);
 
     // Functions to keep list of references of signature events for a faster look up.
     inline QList<CAMusElement*>& clefRefs() { return _clefList; }
@@ -65,6 +67,7 @@ private:
     QList<CAVoice*> _voiceList;
 
     int _numberOfLines;
+    bool _synchronizationPending; // voices were changed in a batch, see CADocument::beginBatch()
 
     QList<CAMusElement*> _clefList;
     QList<CAMusElement*> _keySignatureList;
@@ -6,6 +6,8 @@
 */
 
 #include "score/tempo.h"
+#include "interface/playbacktimeline.h"
+#include "score/tempomap.h"
 
 /*!
 	\class CATempo
@@ -26,6 +28,26 @@ CATempo::~CATempo()
 {
 }
 
+/*!
+	Sets the beats per minute and invalidates the tempo map of the sheet.
+*/
+void CATempo::setBpm(unsigned char bpm)
+{
+    _bpm = bpm;
+    CATempoMap::invalidate(context());
+    CAPlaybackTimeline::invalidate(associatedElement());
+}
+
+/*!
+	Sets the \a beat length and invalidates the tempo map of the sheet.
+*/
+void CATempo::setBeat(CAPlayableLength beat)
+{
+    _beat = beat;
+    CATempoMap::invalidate(context());
+    CAPlaybackTimeline::invalidate(associatedElement());
+}
+
 CATempo* CATempo::clone(CAMusElement* elt)
 {
     return new CATempo(beat(), bpm(), elt);
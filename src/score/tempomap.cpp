@@ -0,0 +1,329 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#include <QtMath>
+
+#include <algorithm>
+#include <climits>
+
+#include "score/context.h"
+#include "score/playablelength.h"
+#include "score/ritardando.h"
+#include "score/sheet.h"
+#include "score/tempo.h"
+#include "score/tempomap.h"
+#include "score/voice.h"
+
+/*!
+	\class CATempoMap
+	\brief Conversion between the score time and the real time of the sheet
+
+	Tempo map is a piecewise function built from the tempo and ritardando marks of all
+	the voices in the sheet. Each segment of the map either has a constant tempo or, for
+	ritardandos and accellerandos, the tempo changes linearly from the start to the end of
+	the ramp. The tempo of the last tempo mark is restored after the ramp, see CARitardando.
+	Real time of every segment start is precomputed, so realTime() and scoreTime()
+	only find the segment by binary search and evaluate it in constant time.
+
+	Every sheet owns its tempo map, see CASheet::tempoMap(). The map is rebuilt lazily on
+	the first query after it was invalidated. Voices invalidate it when music elements are
+	inserted, removed or moved and the tempo marks when they are added or changed.
+	The queries, the rebuild and the invalidation are serialized by a mutex, so the map can be
+	queried from a plugin job or an export thread while the GUI thread reads it. The playback
+	thread doesn't query the map at all, it uses the real times resolved in the immutable
+	snapshot of the CAPlaybackTimeline.
+
+	Repeats are not expanded here. The map converts the score time only, see
+	CAPlaybackTimeline for the playback time.
+
+	\sa CATempo, CARitardando, CAPlaybackTimeline
+*/
+
+/*!
+	Tempo used before the first tempo mark in quarters per minute.
+	Each time unit of the score takes one millisecond.
+*/
+const double CATempoMap::DEFAULT_QUARTERS_PER_MINUTE = 60000000.0 / 256000;
+
+CATempoMap::CATempoMap(CASheet* sheet)
+    : _sheet(sheet)
+    , _valid(false)
+{
+}
+
+CATempoMap::~CATempoMap()
+{
+}
+
+/*!
+	Returns True, if the map is up to date and doesn't need to be rebuilt on the next query.
+*/
+bool CATempoMap::isValid()
+{
+    QMutexLocker locker(&_mutex);
+    return _valid;
+}
+
+/*!
+	Marks the map to be rebuilt on the next query.
+*/
+void CATempoMap::invalidate()
+{
+    QMutexLocker locker(&_mutex);
+    _valid = false;
+}
+
+/*!
+	Invalidates the tempo map of the sheet the given \a context belongs to.
+	Does nothing if the context is not part of any sheet.
+*/
+void CATempoMap::invalidate(CAContext* context)
+{
+    if (context && context->sheet()) {
+        context->sheet()->tempoMap()->invalidate();
+    }
+}
+
+/*!
+	Returns the real time in microseconds from the beginning of the sheet when the given
+	\a scoreTime is reached.
+
+	\sa scoreTime()
+*/
+qint64 CATempoMap::realTime(int scoreTime)
+{
+    QMutexLocker locker(&_mutex);
+    if (!_valid) {
+        rebuild();
+    }
+
+    scoreTime = qMax(scoreTime, 0);
+    const CATempoSegment& s = _segments[segmentAt(scoreTime)];
+    return s.usec + qRound64(usecSpan(s, scoreTime - s.time));
+}
+
+/*!
+	Returns the score time reached at the given \a realTime in microseconds.
+	This is the inverse of realTime() rounded to the nearest time unit.
+*/
+int CATempoMap::scoreTime(qint64 realTime)
+{
+    QMutexLocker locker(&_mutex);
+    if (!_valid) {
+        rebuild();
+    }
+
+    realTime = qMax<qint64>(realTime, 0);
+    int i = std::upper_bound(_segments.begin(), _segments.end(), realTime, [](qint64 t, const CATempoSegment& s) { return t < s.usec; }) - _segments.begin() - 1;
+    const CATempoSegment& s = _segments[qMax(i, 0)];
+
+    const double quarter = CAPlayableLength::playableLengthToTimeLength(CAPlayableLength::Quarter);
+    double r = realTime - s.usec;
+    double x;
+    if (s.rampLength && s.endQpm != s.startQpm) {
+        double k = (s.endQpm - s.startQpm) / s.rampLength; // tempo change per time unit
+        x = s.startQpm * (qExp(r * quarter * k / 60000000.0) - 1) / k;
+    } else {
+        x = r * quarter * s.startQpm / 60000000.0;
+    }
+
+    return s.time + qRound(x);
+}
+
+/*!
+	Returns the tempo at the given \a scoreTime in microseconds per quarter.
+*/
+double CATempoMap::usecPerQuarter(int scoreTime)
+{
+    QMutexLocker locker(&_mutex);
+    if (!_valid) {
+        rebuild();
+    }
+
+    return 60000000.0 / qpmAt(_segments[segmentAt(scoreTime)], scoreTime);
+}
+
+/*!
+	Returns the last tempo mark before or at the given \a scoreTime or Null, if there is none.
+	Ritardandos do not change the returned mark.
+*/
+CATempo* CATempoMap::tempo(int scoreTime)
+{
+    QMutexLocker locker(&_mutex);
+    if (!_valid) {
+        rebuild();
+    }
+
+    return _segments[segmentAt(scoreTime)].tempo;
+}
+
+/*!
+	Returns the score times in the range from \a timeStart to \a timeEnd where the tempo
+	changes. Ramps are sampled every \a step time units. This is used to approximate the
+	ramps with tempo events of the midi files.
+*/
+QVector<int> CATempoMap::changeTimes(int timeStart, int timeEnd, int step)
+{
+    QMutexLocker locker(&_mutex);
+    if (!_valid) {
+        rebuild();
+    }
+
+    QVector<int> times;
+    for (int i = segmentAt(timeStart); i < _segments.size() && _segments[i].time < timeEnd; i++) {
+        const CATempoSegment& s = _segments[i];
+        if (s.time >= timeStart) {
+            times << s.time;
+        }
+        if (s.rampLength && step > 0) {
+            for (int t = s.time + step; t < s.time + s.rampLength && t < timeEnd && (i + 1 == _segments.size() || t < _segments[i + 1].time); t += step) {
+                if (t >= timeStart) {
+                    times << t;
+                }
+            }
+        }
+    }
+
+    return times;
+}
+
+/*!
+	Builds the segments from the tempo and ritardando marks of the sheet.
+	Called with the mutex locked.
+*/
+void CATempoMap::rebuild()
+{
+    _segments.clear();
+    _segments << CATempoSegment { 0, 0, DEFAULT_QUARTERS_PER_MINUTE, DEFAULT_QUARTERS_PER_MINUTE, 0, nullptr };
+    _valid = true;
+
+    QList<CAMark*> marks;
+    if (sheet()) {
+        for (CAVoice* voice : sheet()->voiceList()) {
+            for (CAMusElement* elt : voice->musElementList()) {
+                if (!elt->isPlayable()) {
+                    continue;
+                }
+                for (CAMark* mark : elt->markList()) {
+                    if (mark->markType() == CAMark::Tempo || mark->markType() == CAMark::Ritardando) {
+                        marks << mark;
+                    }
+                }
+            }
+        }
+    }
+
+    // tempo marks are applied before the ritardandos starting at the same time
+    std::stable_sort(marks.begin(), marks.end(), [](CAMark* a, CAMark* b) {
+        return a->timeStart() < b->timeStart() || (a->timeStart() == b->timeStart() && a->markType() == CAMark::Tempo && b->markType() != CAMark::Tempo);
+    });
+
+    const double quarter = CAPlayableLength::playableLengthToTimeLength(CAPlayableLength::Quarter);
+    double beat = 1; // beat of the last tempo mark in quarters
+    CATempo* tempo = nullptr;
+    for (CAMark* mark : marks) {
+        int t = qMax(mark->timeStart(), 0);
+        if (mark->markType() == CAMark::Tempo) {
+            tempo = static_cast<CATempo*>(mark);
+            beat = CAPlayableLength::playableLengthToTimeLength(tempo->beat()) / quarter;
+            addSegment(t, tempoQpm(tempo), tempoQpm(tempo), 0, tempo);
+        } else {
+            CARitardando* rit = static_cast<CARitardando*>(mark);
+            if (rit->timeLength() <= 0 || rit->finalTempo() <= 0) {
+                continue;
+            }
+            finishRamp(t);
+            addSegment(t, qpmAt(_segments.last(), t), rit->finalTempo() * beat, rit->timeLength(), tempo);
+        }
+    }
+    finishRamp(INT_MAX);
+
+    for (int i = 1; i < _segments.size(); i++) {
+        const CATempoSegment& prev = _segments[i - 1];
+        _segments[i].usec = prev.usec + qRound64(usecSpan(prev, _segments[i].time - prev.time));
+    }
+}
+
+/*!
+	Restores the tempo of the last tempo mark, if the ramp of the last segment ends before
+	or at the given score \a time.
+*/
+void CATempoMap::finishRamp(int time)
+{
+    const CATempoSegment last = _segments.last();
+    if (last.rampLength && last.time + last.rampLength <= time) {
+        double qpm = tempoQpm(last.tempo);
+        _segments << CATempoSegment { last.time + last.rampLength, 0, qpm, qpm, 0, last.tempo };
+    }
+}
+
+/*!
+	Appends a new segment starting at the given score \a time. The last segment is replaced,
+	if it starts at the same time.
+*/
+void CATempoMap::addSegment(int time, double startQpm, double endQpm, int rampLength, CATempo* tempo)
+{
+    finishRamp(time);
+
+    CATempoSegment s { time, 0, startQpm, endQpm, rampLength, tempo };
+    if (_segments.last().time == time) {
+        _segments.last() = s;
+    } else {
+        _segments << s;
+    }
+}
+
+/*!
+	Returns the index of the segment containing the given \a scoreTime.
+*/
+int CATempoMap::segmentAt(int scoreTime)
+{
+    int i = std::upper_bound(_segments.begin(), _segments.end(), scoreTime, [](int t, const CATempoSegment& s) { return t < s.time; }) - _segments.begin() - 1;
+    return qMax(i, 0);
+}
+
+/*!
+	Returns the tempo of the given \a tempo mark in quarters per minute or the default
+	tempo, if the mark is Null.
+*/
+double CATempoMap::tempoQpm(CATempo* tempo)
+{
+    if (!tempo) {
+        return DEFAULT_QUARTERS_PER_MINUTE;
+    }
+
+    const double quarter = CAPlayableLength::playableLengthToTimeLength(CAPlayableLength::Quarter);
+    return qMax<int>(tempo->bpm(), 1) * CAPlayableLength::playableLengthToTimeLength(tempo->beat()) / quarter;
+}
+
+/*!
+	Returns the tempo of the segment \a s in quarters per minute at the given \a scoreTime.
+*/
+double CATempoMap::qpmAt(const CATempoSegment& s, int scoreTime)
+{
+    if (!s.rampLength) {
+        return s.startQpm;
+    }
+
+    double x = qBound(0, scoreTime - s.time, s.rampLength);
+    return s.startQpm + (s.endQpm - s.startQpm) * x / s.rampLength;
+}
+
+/*!
+	Returns the real time in microseconds taken by the first \a length time units of the
+	segment \a s. The ramps are integrated exactly.
+*/
+double CATempoMap::usecSpan(const CATempoSegment& s, int length)
+{
+    const double quarter = CAPlayableLength::playableLengthToTimeLength(CAPlayableLength::Quarter);
+    if (s.rampLength && s.endQpm != s.startQpm) {
+        double k = (s.endQpm - s.startQpm) / s.rampLength;
+        return 60000000.0 / quarter * qLn((s.startQpm + k * length) / s.startQpm) / k;
+    }
+
+    return 60000000.0 * length / (quarter * s.startQpm);
+}
@@ -0,0 +1,66 @@
+/*!
+	Copyright (c) 2026, Canorus development team
+	All Rights Reserved. See AUTHORS for a complete list of authors.
+
+	Licensed under the GNU GENERAL PUBLIC LICENSE. See LICENSE.GPL for details.
+*/
+
+#ifndef TEMPOMAP_H_
+#define TEMPOMAP_H_
+
+#include <QMutex>
+#include <QVector>
+
+class CASheet;
+class CAContext;
+class CATempo;
+
+class CATempoMap {
+public:
+    CATempoMap(CASheet* sheet);
+    ~CATempoMap();
+
+    inline CASheet* sheet() { return _sheet; }
+
+    qint64 realTime(int scoreTime);
+    int scoreTime(qint64 realTime);
+    double usecPerQuarter(int scoreTime);
+    CATempo* tempo(int scoreTime);
+
+    QVector<int> changeTimes(int timeStart, int timeEnd, int step);
+
+    bool isValid();
+    void invalidate();
+    static void invalidate(CAContext* context);
+
+    static const double DEFAULT_QUARTERS_PER_MINUTE;
+
+private:
+#ifndef SWIG
+    struct CATempoSegment {
+        int time; // score time of the segment start
+        qint64 usec; // real time of the segment start
+        double startQpm; // tempo in quarters per minute at the start of the segment
+        double endQpm; // tempo at the end of the ramp, equals startQpm for constant tempo
+        int rampLength; // length of the ramp in score time, 0 for constant tempo
+        CATempo* tempo; // the last tempo mark
+    };
+
+    void rebuild();
+    void finishRamp(int time);
+    void addSegment(int time, double startQpm, double endQpm, int rampLength, CATempo* tempo);
+    int segmentAt(int scoreTime);
+
+    static double tempoQpm(CATempo* tempo);
+    static double qpmAt(const CATempoSegment& s, int scoreTime);
+    static double usecSpan(const CATempoSegment& s, int length);
+
+    QVector<CATempoSegment> _segments;
+    QMutex _mutex; // guards the segments rebuilt on the first query
+#endif
+
+    CASheet* _sheet;
+    bool _valid;
+};
+
+#endif /* TEMPOMAP_H_ */
@@ -7,6 +7,7 @@
 
 #include "score/voice.h"
 #include "interface/mididevice.h"
+#include "interface/playbacktimeline.h"
 #include "score/clef.h"
 #include "score/keysignature.h"
 #include "score/lyricscontext.h"
@@ -15,11 +16,15 @@
 #include "score/note.h"
 #include "score/playable.h"
 #include "score/rest.h"
+#include "score/sheet.h"
 #include "score/slur.h"
 #include "score/staff.h"
 #include "score/tempo.h"
+#include "score/tempomap.h"
 #include "score/timesignature.h"
 
+#include <algorithm>
+
 /*!
 	\class CAVoice
 	\brief Class which represents a voice in the staff.
@@ -92,6 +97,33 @@ void CAVoice::cloneVoiceProperties(CAVoice* voice)
     setLyricsContexts(voice->lyricsContextList());
 }
 
+/*!
+	Sets the midi channel of the voice and invalidates the playback timeline of the sheet.
+*/
+void CAVoice::setMidiChannel(const unsigned char ch)
+{
+    _midiChannel = ch;
+    CAPlaybackTimeline::invalidate(this);
+}
+
+/*!
+	Sets the midi program of the voice and invalidates the playback timeline of the sheet.
+*/
+void CAVoice::setMidiProgram(const unsigned char program)
+{
+    _midiProgram = program;
+    CAPlaybackTimeline::invalidate(this);
+}
+
+/*!
+	Sets the midi pitch offset of the voice and invalidates the playback timeline of the sheet.
+*/
+void CAVoice::setMidiPitchOffset(const char midiPitchOffset)
+{
+    _midiPitchOffset = midiPitchOffset;
+    CAPlaybackTimeline::invalidate(this);
+}
+
 /*!
 	Destroys all non-shared music elements held by the voice.
 
@@ -100,6 +132,8 @@ void CAVoice::cloneVoiceProperties(CAVoice* voice)
 */
 void CAVoice::clear()
 {
+    CATempoMap::invalidate(staff());
+    CAPlaybackTimeline::invalidate(this);
     while (_musElementList.size()) {
         // deletes an element only if it's not present in other voices or we're deleting the last voice
         if (_musElementList.front()->isPlayable() || (staff() && staff()->voiceList().size() < 2))
@@ -315,6 +349,8 @@ CAKeySignature* CAVoice::getKeySig(CAMusElement* elt)
 bool CAVoice::remove(CAMusElement* elt, bool updateSigns)
 {
     if (_musElementList.contains(elt)) { // if the search element is found
+        CATempoMap::invalidate(staff());
+        CAPlaybackTimeline::invalidate(elt);
         if (!elt->isPlayable() && staff()) { // element is shared - remove it from all the voices
             for (int i = 0; i < staff()->voiceList().size(); i++) {
                 staff()->voiceList()[i]->_musElementList.removeAll(elt);
@@ -428,6 +464,8 @@ bool CAVoice::insertMusElement(CAMusElement* eltAfter, CAMusElement* elt)
         }
     }
 
+    CATempoMap::invalidate(staff());
+    CAPlaybackTimeline::invalidate(this, elt->timeStart());
     return true;
 }
 
@@ -550,6 +588,17 @@ bool CAVoice::binarySearch_startTime(int time, int& position)
     return false;
 }
 
+/*!
+	Returns the index of the first music element which starts at or after the given \a time.
+	Music elements are sorted by their start time, so a binary search is used.
+*/
+int CAVoice::firstIndexAtTime(int time)
+{
+    return std::lower_bound(_musElementList.begin(), _musElementList.end(), time,
+               [](CAMusElement* elt, int t) { return elt->timeStart() < t; })
+        - _musElementList.begin();
+}
+
 /*!
 	Returns a music element which has the given \a startTime and \a type.
 	This is useful for querying for eg. If a barline exists at the certain
@@ -558,9 +607,7 @@ bool CAVoice::binarySearch_startTime(int time, int& position)
 CAMusElement* CAVoice::getOneEltByType(CAMusElement::CAMusElementType type, int startTime)
 {
 
-    int i;
-    for (i = 0; i < _musElementList.size() && _musElementList[i]->timeStart() < startTime; i++)
-        ; // seek to the start of the music elements with the given time
+    int i = firstIndexAtTime(startTime); // seek to the start of the music elements with the given time
 
     while (i < _musElementList.size() && _musElementList[i]->timeStart() == startTime) { // create a list of music elements with the given time
         if (_musElementList[i]->musElementType() == type)
@@ -581,9 +628,7 @@ QList<CAMusElement*> CAVoice::getEltByType(CAMusElement::CAMusElementType type,
 {
     QList<CAMusElement*> eltList;
 
-    int i;
-    for (i = 0; i < _musElementList.size() && _musElementList[i]->timeStart() < startTime; i++)
-        ; // seek to the start of the music elements with the given time
+    int i = firstIndexAtTime(startTime); // seek to the start of the music elements with the given time
 
     while (i < _musElementList.size() && _musElementList[i]->timeStart() == startTime) { // create a list of music elements with the given time
         if (_musElementList[i]->musElementType() == type)
@@ -811,7 +856,7 @@ CAMusElement* CAVoice::previous(CAMusElement* elt)
     if (musElementList().isEmpty())
         return nullptr;
     if (elt) {
-        int idx = _musElementList.indexOf(elt);
+        int idx = _musElementList.lastIndexOf(elt); // elements are usually looked up at the end of the voice
 
         if (--idx < 0) //if the element wasn't found or was the first element
             return nullptr;
@@ -939,6 +984,10 @@ CAPlayable* CAVoice::previousPlayable(int timeStart)
 */
 bool CAVoice::updateTimes(int idx, int length, bool signsToo)
 {
+    CATempoMap::invalidate(staff());
+    if (idx < musElementList().size()) {
+        CAPlaybackTimeline::invalidate(this, qMin(musElementList()[idx]->timeStart(), musElementList()[idx]->timeStart() + length));
+    }
     for (int i = idx; i < musElementList().size(); i++)
         if (signsToo || musElementList()[i]->isPlayable()) {
             musElementList()[i]->setTimeStart(musElementList()[i]->timeStart() + length);
@@ -1030,9 +1079,17 @@ bool CAVoice::containsPitch(CADiatonicPitch p, int timeStart)
 
 /*!
 	Returns the Tempo element active at the given time.
+	Tempo marks apply to the whole sheet, so the tempo is looked up in the tempo map of the
+	sheet. Only the marks of this voice are searched, if the voice isn't part of a sheet.
+
+	\sa CASheet::tempoMap()
  */
 CATempo* CAVoice::getTempo(int time)
 {
+    if (staff() && staff()->sheet()) {
+        return staff()->sheet()->tempoMap()->tempo(time);
+    }
+
     QList<CAPlayable*> chord = getChord(time);
     int curElt = -1;
 
@@ -102,13 +102,13 @@ public:
     inline void setName(const QString name) { _name = name; }
 
     inline unsigned char midiChannel() { return _midiChannel; }
-    inline void setMidiChannel(const unsigned char ch) { _midiChannel = ch; }
+    void setMidiChannel(const unsigned char ch);
 
     inline unsigned char midiProgram() { return _midiProgram; }
-    inline void setMidiProgram(const unsigned char program) { _midiProgram = program; }
+    void setMidiProgram(const unsigned char program);
 
     inline char midiPitchOffset() { return _midiPitchOffset; }
-    inline void setMidiPitchOffset(const char midiPitchOffset) { _midiPitchOffset = midiPitchOffset; }
+    void setMidiPitchOffset(const char midiPitchOffset);
 
     inline const QList<CALyricsContext*>& lyricsContextList() { return _lyricsContextList; }
     inline void addLyricsContext(CALyricsContext* lc) { _lyricsContextList << lc; }
@@ -120,6 +120,7 @@ private:
     bool addNoteToChord(CANote* note, CANote* referenceNote);
     bool insertMusElement(CAMusElement* before, CAMusElement* elt);
     bool updateTimes(int idx, int length, bool signsToo = false);
+    int firstIndexAtTime(int time);
 
     // list of all the music elements
     QList<CAMusElement*> _musElementList;
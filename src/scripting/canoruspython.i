@@ -269,10 +269,33 @@ void acquireGIL();
 void releaseGIL();
 void setSelection( QList<CAMusElement*> elements, bool centerOn=false );
 
+// the following functions work in the background plugin actions, see CAPluginJob:
+void setProgress( int percent );
+bool isCanceled();
+
 %include "scripting/canoruslibrary.i"
 
+// columns of the music elements without wrapping every element, see CAScoreTable; None raises ValueError
+PyObject* scoreTableData( CAVoice* voice );
+PyObject* scoreTableData( CASheet* sheet );
+
+%pythoncode %{
+# column names in the order of CAScoreTable::CAColumn
+SCORE_TABLE_COLUMNS = ('timeStart', 'timeLength', 'musElementType', 'midiPitch', 'accs', 'voice')
+
+def scoreTable(source):
+    """Returns a dict of read-only int32 memoryviews with the columns of the music elements
+    of the given voice or sheet, see SCORE_TABLE_COLUMNS. The views share a single buffer,
+    numpy.asarray(view) doesn't copy it."""
+    data, rows = scoreTableData(source)
+    view = memoryview(data)
+    size = rows * 4
+    return dict((name, view[i * size:(i + 1) * size].cast('i')) for i, name in enumerate(SCORE_TABLE_COLUMNS))
+%}
+
 %{	// toPythonObject() function
 #include "scripting/swigpython.h"	//needed for CAClassType
+#include "core/scoretable.h"
 
 #include <QList>
 QList<void*> markedObjects = QList<void*>(); // define markedObjects
@@ -283,6 +306,7 @@ void markDelete( PyObject* object ) {
 
 #ifndef SWIGCPP
 #include "canorus.h"
+#include "interface/pluginjob.h"
 #endif
 
 /*!
@@ -292,7 +316,24 @@ void guiError() {
     std::cerr << "CanorusPython: No Canorus GUI found." << std::endl;
 }
 
+/*!
+	Reports error and returns True, if a function which needs the GUI thread is called
+	from a background plugin action.
+*/
+bool backgroundError() {
+#ifndef SWIGCPP
+    if (CAPluginJob::currentJob()) {
+        std::cerr << "CanorusPython: Not available in the background plugin actions." << std::endl;
+        return true;
+    }
+#endif
+    return false;
+}
+
 void rebuildUi() {
+    if (backgroundError()) {
+        return;
+    }
 #ifndef SWIGCPP
     CACanorus::rebuildUI();
 #else
@@ -301,6 +342,9 @@ void rebuildUi() {
 }
 
 void repaintUi() {
+    if (backgroundError()) {
+        return;
+    }
 #ifndef SWIGCPP
     CACanorus::repaintUI();
 #else
@@ -320,6 +364,9 @@ bool hasGui() {
     Workaround for acquiring GIL while inside Canorus plugin, if signal-slot operations are required.
 */
 void acquireGIL() {
+    if (backgroundError()) {
+        return;
+    }
     PyEval_RestoreThread(CASwigPython::mainThreadState);
 }
 
@@ -327,6 +374,9 @@ void acquireGIL() {
     Workaround for releasing GIL while inside Canorus plugin, if signal-slot operations are required.
 */
 void releaseGIL() {
+    if (backgroundError()) {
+        return;
+    }
     PyEval_ReleaseThread(CASwigPython::mainThreadState);
 }
 
@@ -335,6 +385,9 @@ void releaseGIL() {
     the view to center them.
 */
 void setSelection( QList<CAMusElement*> elements, bool centerOn ) {
+    if (backgroundError()) {
+        return;
+    }
 #ifndef SWIGCPP
     if (!elements.size() || !elements[0]->context() || !elements[0]->context()->sheet() || !elements[0]->context()->sheet()->document()) {
         return;
@@ -367,6 +420,60 @@ void setSelection( QList<CAMusElement*> elements, bool centerOn ) {
 #endif
 }
 
+/*!
+    Reports the progress of the background plugin action in percent.
+*/
+void setProgress( int percent ) {
+#ifndef SWIGCPP
+    if (CAPluginJob::currentJob()) {
+        CAPluginJob::currentJob()->reportProgress(percent);
+    }
+#endif
+}
+
+/*!
+    Returns True, if the user canceled the background plugin action.
+*/
+bool isCanceled() {
+#ifndef SWIGCPP
+    return CAPluginJob::currentJob() && CAPluginJob::currentJob()->isCanceled();
+#else
+    return false;
+#endif
+}
+
+/*!
+    Writes the CAScoreTable \a table into a new Python bytes object.
+    Returns a tuple of the bytes and the number of rows.
+*/
+static PyObject* scoreTableData( CAScoreTable& table ) {
+    PyObject *data = PyBytes_FromStringAndSize(nullptr, CAScoreTable::ColumnCount * table.rowCount() * sizeof(qint32));
+    if (!data) {
+        return nullptr;
+    }
+    table.write(reinterpret_cast<qint32*>(PyBytes_AS_STRING(data)));
+
+    return Py_BuildValue("(Ni)", data, table.rowCount());
+}
+
+PyObject* scoreTableData( CAVoice* voice ) {
+    if (!voice) {
+        PyErr_SetString(PyExc_ValueError, "scoreTableData(): the voice is None");
+        return nullptr;
+    }
+    CAScoreTable table(voice);
+    return scoreTableData(table);
+}
+
+PyObject* scoreTableData( CASheet* sheet ) {
+    if (!sheet) {
+        PyErr_SetString(PyExc_ValueError, "scoreTableData(): the sheet is None");
+        return nullptr;
+    }
+    CAScoreTable table(sheet);
+    return scoreTableData(table);
+}
+
 const char* tr( const char * sourceText, const char * comment = 0, int n = -1 ) {
     return QObject::tr( sourceText, comment, n ).toUtf8().constData();
 }
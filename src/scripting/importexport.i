@@ -26,6 +26,7 @@
 #include "export/midiexport.h"
 #include "export/pdfexport.h"
 #include "export/svgexport.h"
+#include "export/wavexport.h"
 %}
 
 %include "core/settings.h"
@@ -48,3 +49,4 @@
 %include "export/midiexport.h"
 %include "export/pdfexport.h"
 %include "export/svgexport.h"
+%include "export/wavexport.h"
@@ -7,8 +7,10 @@
 
 %{
 #include "interface/playback.h"
+#include "interface/playbacktimeline.h"
 #include "core/midirecorder.h"
 %}
 
 %include "interface/playback.h"
+%include "interface/playbacktimeline.h"
 %include "core/midirecorder.h"
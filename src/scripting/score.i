@@ -8,6 +8,7 @@
 %{
 #include "score/document.h"
 #include "score/sheet.h"
+#include "score/tempomap.h"
 
 #include "score/context.h"
 #include "score/staff.h"
@@ -40,8 +41,30 @@
 #include "score/chordname.h"
 %}
 
+#ifdef SWIGPYTHON
+%pythoncode %{
+import contextlib
+%}
+
+// Python context manager for the batch of changes, see CADocument::beginBatch():
+//   with document.batch():
+//       voice.append(...)
+%extend CADocument {
+%pythoncode %{
+    @contextlib.contextmanager
+    def batch(self):
+        self.beginBatch()
+        try:
+            yield self
+        finally:
+            self.endBatch()
+%}
+}
+#endif
+
 %include "score/document.h"
 %include "score/sheet.h"
+%include "score/tempomap.h"
 
 %include "score/context.h"
 %include "score/staff.h"
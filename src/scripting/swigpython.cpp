@@ -7,16 +7,13 @@
 
 #ifdef USE_PYTHON
 #include "scripting/swigpython.h"
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QThread>
 
-#ifndef SWIGCPP
-#include "canorus.h"
-#endif
-
 #include <iostream> // used for reporting errors in scripts
 using namespace std;
 //#include <pthread.h>
@@ -28,9 +25,12 @@ protected:
 
 PyThreadState* CASwigPython::mainThreadState;
 PyThreadState* CASwigPython::pycliThreadState;
+QHash<QString, CASwigPython::CAPythonModule> CASwigPython::_modules;
 
+#ifndef CANORUS_NO_SWIG_WRAPPER
 /// Load 'CanorusPython' module and initialize classes - defined in SWIG wrapper class
-extern "C" void PyInit__CanorusPython();
+extern "C" PyObject* PyInit__CanorusPython();
+#endif
 
 /*!
 	Initializes Python and loads base 'CanorusPython' module. Call this before any other
@@ -43,7 +43,9 @@ void CASwigPython::init()
     Py_Initialize();
     PyEval_InitThreads(); // our python will use GIL
 
+#ifndef CANORUS_NO_SWIG_WRAPPER
     PyInit__CanorusPython();
+#endif
     PyRun_SimpleString("import sys");
 
     // add path to scripts to Scripting path
@@ -94,10 +96,18 @@ void CASwigPython::init()
 /*!
 	Calls an external Python function in the given module with the list of arguments and return the Python object the function returned.
 
+	The modules and the function objects are cached by the file name, so the module's top level
+	code is executed only once and calling the plugin action per note is cheap. If \a autoReload
+	is True, the module is reloaded when the file was modified since it was loaded.
+
+	The references of \a args are stolen. The returned object is a new reference owned by the
+	caller, release it with Py_DECREF() while holding the GIL. Returns Null, if the module or the
+	function couldn't be loaded or the function raised an exception.
+
 	\param fileName Absolute path to the filename of the script
 	\param function Function or method name.
 	\param args List of arguments in Python's PyObject pointer format. Use toPythonObject() to convert C++ classes to Python objects.
-	\param autoReload automatically reload module if it was imported before, defaults to false
+	\param autoReload reload the module, if the file was modified, defaults to false
 
 	\warning You have to add path of the plugin to Python path before, manually! This is usually done by CAPlugin::callAction("onInit").
 */
@@ -110,11 +120,20 @@ QList<PyObject*> thr_args;
 
 PyObject* CASwigPython::callFunction(QString fileName, QString function, QList<PyObject*> args, bool autoReload)
 {
-    if (!QFile::exists(fileName))
+    if (!QFile::exists(fileName)) {
+        PyEval_RestoreThread(mainThreadState);
+        for (PyObject* arg : args)
+            Py_XDECREF(arg); // the references are stolen also on failure
+        PyEval_ReleaseThread(mainThreadState);
         return nullptr;
+    }
 
     // run pycli in pthread, this is temporary solution
     if (fileName.contains("pycli") && (!function.contains("init"))) {
+        PyEval_RestoreThread(mainThreadState);
+        Py_INCREF(args.first()); // returned to the caller, the console thread keeps the original reference
+        PyEval_ReleaseThread(mainThreadState);
+
         //tid = new pthread_t;
         qtid = new CAPyconsoleThread();
         thr_fileName = fileName;
@@ -126,67 +145,96 @@ PyObject* CASwigPython::callFunction(QString fileName, QString function, QList<P
         return args.first();
     }
 
-    PyObject* pyArgs = PyTuple_New(args.size());
-    if (!pyArgs)
+    PyEval_RestoreThread(mainThreadState);
+    PyObject* ret = callFunctionLocked(fileName, function, args, autoReload);
+    PyEval_ReleaseThread(mainThreadState);
+    return ret;
+}
+
+/*!
+	Same as callFunction(), but the calling thread must already hold the GIL. Used by the
+	threads with their own Python thread state, see CAPluginJob.
+*/
+PyObject* CASwigPython::callFunctionLocked(QString fileName, QString function, QList<PyObject*> args, bool autoReload)
+{
+    if (!QFile::exists(fileName)) {
+        for (PyObject* arg : args)
+            Py_XDECREF(arg);
         return nullptr;
+    }
+
+    PyObject* pyArgs = PyTuple_New(args.size());
     for (int i = 0; i < args.size(); i++)
-        PyTuple_SetItem(pyArgs, i, args[i]);
+        PyTuple_SET_ITEM(pyArgs, i, args[i]); // steals the reference
 
-    // Load module, if not yet
-    QString moduleName = fileName.left(fileName.lastIndexOf(".py"));
-    moduleName = moduleName.remove(0, moduleName.lastIndexOf("/") + 1);
+    PyObject* ret = nullptr;
+    PyObject* pyFunction = loadFunction(fileName, function, autoReload); // borrowed ref. from the cache
+    if (pyFunction)
+        ret = PyObject_CallObject(pyFunction, pyArgs);
+    if (!ret && PyErr_Occurred())
+        PyErr_Print();
 
-    PyEval_RestoreThread(CASwigPython::mainThreadState);
+    Py_DECREF(pyArgs);
+    return ret;
+}
 
-    PyObject* pyModule;
-    if (autoReload) {
-        PyObject* moduleDict = PyImport_GetModuleDict(); // borrowed ref.
-        PyObject* ourModuleName = PyBytes_FromString(static_cast<const char*>(moduleName.toStdString().c_str())); // new ref.
-        pyModule = PyDict_GetItem(moduleDict, ourModuleName); // borrowed ref.
-        //		Py_DECREF(ourModuleName); // -Matevz
+/*!
+	Releases the reference of the \a object returned by callFunction().
+	Acquires the GIL, so it is called from the C++ code without it.
+*/
+void CASwigPython::releaseObject(PyObject* object)
+{
+    if (!object)
+        return;
 
-        if (pyModule == nullptr) // not imported yet
-            pyModule = PyImport_ImportModule(static_cast<const char*>(moduleName.toStdString().c_str()));
-        else
-            Py_XDECREF(PyImport_ReloadModule(pyModule)); // we don't need the reference returned from ReloadModule
-    } else {
-        pyModule = PyImport_ImportModule(static_cast<const char*>(moduleName.toStdString().c_str()));
-    }
-    if (PyErr_Occurred()) {
-        PyErr_Print();
-        PyEval_ReleaseThread(mainThreadState);
-        return nullptr;
-    }
+    PyEval_RestoreThread(mainThreadState);
+    Py_DECREF(object);
+    PyEval_ReleaseThread(mainThreadState);
+}
 
-    // Get function object
-    PyObject* pyFunction = PyObject_GetAttrString(pyModule, static_cast<const char*>(function.toStdString().c_str()));
-    if (PyErr_Occurred()) {
-        PyErr_Print();
-        PyEval_ReleaseThread(mainThreadState);
-        return nullptr;
-    }
+/*!
+	Returns the \a function object of the module in the file \a fileName.
+	The module is imported the first time and reloaded, if \a autoReload is True and the
+	file was modified since then.
 
-    // Call the actual function
-    PyObject* ret;
-    if (args.size())
-        ret = PyEval_CallObject(pyFunction, pyArgs);
-    else
-        ret = PyEval_CallObject(pyFunction, nullptr);
-    if (PyErr_Occurred()) {
-        PyErr_Print();
-        PyEval_ReleaseThread(mainThreadState);
-        return nullptr;
+	Returns a borrowed reference owned by the module cache or Null with the Python exception
+	set. The GIL must be held, it also guards the cache.
+*/
+PyObject* CASwigPython::loadFunction(const QString& fileName, const QString& function, bool autoReload)
+{
+    QDateTime lastModified = QFileInfo(fileName).lastModified();
+
+    QHash<QString, CAPythonModule>::iterator it = _modules.find(fileName);
+    if (it == _modules.end()) {
+        PyObject* pyModule = PyImport_ImportModule(QFileInfo(fileName).completeBaseName().toUtf8().constData()); // new ref.
+        if (!pyModule)
+            return nullptr;
+
+        CAPythonModule module;
+        module.module = pyModule;
+        module.lastModified = lastModified;
+        it = _modules.insert(fileName, module);
+    } else if (autoReload && it->lastModified != lastModified) {
+        PyObject* pyModule = PyImport_ReloadModule(it->module); // new ref.
+        if (!pyModule)
+            return nullptr;
+
+        for (PyObject* pyFunction : it->functions)
+            Py_DECREF(pyFunction);
+        it->functions.clear();
+        Py_DECREF(it->module);
+        it->module = pyModule;
+        it->lastModified = lastModified;
     }
 
-    //	Py_DECREF(pyFunction); // -Matevz
-    //	Py_DECREF(pyModule); // -Matevz
-    /// \todo Crashes if uncommented?!
-    //	Py_DECREF(pyArgs);
-    //	for (int i=0; i<args.size(); i++)
-    //		Py_DECREF(args[i]); // -Matevz
+    PyObject* pyFunction = it->functions.value(function, nullptr);
+    if (!pyFunction) {
+        pyFunction = PyObject_GetAttrString(it->module, function.toUtf8().constData()); // new ref. kept by the cache
+        if (pyFunction)
+            it->functions.insert(function, pyFunction);
+    }
 
-    PyEval_ReleaseThread(mainThreadState);
-    return ret;
+    return pyFunction;
 }
 
 /*!
@@ -206,58 +254,53 @@ void* CASwigPython::callPycli(void*)
     QString fileName = thr_fileName;
     QString function = thr_function;
     QList<PyObject*> args = thr_args;
-
-    if (!QFile::exists(fileName)) {
-        //		pthread_exit((void*)nullptr);
+    QString moduleName;
+    PyObject* pyArgs = nullptr;
+    PyObject* pyModule = nullptr;
+    PyObject* pyFunction = nullptr;
+    PyObject* ret = nullptr;
+
+    if (!QFile::exists(fileName) || args.size() < 2) {
+        goto cleanup;
     }
 
-    PyObject* pyArgs = Py_BuildValue("(OO)", args[0], args[1]);
+    pyArgs = Py_BuildValue("(OO)", args[0], args[1]);
 
     // Load module, if not yet
-    QString moduleName = fileName.left(fileName.lastIndexOf(".py"));
+    moduleName = fileName.left(fileName.lastIndexOf(".py"));
     moduleName = moduleName.remove(0, moduleName.lastIndexOf("/") + 1);
 
-    PyObject* pyModule = PyImport_ImportModule(static_cast<const char*>(moduleName.toStdString().c_str()));
-
-    if (PyErr_Occurred()) {
-        PyErr_Print();
-        PyEval_ReleaseThread(mainThreadState);
-        return nullptr;
+    pyModule = PyImport_ImportModule(moduleName.toStdString().c_str());
+    if (!pyModule) {
+        goto cleanup;
     }
 
     // Get function object
-
-    //PyObject *pyFunction = PyObject_GetAttrString(pyModule, "pycli");
-    PyObject* pyFunction = PyObject_GetAttrString(pyModule, static_cast<const char*>(function.toStdString().c_str()));
-
-    if (PyErr_Occurred()) {
-        PyErr_Print();
-        PyEval_ReleaseThread(mainThreadState);
-        return nullptr;
+    pyFunction = PyObject_GetAttrString(pyModule, function.toStdString().c_str());
+    if (!pyFunction) {
+        goto cleanup;
     }
 
     // Call the actual function
-    //
-    PyObject* ret;
-    ret = PyEval_CallObject(pyFunction, pyArgs);
+    ret = PyObject_CallObject(pyFunction, pyArgs);
+
+cleanup:
     if (PyErr_Occurred()) {
         PyErr_Print();
-        PyEval_ReleaseThread(mainThreadState);
-        return nullptr;
     }
 
-    //	Py_DECREF(pyFunction); // -Matevz
-    /// \todo Crashes if uncommented?!
-    //	Py_DECREF(pyArgs);
-    //	Py_DECREF(pyModule); // -Matevz
-    //	for (int i=0; i<args.size(); i++)
-    //		Py_DECREF(args[i]); // -Matevz
+    Py_XDECREF(ret);
+    Py_XDECREF(pyFunction);
+    Py_XDECREF(pyArgs);
+    Py_XDECREF(pyModule);
+    for (int i = 0; i < args.size(); i++)
+        Py_XDECREF(args[i]); // references passed to callFunction()
 
     PyThreadState_Swap(mainThreadState);
     PyEval_ReleaseThread(mainThreadState);
 
     //	pthread_exit((void*)nullptr);
-    return ret;
+    return nullptr;
 }
 
 /*!
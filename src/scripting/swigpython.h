@@ -11,6 +11,8 @@
 
 #include <Python.h>
 
+#include <QDateTime>
+#include <QHash>
 #include <QList>
 #include <QString>
 
@@ -38,10 +40,23 @@ public:
 
     static void init();
     static PyObject* callFunction(QString fileName, QString function, QList<PyObject*> args, bool autoReload = false);
+    static PyObject* callFunctionLocked(QString fileName, QString function, QList<PyObject*> args, bool autoReload = false);
+    static void releaseObject(PyObject* object);
     static void* callPycli(void*);
     static PyObject* toPythonObject(void* object, CAClassType type); // defined in scripting/canoruspython.i
 
     static PyThreadState *mainThreadState, *pycliThreadState;
+
+private:
+    struct CAPythonModule {
+        PyObject* module;
+        QDateTime lastModified; // modification time of the file when the module was loaded
+        QHash<QString, PyObject*> functions; // function name -> function object
+    };
+
+    static PyObject* loadFunction(const QString& fileName, const QString& function, bool autoReload);
+
+    static QHash<QString, CAPythonModule> _modules; // file name -> loaded module, guarded by the GIL
 };
 
 #endif /*SWIGPYTHON_H_*/
@@ -46,6 +46,7 @@
 #include "interface/keybdinput.h"
 #include "interface/mididevice.h"
 #include "interface/playback.h"
+#include "interface/pluginjob.h"
 #include "interface/pluginmanager.h"
 #include "interface/rtmididevice.h"
 
@@ -101,6 +102,7 @@
 #include "score/slur.h"
 #include "score/staff.h"
 #include "score/syllable.h"
+#include "score/tempomap.h"
 #include "score/text.h"
 #include "score/timesignature.h"
 #include "score/voice.h"
@@ -117,6 +119,7 @@
 #include "export/musicxmlexport.h"
 #include "export/pdfexport.h"
 #include "export/svgexport.h"
+#include "export/wavexport.h"
 #include "import/canimport.h"
 #include "import/canorusmlimport.h"
 #include "import/lilypondimport.h"
@@ -171,8 +174,8 @@ CAMainWin::CAMainWin(QMainWindow* oParent)
     // Create plugins menus and toolbars in this main window
     CAPluginManager::enablePlugins(this);
 
-    // Connects MIDI IN callback function to a local slot. Not implemented yet.
-    connect(CACanorus::midiDevice(), SIGNAL(midiInEvent(QVector<unsigned char>)), this, SLOT(onMidiInEvent(QVector<unsigned char>)));
+    // Connects MIDI IN messages to a local slot. Direct connection, the device emits them in the GUI thread.
+    connect(CACanorus::midiDevice(), SIGNAL(midiInMessage(const CAMidiMessage&)), this, SLOT(onMidiInMessage(const CAMidiMessage&)), Qt::DirectConnection);
 
     // Connect QTimer so it increases the local document edited time every second
     restartTimeEditedTime();
@@ -203,6 +206,16 @@ CAMainWin::CAMainWin(QMainWindow* oParent)
 
 CAMainWin::~CAMainWin()
 {
+    if (isPluginJobRunning()) {
+        _pluginJob->cancel();
+        _pluginJob->wait();
+    }
+
+    clearImportPreview(); // the previewed sheets are owned by the import
+    if (_importFile) {
+        _importFile->wait();
+    }
+
     delete _musElementFactory;
 
     if (document() && CACanorus::mainWinCount(document()) == 1) {
@@ -888,32 +901,37 @@ void CAMainWin::newDocument()
     CACanorus::undo()->createUndoStack(document());
     restartTimeEditedTime();
 
+    bool created = false; // by the newdocument.py script
 #ifdef USE_PYTHON
-    QList<PyObject*> argsPython;
-    PyEval_RestoreThread(CASwigPython::mainThreadState);
-    argsPython << CASwigPython::toPythonObject(document(), CASwigPython::Document);
-    PyEval_ReleaseThread(CASwigPython::mainThreadState);
-    CASwigPython::callFunction(QFileInfo("scripts:newdocument.py").absoluteFilePath(), "newDefaultDocument", argsPython);
-#else
-    // fallback: add basic sheet with two staffs
-    CASheet* sheet1 = document()->addSheet();
-    CAStaff* staff1 = sheet1->addStaff();
-    staff1->addVoice();
-    staff1->voiceList()[0]->setStemDirection(CANote::StemUp);
-    staff1->voiceList()[1]->setStemDirection(CANote::StemDown);
-    staff1->voiceList()[0]->append(new CAClef(CAClef::Treble, staff1, 0));
-    staff1->voiceList()[0]->append(new CATimeSignature(4, 4, staff1, 0));
-
-    CAStaff* staff2 = sheet1->addStaff();
-    staff2->addVoice();
-    staff2->voiceList()[0]->setStemDirection(CANote::StemUp);
-    staff2->voiceList()[1]->setStemDirection(CANote::StemDown);
-    staff2->voiceList()[0]->append(new CAClef(CAClef::Bass, staff2, 0));
-    staff2->voiceList()[0]->append(new CATimeSignature(4, 4, staff2, 0));
-
-    staff1->synchronizeVoices();
-    staff2->synchronizeVoices();
+    if (CACanorus::isScriptingInitialized()) {
+        QList<PyObject*> argsPython;
+        PyEval_RestoreThread(CASwigPython::mainThreadState);
+        argsPython << CASwigPython::toPythonObject(document(), CASwigPython::Document);
+        PyEval_ReleaseThread(CASwigPython::mainThreadState);
+        CASwigPython::releaseObject(CASwigPython::callFunction(QFileInfo("scripts:newdocument.py").absoluteFilePath(), "newDefaultDocument", argsPython));
+        created = true;
+    }
 #endif
+    if (!created) {
+        // fallback, also used before the scripting is initialized at startup: add basic sheet with two staffs
+        CASheet* sheet1 = document()->addSheet();
+        CAStaff* staff1 = sheet1->addStaff();
+        staff1->addVoice();
+        staff1->voiceList()[0]->setStemDirection(CANote::StemUp);
+        staff1->voiceList()[1]->setStemDirection(CANote::StemDown);
+        staff1->voiceList()[0]->append(new CAClef(CAClef::Treble, staff1, 0));
+        staff1->voiceList()[0]->append(new CATimeSignature(4, 4, staff1, 0));
+
+        CAStaff* staff2 = sheet1->addStaff();
+        staff2->addVoice();
+        staff2->voiceList()[0]->setStemDirection(CANote::StemUp);
+        staff2->voiceList()[1]->setStemDirection(CANote::StemDown);
+        staff2->voiceList()[0]->append(new CAClef(CAClef::Bass, staff2, 0));
+        staff2->voiceList()[0]->append(new CATimeSignature(4, 4, staff2, 0));
+
+        staff1->synchronizeVoices();
+        staff2->synchronizeVoices();
+    }
 
     // call local rebuild only because no other main windows share the new document
     rebuildUI();
@@ -935,6 +953,7 @@ void CAMainWin::newDocument()
  */
 bool CAMainWin::handleUnsavedChanges()
 {
+    CACanorus::undo()->finishPendingUndoCommand(); // eg. the midi step input phrase marks the document modified
     if (document()) {
         if (document()->isModified()) {
             QMessageBox::StandardButton ret = QMessageBox::question(this, tr("Unsaved changes"), tr("Document \"%1\" was modified. Do you want to save the changes?").arg(document()->title().isEmpty() ? tr("Untitled") : document()->title()), QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel, QMessageBox::Yes);
@@ -989,12 +1008,13 @@ void CAMainWin::clearUI()
 {
     setCurrentView(nullptr);
 
-    // Delete all view port containers and view ports.
+    // Delete all view port containers and view ports including the import previews.
     while (uiTabWidget->count()) {
-        CAViewContainer* vpc = static_cast<CAViewContainer*>(uiTabWidget->currentWidget());
+        QWidget* w = uiTabWidget->currentWidget();
         uiTabWidget->removeTab(uiTabWidget->currentIndex());
-        delete vpc;
+        delete w;
     }
+    _importPreviewViews.clear();
 
     //delete floating Views
     while (!_viewList.isEmpty())
@@ -1015,9 +1035,11 @@ void CAMainWin::clearUI()
 */
 void CAMainWin::on_uiTabWidget_currentChanged(int)
 {
-    setCurrentViewContainer(static_cast<CAViewContainer*>(uiTabWidget->currentWidget()));
+    setCurrentViewContainer(qobject_cast<CAViewContainer*>(uiTabWidget->currentWidget())); // null for import previews
     if (currentViewContainer())
         setCurrentView(currentViewContainer()->currentView());
+    else
+        setCurrentView(nullptr);
 
     updateToolBars();
 }
@@ -1039,7 +1061,9 @@ void CAMainWin::on_uiTabWidget_CANewTab()
 */
 void CAMainWin::on_uiTabWidget_CAMoveTab(int from, int to)
 {
-    if (document() && document()->sheetList().count() >= 2) {
+    if (document() && (from >= document()->sheetList().count() || to >= document()->sheetList().count())) {
+        CACanorus::rebuildUI(document()); // import previews stay behind the document sheets
+    } else if (document() && document()->sheetList().count() >= 2) {
         CACanorus::undo()->createUndoCommand(document(), tr("change sheet order", "undo"));
 
         CASheet* s = document()->sheetList()[from];
@@ -1333,6 +1357,7 @@ void CAMainWin::on_uiNewDocument_triggered()
 void CAMainWin::on_uiUndo_toggled(bool, int row)
 {
     stopPlayback();
+    _keybdInput->finishPhrase();
     if (document()) {
         int curVoiceIdx = -1;
         if (currentVoice() && currentVoice()->staff() && currentVoice()->staff()->sheet()) {
@@ -1359,6 +1384,7 @@ void CAMainWin::on_uiUndo_toggled(bool, int row)
 void CAMainWin::on_uiRedo_toggled(bool, int row)
 {
     stopPlayback();
+    _keybdInput->finishPhrase();
     if (document()) {
         int curVoiceIdx = -1;
         if (currentVoice() && currentVoice()->staff() && currentVoice()->staff()->sheet()) {
@@ -1581,8 +1607,18 @@ void CAMainWin::setMode(CAMode mode)
 
         break;
     }
+    case ProgressMode: {
+        // the file is being read in the background, the progress is shown in the status bar
+        for (int i = 0; i < _viewList.size(); i++) {
+            if (_viewList[i]->viewType() == CAView::ScoreView) {
+                static_cast<CAScoreView*>(_viewList[i])->setShadowNoteVisible(false);
+                _viewList[i]->repaint();
+            }
+        }
+
+        break;
+    }
     case ReadOnlyMode:
-    case ProgressMode:
     case NoDocumentMode:
         fprintf(stderr, "Warning: CAMainWin::setMode - Unhandled mode %d\n", mode);
         break;
@@ -1640,7 +1676,7 @@ void CAMainWin::rebuildUI(CASheet* sheet, bool repaint)
         }
 
         // update tab name
-        for (int i = 0; i < uiTabWidget->count(); i++) {
+        for (int i = 0; i < uiTabWidget->count() && i < document()->sheetList().size(); i++) {
             uiTabWidget->setTabText(i, document()->sheetList()[i]->name());
         }
     } else {
@@ -1705,10 +1741,17 @@ void CAMainWin::rebuildUI(bool repaint)
                 _viewList[i]->repaint();
         }
 
+        for (CASheet* s : _importPreviewSheets) {
+            addImportPreview(s);
+        }
+
         if (curIndex < uiTabWidget->count())
             uiTabWidget->setCurrentIndex(curIndex);
     } else {
         clearUI();
+        for (CASheet* s : _importPreviewSheets) {
+            addImportPreview(s);
+        }
     }
 
     if (_resourceView) {
@@ -1912,8 +1955,9 @@ void CAMainWin::scoreViewMousePress(QMouseEvent* e, const QPoint coords)
 
         break;
     }
-    case ReadOnlyMode:
     case ProgressMode:
+        break; // only the selection changes until the file is read
+    case ReadOnlyMode:
     case NoDocumentMode:
         fprintf(stderr, "Warning: CAMainWin::scoreViewMousePress - Unhandled mode %d\n", mode());
         break;
@@ -2339,8 +2383,11 @@ void CAMainWin::scoreViewKeyPress(QKeyEvent* e)
                             sheet = static_cast<CANote*>(elt)->voice()->staff()->sheet();
                             CACanorus::undo()->createUndoCommand(document(), tr("add sharp", "undo"));
                         }
-                        if (static_cast<CANote*>(elt)->diatonicPitch().accs() < 2) // limit the amount of accidentals
-                            static_cast<CANote*>(elt)->diatonicPitch().setAccs(static_cast<CANote*>(elt)->diatonicPitch().accs() + 1);
+                        CADiatonicPitch pitch = static_cast<CANote*>(elt)->diatonicPitch();
+                        if (pitch.accs() < 2) { // limit the amount of accidentals
+                            pitch.setAccs(pitch.accs() + 1);
+                            static_cast<CANote*>(elt)->setDiatonicPitch(pitch);
+                        }
                     }
                     eltList << elt;
                 }
@@ -2374,8 +2421,11 @@ void CAMainWin::scoreViewKeyPress(QKeyEvent* e)
                             sheet = static_cast<CANote*>(elt)->voice()->staff()->sheet();
                             CACanorus::undo()->createUndoCommand(document(), tr("add flat", "undo"));
                         }
-                        if (static_cast<CANote*>(elt)->diatonicPitch().accs() > -2) // limit the amount of accidentals
-                            static_cast<CANote*>(elt)->diatonicPitch().setAccs(static_cast<CANote*>(elt)->diatonicPitch().accs() - 1);
+                        CADiatonicPitch pitch = static_cast<CANote*>(elt)->diatonicPitch();
+                        if (pitch.accs() > -2) { // limit the amount of accidentals
+                            pitch.setAccs(pitch.accs() - 1);
+                            static_cast<CANote*>(elt)->setDiatonicPitch(pitch);
+                        }
                     }
                     eltList << elt;
                 }
@@ -3068,23 +3118,36 @@ void CAMainWin::on_uiPlayFromSelection_toggled(bool checked)
 /*!
 	Called every few miliseconds during playback to repaint score View as the GUI can
 	only be repainted from the main thread.
+
+	The drawable elements of the playing notes are looked up in the time index of the view and
+	only the notes which started or stopped playing are repainted, unless the view is scrolled.
 */
 void CAMainWin::onRepaintTimerTimeout()
 {
     CAScoreView* sv = static_cast<CAScoreView*>(_playbackView);
-    sv->clearSelection();
-    for (int i = 0; i < _playback->curPlaying().size(); i++) {
-        if (_playback->curPlaying().at(i)->musElementType() == CAMusElement::Note) {
-            CADrawableMusElement* elt = sv->addToSelection(_playback->curPlaying()[i]);
-            if (CACanorus::settings()->lockScrollPlayback()) {
-                if (elt && (elt->xPos() > (sv->worldX() + sv->worldWidth()) || elt->xPos() < sv->worldX())) {
+    const QList<CAPlayable*>& playing = _playback->curPlaying(); // applies the notifications from the playback thread
+    QList<CADrawableMusElement*> drawables;
+    bool scrolled = false;
+    for (int i = 0; i < playing.size(); i++) {
+        if (playing.at(i)->musElementType() == CAMusElement::Note) {
+            QList<CADrawableMusElement*> elts = sv->findMElements(playing[i]);
+            drawables << elts;
+            if (CACanorus::settings()->lockScrollPlayback() && !scrolled && elts.size()) {
+                CADrawableMusElement* elt = elts.last();
+                if (elt->xPos() > (sv->worldX() + sv->worldWidth()) || elt->xPos() < sv->worldX()) {
                     sv->setWorldX(elt->xPos() - 50, CACanorus::settings()->animatedScroll());
+                    scrolled = true;
                 }
             }
         }
     }
 
-    sv->repaint();
+    QRectF changed = sv->replaceSelection(drawables);
+    if (scrolled) {
+        sv->repaint();
+    } else if (!changed.isNull()) {
+        sv->repaintArea(changed);
+    }
 }
 
 void CAMainWin::on_uiLockScrollPlayback_toggled(bool val)
@@ -3211,12 +3274,17 @@ bool CAMainWin::on_uiSaveDocumentAs_triggered()
 	Opens a document with the given absolute file name.
 	The previous document will be lost.
 
-	Returns a pointer to the opened document or null if opening the document has failed.
+	The document is parsed in a background thread while the main window stays responsive
+	and the progress is shown in the status bar. The document is opened in onImportDone().
+
+	Returns a pointer to the opened document, if the import has already finished, or null
+	if the document is still being loaded or opening the document has failed.
 */
 CADocument* CAMainWin::openDocument(const QString& fileName)
 {
     stopPlayback();
 
+    clearImportPreview(); // the previewed sheets are owned by the import
     if (_importFile) {
         _importFile.reset();
     }
@@ -3231,11 +3299,9 @@ CADocument* CAMainWin::openDocument(const QString& fileName)
         return nullptr; // FIXME Failing quietly, add error message
     }
 
-    connect(_importFile.get(), SIGNAL(importDone(int)), this, SLOT(onImportDone(int)));
     _importFile->setStreamFromFile(fileName);
-    _importFile->importDocument();
+    startDocumentImport();
 
-    _mainWinProgressCtl.startProgress(*_importFile.get());
     return _importFile->importedDocument();
 }
 
@@ -3301,6 +3367,7 @@ CADocument* CAMainWin::openDocument(CADocument* doc)
 */
 bool CAMainWin::saveDocument(QString fileName)
 {
+    CACanorus::undo()->finishPendingUndoCommand();
     document()->setTimeEdited(document()->timeEdited() + _timeEditedTime);
     document()->setDateLastModified(QDateTime::currentDateTime());
     CACanorus::restartTimeEditedTimes(document());
@@ -3368,10 +3435,9 @@ void CAMainWin::updateWindowTitle()
     }
 }
 
-void CAMainWin::onMidiInEvent(QVector<unsigned char> m)
+void CAMainWin::onMidiInMessage(const CAMidiMessage& m)
 {
-    _keybdInput->onMidiInEvent(m);
-    return;
+    _keybdInput->onMidiInMessage(m);
 }
 
 /*!
@@ -3416,6 +3482,10 @@ void CAMainWin::on_uiExportDocument_triggered()
             /// \todo replace raw pointer with shared or unique pointer
             CAMidiExport* pme = new CAMidiExport;
             _poExp = pme;
+        } else if (uiExportDialog->selectedNameFilter() == CAFileFormats::WAV_FILTER) {
+            /// \todo replace raw pointer with shared or unique pointer
+            CAWavExport* pwe = new CAWavExport;
+            _poExp = pwe;
         } else if (uiExportDialog->selectedNameFilter() == CAFileFormats::LILYPOND_FILTER) {
             /// \todo replace raw pointer with shared or unique pointer
             CALilyPondExport* ple = new CALilyPondExport;
@@ -3427,10 +3497,12 @@ void CAMainWin::on_uiExportDocument_triggered()
         } else if (uiExportDialog->selectedNameFilter() == CAFileFormats::PDF_FILTER) {
             /// \todo replace raw pointer with shared or unique pointer
             CAPDFExport* ppe = new CAPDFExport;
+            ppe->setTypesetterLocation(CACanorus::settings()->currentTypesetterLocation());
             _poExp = ppe;
         } else if (uiExportDialog->selectedNameFilter() == CAFileFormats::SVG_FILTER) {
             /// \todo replace raw pointer with shared or unique pointer
             CASVGExport* pse = new CASVGExport;
+            pse->setTypesetterLocation(CACanorus::settings()->currentTypesetterLocation());
             _poExp = pse;
         } else {
             //TODO: unknown/unsupported format, raise an error
@@ -3479,6 +3551,7 @@ void CAMainWin::on_uiImportDocument_triggered()
 
         CACanorus::rebuildUI(document());
     } else {
+        clearImportPreview();
         if (_importFile) {
             _importFile.reset();
         }
@@ -3504,25 +3577,82 @@ void CAMainWin::on_uiImportDocument_triggered()
             }
         } else if (uiImportDialog->selectedNameFilter() == CAFileFormats::MUSICXML_FILTER) {
             _importFile = std::make_unique<CAMusicXmlImport>();
-            if (_importFile) {
-                _importFile->setStreamFromFile(s);
-                connect(_importFile.get(), SIGNAL(importDone(int)), this, SLOT(onImportDone(int)));
-                _importFile->importDocument();
-            }
+            _importFile->setStreamFromFile(s);
+            startDocumentImport();
+            return;
         } else if (uiImportDialog->selectedNameFilter() == CAFileFormats::MXL_FILTER) {
             _importFile = std::make_unique<CAMXLImport>();
-            if (_importFile) {
-                _importFile->setStreamFromFile(s);
-                connect(_importFile.get(), SIGNAL(importDone(int)), this, SLOT(onImportDone(int)));
-                _importFile->importDocument();
-            }
+            _importFile->setStreamFromFile(s);
+            startDocumentImport();
+            return;
         }
         if (_importFile) {
+            setMode(ProgressMode);
             _mainWinProgressCtl.startProgress(*_importFile.get());
         }
     }
 }
 
+/*!
+	Starts importing the whole document with \a _importFile in the background. The finished
+	sheets are shown in read-only tabs while the rest of the document is being read and the
+	progress is shown in the status bar. The document is opened in onImportDone().
+*/
+void CAMainWin::startDocumentImport()
+{
+    connect(_importFile.get(), SIGNAL(importDone(int)), this, SLOT(onImportDone(int)));
+    connect(_importFile.get(), SIGNAL(sheetImported(CASheet*)), this, SLOT(onSheetImported(CASheet*)));
+    _importFile->importDocument();
+
+    setMode(ProgressMode);
+    _mainWinProgressCtl.startProgress(*_importFile.get());
+}
+
+/*!
+	Shows the \a sheet, a copy of the sheet which has just been read by the document import,
+	in a read-only tab. The copy is owned by the import, so the previews are removed before
+	the import is deleted.
+*/
+void CAMainWin::onSheetImported(CASheet* sheet)
+{
+    if (!_importFile || sender() != _importFile.get() || !sheet) {
+        return; // notification of a canceled import
+    }
+
+    _importPreviewSheets << sheet;
+    addImportPreview(sheet);
+}
+
+/*!
+	Adds a tab showing the given \a sheet of the document being imported. The view is not
+	registered in viewList() and it doesn't forward any events, so the sheet cannot be edited
+	until the import finishes.
+*/
+void CAMainWin::addImportPreview(CASheet* sheet)
+{
+    CAScoreView* v = new CAScoreView(sheet, nullptr);
+    v->rebuild();
+    _importPreviewViews << v;
+
+    int idx = uiTabWidget->addTab(v, tr("%1 (loading)").arg(sheet->name()));
+    if (!document()) {
+        uiTabWidget->setCurrentIndex(idx);
+    }
+}
+
+/*!
+	Removes the import preview tabs.
+*/
+void CAMainWin::clearImportPreview()
+{
+    for (CAScoreView* v : _importPreviewViews) {
+        uiTabWidget->removeTab(uiTabWidget->indexOf(v));
+        delete v;
+    }
+    _importPreviewViews.clear();
+    _importPreviewSheets.clear();
+}
+
 void CAMainWin::onImportDone(int)
 {
     CAImport* import = static_cast<CAImport*>(sender());
@@ -3531,6 +3661,8 @@ void CAMainWin::onImportDone(int)
         return;
     }
 
+    clearImportPreview();
+
     bool success = (import->status() == 0);
 
     if (success) {
@@ -3572,6 +3704,42 @@ void CAMainWin::onExportDone(int)
 {
 }
 
+/*!
+	Runs the background plugin action \a job and shows its progress in the status bar.
+	The main window takes the ownership of the job. The user keeps editing the document
+	meanwhile, the changes of the job are applied when it finishes.
+
+	\sa onPluginJobDone(), CAPluginJob
+*/
+void CAMainWin::startPluginJob(CAFile* job)
+{
+    _pluginJob.reset(job);
+    connect(job, SIGNAL(finished()), this, SLOT(onPluginJobDone()));
+    job->start();
+
+    _mainWinProgressCtl.startProgress(*job);
+}
+
+/*!
+	Applies the changes of the finished background plugin action to the document.
+	The changes are dropped, if another document was opened or the document was replaced
+	by undo or redo since the job started.
+*/
+void CAMainWin::onPluginJobDone()
+{
+#ifdef USE_PYTHON
+    CAPluginJob* job = static_cast<CAPluginJob*>(_pluginJob.get());
+    if (!job || !document()) {
+        return;
+    }
+    if (job->document() != document()) {
+        qWarning("CAMainWin::onPluginJobDone - the document changed while the plugin was running, its changes are dropped");
+        return;
+    }
+    job->applyChanges(document());
+#endif
+}
+
 /*!
 	Called when a user changes the current voice number.
 */
@@ -4481,7 +4649,12 @@ void CAMainWin::on_uiMidiRecorder_triggered()
             delete _midiRecorderView;
         }
 
-        _midiRecorderView = new CAMidiRecorderView(new CAMidiRecorder(myMidiFile, CACanorus::midiDevice()), this);
+        CAMidiRecorder* recorder = new CAMidiRecorder(myMidiFile, CACanorus::midiDevice());
+        if (currentSheet()) {
+            // record in the tempo at the beginning of the sheet
+            recorder->setTempo(qRound(60000000.0 / currentSheet()->tempoMap()->usecPerQuarter(0)));
+        }
+        _midiRecorderView = new CAMidiRecorderView(recorder, this);
         addDockWidget(Qt::TopDockWidgetArea, _midiRecorderView);
         _midiRecorderView->show();
 
@@ -6197,13 +6370,16 @@ void CAMainWin::onUiOpenRecentDocumentTriggered()
         return;
     }
 
-    bool success = openDocument(CACanorus::recentDocumentList().at(
-        uiOpenRecent->actions().indexOf(static_cast<QAction*>(sender()))));
+    QString fileName = CACanorus::recentDocumentList().at(
+        uiOpenRecent->actions().indexOf(static_cast<QAction*>(sender())));
 
-    if (!success) {
-        CACanorus::removeRecentDocument(CACanorus::recentDocumentList().at(
-            uiOpenRecent->actions().indexOf(static_cast<QAction*>(sender()))));
+    // The document is loaded asynchronously, so only check whether it still exists
+    if (!QFileInfo::exists(fileName)) {
+        CACanorus::removeRecentDocument(fileName);
+        return;
     }
+
+    openDocument(fileName);
 }
 
 /*!
@@ -18,6 +18,7 @@
 
 #include "control/mainwinprogressctl.h"
 
+#include "core/file.h"
 #include "core/notechecker.h"
 
 #include "score/clef.h"
@@ -70,6 +71,7 @@ class CAKeybdInput;
 class CAExport;
 class CAActionStorage;
 class CAImport;
+struct CAMidiMessage;
 
 class CAMainWin : public QMainWindow, private Ui::uiMainWindow {
     Q_OBJECT
@@ -117,6 +119,8 @@ public:
     inline QFileDialog* importDialog() { return uiImportDialog.get(); }
     inline CAResourceView* resourceView() { return _resourceView; }
     inline QAction* resourceViewAction() { return uiResourceView; }
+    void startPluginJob(CAFile* job);
+    inline bool isPluginJobRunning() { return _pluginJob && _pluginJob->isRunning(); }
     inline CAMidiRecorderView* midiRecorderView() { return _midiRecorderView; }
     inline void setMidiRecorderView(CAMidiRecorderView* v) { _midiRecorderView = v; }
     inline CAView* currentView() { return _currentView; }
@@ -250,7 +254,7 @@ private slots:
     void on_uiTupletActualNumber_valueChanged(int);
     void on_uiNoteStemDirection_toggled(bool, int);
     void on_uiHiddenRest_toggled(bool checked);
-    void onMidiInEvent(QVector<unsigned char> message);
+    void onMidiInMessage(const CAMidiMessage& message);
 
     // Time Signature
     void on_uiTimeSigBeats_valueChanged(int);
@@ -354,7 +358,9 @@ private slots:
     // Handle progress bar events //
     ////////////////////////////////
     void onImportDone(int status);
+    void onSheetImported(CASheet* sheet);
     void onExportDone(int status);
+    void onPluginJobDone();
 
 private:
     void playImmediately(QList<CAMusElement*> elements);
@@ -404,6 +410,12 @@ private:
     CAMusElementFactory* _musElementFactory;
     CANoteChecker _noteChecker;
     std::unique_ptr<CAImport> _importFile;
+    void startDocumentImport();
+    void addImportPreview(CASheet* sheet);
+    void clearImportPreview();
+    QList<CASheet*> _importPreviewSheets; // copies of the imported sheets owned by _importFile, shown read-only
+    QList<CAScoreView*> _importPreviewViews;
+    std::unique_ptr<CAFile> _pluginJob; // background plugin action, see CAPluginJob
 
 public:
     inline CAMusElementFactory* musElementFactory() { return _musElementFactory; }
@@ -101,6 +101,7 @@ void CASettingsDialog::setupPages(CASettingsPage currentPage)
     }
     if (CACanorus::settings()->midiInPort() == -1)
         uiMidiInList->setCurrentItem(uiMidiInList->item(0)); // select the previous device
+    uiMidiInStepInput->setChecked(CACanorus::settings()->midiInStepInput());
 
     uiMidiOutList->addItem(tr("None"));
     for (int i = 0; i < _midiOutPorts.values().size(); i++) {
@@ -175,6 +176,7 @@ void CASettingsDialog::applySettings()
         CACanorus::settings()->setMidiInPort(-1);
     else
         CACanorus::settings()->setMidiInPort(_midiInPorts.keys().at(uiMidiInList->currentIndex().row() - 1));
+    CACanorus::settings()->setMidiInStepInput(uiMidiInStepInput->isChecked());
 
     if (uiMidiOutList->currentIndex().row() == 0)
         CACanorus::settings()->setMidiOutPort(-1);
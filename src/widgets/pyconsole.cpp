@@ -537,7 +537,7 @@ bool CAPyConsole::cmdIntern(QString strCmd)
         argsPython << CASwigPython::toPythonObject(static_cast<CAMainWin*>(curObject)->document(), CASwigPython::Document);
         PyEval_ReleaseThread(CASwigPython::mainThreadState);
 
-        CASwigPython::callFunction(QFileInfo("scripts:" + strCmd.mid(12)).absoluteFilePath(), _strEntryFunc, argsPython, true);
+        CASwigPython::releaseObject(CASwigPython::callFunction(QFileInfo("scripts:" + strCmd.mid(12)).absoluteFilePath(), _strEntryFunc, argsPython, true));
         emit sig_txtAppend(">>> ", txtNormal); // if not emitted, error from python and this are not in order
         return true;
     }
@@ -558,8 +558,8 @@ bool CAPyConsole::cmdIntern(QString strCmd)
             curObject = curObject->parent();
         PyEval_RestoreThread(CASwigPython::mainThreadState);
         argsPython << CASwigPython::toPythonObject(static_cast<CAMainWin*>(curObject)->document(), CASwigPython::Document);
-        PyEval_ReleaseThread(CASwigPython::mainThreadState);
         argsPython << PyUnicode_FromString(strCmd.toStdString().c_str());
+        PyEval_ReleaseThread(CASwigPython::mainThreadState);
 
         // Can't autoreload because we are using global objects in pycl2.py that would get overwritten.
         auto ret = CASwigPython::callFunction(QFileInfo("scripts:pycl2.py").absoluteFilePath(), "main", argsPython, false);
@@ -567,7 +567,12 @@ bool CAPyConsole::cmdIntern(QString strCmd)
             return false;
         }
 
-        emit sig_txtAppend(PyUnicode_AsUTF8(ret), txtNormal);
+        PyEval_RestoreThread(CASwigPython::mainThreadState);
+        QString output = QString::fromUtf8(PyUnicode_AsUTF8(ret));
+        Py_DECREF(ret);
+        PyEval_ReleaseThread(CASwigPython::mainThreadState);
+
+        emit sig_txtAppend(output, txtNormal);
         return true;
     }
 
@@ -109,6 +109,8 @@ void CATextEdit::keyPressEvent(QKeyEvent* e)
 	hiding certain staffs, animating the scroll etc.) the controller might use.
 
 	This widget also provides horizontal and vertical scrollbars (see _hScrollBar and _vScrollBar).
+
+	The drawable elements are created by CALayoutEngine which uses the score view as its layout target, see CALayoutTarget.
 */
 
 CAScoreView::CAScoreView(CASheet* sheet, QWidget* parent)
@@ -454,6 +456,7 @@ void CAScoreView::importElements(CAKDTree<CADrawableMusElement*>* origDMusElts,
             addMElement(drawableMusElements[i]->clone(newDrawableContexts[idx]));
         }
     }
+    buildTimeIndex();
 }
 
 /*!
@@ -627,6 +630,7 @@ void CAScoreView::rebuild()
     _drawableCList.clear(true);
     _drawableNCEList.clear(true);
     _mapDrawable.clear();
+    _timeIndex.clear();
 
     CALayoutEngine::reposit(this);
 
@@ -639,6 +643,7 @@ void CAScoreView::rebuild()
     else
         setCurrentContext(nullptr);
 
+    buildTimeIndex();
     addToSelection(musElementSelection);
 
     setWorldCoords(worldCoords()); // needed to update the scrollbars
@@ -1008,12 +1013,13 @@ void CAScoreView::paintEvent(QPaintEvent*)
 
     p.setRenderHint(QPainter::Antialiasing, CACanorus::settings()->antiAliasing());
 
+    QSet<CADrawableMusElement*> selection = QSet<CADrawableMusElement*>::fromList(_selection);
     for (int i = 0; i < mList.size(); i++) {
         QColor color;
         CAMusElement* elt = mList[i]->musElement();
 
         // determine element color (based on selection, current mode, active voice etc.)
-        if (_selection.contains(mList[i])) {
+        if (selection.contains(mList[i])) {
             color = selectionColor();
         } else if ((selectedVoice() && ((elt && ((elt->isPlayable() && static_cast<CAPlayable*>(elt)->voice() == selectedVoice()) || (!elt->isPlayable() && elt->context() == selectedVoice()->staff()) || elt->context() != selectedVoice()->staff())) || (!elt && mList[i]->drawableContext()->context() == selectedVoice()->staff()))) || (!selectedVoice())) {
             if (elt && elt->musElementType() == CAMusElement::Rest && static_cast<CAPlayable*>(elt)->voice() == selectedVoice() && static_cast<CARest*>(elt)->restType() == CARest::Hidden) {
@@ -1629,6 +1635,64 @@ void CAScoreView::addToSelection(const QList<CAMusElement*> elts)
     emit selectionChanged();
 }
 
+/*!
+	Replaces the current selection with the given drawable elements \a elts.
+	Returns the area in world coordinates covering the elements which were added
+	to or removed from the selection. Pass it to repaintArea() to repaint only the
+	changed elements. This is used to highlight the playing notes.
+*/
+QRectF CAScoreView::replaceSelection(const QList<CADrawableMusElement*>& elts)
+{
+    QSet<CADrawableMusElement*> oldSelection = QSet<CADrawableMusElement*>::fromList(_selection);
+    QSet<CADrawableMusElement*> newSelection;
+    QRectF area;
+
+    QList<CADrawableMusElement*> selection;
+    for (int i = 0; i < elts.size(); i++) {
+        if (elts[i]->isSelectable() && !newSelection.contains(elts[i])) {
+            newSelection << elts[i];
+            selection << elts[i];
+            if (!oldSelection.contains(elts[i])) {
+                area |= QRectF(elts[i]->xPos(), elts[i]->yPos(), elts[i]->width(), elts[i]->height());
+            }
+        }
+    }
+
+    for (int i = 0; i < _selection.size(); i++) {
+        if (!newSelection.contains(_selection[i])) {
+            area |= QRectF(_selection[i]->xPos(), _selection[i]->yPos(), _selection[i]->width(), _selection[i]->height());
+        }
+    }
+
+    if (area.isNull() && selection.size() == _selection.size()) {
+        return area; // nothing changed
+    }
+
+    // the selection is sorted by X coordinate
+    std::stable_sort(selection.begin(), selection.end(), [](const CADrawableMusElement* a, const CADrawableMusElement* b) {
+        return a->xPos() < b->xPos();
+    });
+    _selection = selection;
+
+    emit selectionChanged();
+    return area;
+}
+
+/*!
+	Immediately repaints only the given \a area in world coordinates, if it's visible.
+*/
+void CAScoreView::repaintArea(const QRectF& area)
+{
+    QRectF visible = area.adjusted(-2, -2, 2, 2) & QRectF(_worldX, _worldY, _worldW, _worldH);
+    if (visible.isEmpty()) {
+        return;
+    }
+
+    setRepaintArea(new QRect(visible.toAlignedRect()));
+    repaint(QRectF((visible.x() - _worldX) * _zoom, (visible.y() - _worldY) * _zoom, visible.width() * _zoom, visible.height() * _zoom).toAlignedRect());
+    clearRepaintArea();
+}
+
 /*!
 	Select all elements in the view.
 	This function is usually associated with CTRL+A key.
@@ -1700,6 +1764,70 @@ void CAScoreView::invertSelection()
     emit selectionChanged();
 }
 
+/*!
+	Sorts the drawable music elements by their time start and X coordinate into the time index.
+	Called after the layout is rebuilt.
+
+	\sa findMElements(), findMElementsInTime()
+*/
+void CAScoreView::buildTimeIndex()
+{
+    _timeIndex.clear();
+    const QList<CADrawableMusElement*>& elts = _drawableMList.list();
+    _timeIndex.reserve(elts.size());
+    for (int i = 0; i < elts.size(); i++) {
+        if (elts[i]->musElement()) {
+            _timeIndex << elts[i];
+        }
+    }
+
+    std::stable_sort(_timeIndex.begin(), _timeIndex.end(), [](const CADrawableMusElement* a, const CADrawableMusElement* b) {
+        return a->musElement()->timeStart() < b->musElement()->timeStart()
+            || (a->musElement()->timeStart() == b->musElement()->timeStart() && a->xPos() < b->xPos());
+    });
+}
+
+/*!
+	Returns all drawable instances of the given abstract music element \a elt sorted by X coordinate.
+	The drawable elements are looked up in the time index in logarithmic time.
+
+	\sa findMElement(), findMElementsInTime()
+*/
+QList<CADrawableMusElement*> CAScoreView::findMElements(CAMusElement* elt)
+{
+    QList<CADrawableMusElement*> list;
+    if (!elt) {
+        return list;
+    }
+
+    QList<CADrawableMusElement*> candidates = findMElementsInTime(elt->timeStart(), elt->timeStart());
+    for (int i = 0; i < candidates.size(); i++) {
+        if (candidates[i]->musElement() == elt) {
+            list << candidates[i];
+        }
+    }
+
+    return list;
+}
+
+/*!
+	Returns the drawable music elements starting between \a timeStart and \a timeEnd inclusive
+	sorted by their time start and X coordinate. Uses binary search in the time index.
+*/
+QList<CADrawableMusElement*> CAScoreView::findMElementsInTime(int timeStart, int timeEnd)
+{
+    QVector<CADrawableMusElement*>::const_iterator it = std::lower_bound(_timeIndex.constBegin(), _timeIndex.constEnd(), timeStart, [](const CADrawableMusElement* a, int time) {
+        return a->musElement()->timeStart() < time;
+    });
+
+    QList<CADrawableMusElement*> list;
+    for (; it != _timeIndex.constEnd() && (*it)->musElement()->timeStart() <= timeEnd; it++) {
+        list << *it;
+    }
+
+    return list;
+}
+
 /*!
 	Finds the first drawable instance of the given abstract music element.
 
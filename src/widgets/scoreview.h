@@ -17,6 +17,7 @@
 #include <QTimer>
 
 #include "layout/kdtree.h"
+#include "layout/layouttarget.h"
 #include "score/note.h"
 #include "widgets/view.h"
 
@@ -52,7 +53,7 @@ public slots:
     void keyPressEvent(QKeyEvent*);
 };
 
-class CAScoreView : public CAView {
+class CAScoreView : public CAView, public CALayoutTarget {
     Q_OBJECT
 
 public:
@@ -117,6 +118,8 @@ public:
     void addToSelection(const QList<CADrawableMusElement*> list, bool selectableOnly = true);
     CADrawableMusElement* addToSelection(CAMusElement* elt);
     void addToSelection(const QList<CAMusElement*> elts);
+    QRectF replaceSelection(const QList<CADrawableMusElement*>& elts);
+    void repaintArea(const QRectF& area);
 
     CADrawableMusElement* selectNextMusElement(bool append = false);
     CADrawableMusElement* selectPrevMusElement(bool append = false);
@@ -134,6 +137,8 @@ public:
     // Music elements and contexts query, space calculation and access //
     /////////////////////////////////////////////////////////////////////
     CADrawableMusElement* findMElement(CAMusElement*);
+    QList<CADrawableMusElement*> findMElements(CAMusElement* elt);
+    QList<CADrawableMusElement*> findMElementsInTime(int timeStart, int timeEnd);
     CADrawableContext* findCElement(CAContext*);
     QList<CADrawableContext*> findContextsInRegion(QRect& reg);
     CADrawableMusElement* nearestLeftElement(double x, double y, CADrawableContext* context = nullptr);
@@ -294,6 +299,7 @@ protected:
 
 private:
     void initScoreView(CASheet* s);
+    void buildTimeIndex();
     inline void clearMElements() { _drawableMList.clear(true); }
     inline void clearCElements() { _drawableCList.clear(true); }
     inline bool isSelected(CADrawableMusElement* elt) { return (_selection.contains(elt)); }
@@ -312,6 +318,7 @@ private:
     CAKDTree<CADrawableContext*> _drawableCList; // The list of context drawable elements (staffs, lyrics etc.). Every view has its own list of drawable elements and drawable objects themselves!
     CAKDTree<CADrawableNoteCheckerError*> _drawableNCEList; // The list of drawable note checker errors
     QMultiMap<void*, CADrawable*> _mapDrawable; // Mapping of all music elements/contexts in the score -> drawable elements on canvas
+    QVector<CADrawableMusElement*> _timeIndex; // Drawable music elements sorted by the time start and X coordinate, see buildTimeIndex()
     CASheet* _sheet; // Pointer to the CASheet which the view represents.
 
     QList<CADrawableMusElement*> _selection; // The set of elements being selected.